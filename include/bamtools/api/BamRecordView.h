@@ -0,0 +1,163 @@
+// ***************************************************************************
+// BamRecordView.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides read-only, zero-copy access to a BAM record's fields
+// ***************************************************************************
+
+#ifndef BAMRECORDVIEW_H
+#define BAMRECORDVIEW_H
+
+#include "api_global.h"
+#include "BamAux.h"
+#include <string>
+
+namespace BamTools {
+
+//! \cond
+// forward declaration of BamRecordView's "friends"
+namespace Internal {
+    class BamReaderPrivate;
+} // namespace Internal
+//! \endcond
+
+class API_EXPORT BamRecordView {
+
+    // ctor & dtor
+    public:
+        BamRecordView(void);
+        ~BamRecordView(void);
+
+    // core fields
+    public:
+        int32_t  RefID(void) const;              // ID number for reference sequence
+        int32_t  Position(void) const;           // position (0-based) where alignment starts
+        uint16_t Bin(void) const;                // BAM (standard) index bin number for this alignment
+        uint16_t MapQuality(void) const;         // mapping quality score
+        uint32_t AlignmentFlag(void) const;      // alignment bit-flag
+        int32_t  Length(void) const;             // length of query sequence
+        int32_t  MateRefID(void) const;          // ID number for reference sequence where alignment's mate was aligned
+        int32_t  MatePosition(void) const;       // position (0-based) where alignment's mate starts
+        int32_t  InsertSize(void) const;         // mate-pair insert size
+        uint32_t NumCigarOperations(void) const; // number of CIGAR operations
+
+    // variable-length data
+    // N.B. - pointers are only valid until the next read from the BamReader
+    public:
+        // read name (null-terminated)
+        const char* Name(void) const;
+        // read name length (not counting the terminating null)
+        uint32_t NameLength(void) const;
+
+        // packed CIGAR operations (NumCigarOperations() little-endian uint32_t values)
+        const char* PackedCigar(void) const;
+        // decodes CIGAR operation at index
+        CigarOp GetCigarOp(const uint32_t index) const;
+
+        // packed query sequence (4-bit encoded bases, two per byte)
+        const char* PackedSequence(void) const;
+        // decodes query base at index (e.g. 'A', 'C', 'G', 'T', 'N')
+        char GetBase(const int32_t index) const;
+
+        // raw (not ASCII-shifted) base qualities, Length() bytes
+        // (0xFF-filled if the record stores no qualities)
+        const char* Qualities(void) const;
+
+        // raw tag data (multi-byte values are little-endian)
+        const char* TagData(void) const;
+        // tag data length (bytes)
+        uint32_t TagDataLength(void) const;
+
+    // derived data
+    public:
+        // calculates alignment end position, based on starting position & CIGAR data
+        int GetEndPosition(bool usePadded = false, bool closedInterval = false) const;
+
+    // internal methods
+    private:
+        // points view at record data (block length bytes, starting at core data)
+        // returns false if record's variable-length sections exceed its block length
+        bool Load(const char* record, const uint32_t blockLength);
+
+    // not copyable (view may point into its own spill buffer)
+    private:
+        BamRecordView(const BamRecordView& other);
+        BamRecordView& operator=(const BamRecordView& other);
+
+    // data members
+    private:
+        // core fields
+        int32_t  m_refID;
+        int32_t  m_position;
+        uint16_t m_bin;
+        uint16_t m_mapQuality;
+        uint32_t m_alignmentFlag;
+        int32_t  m_length;
+        int32_t  m_mateRefID;
+        int32_t  m_matePosition;
+        int32_t  m_insertSize;
+        uint32_t m_numCigarOperations;
+
+        // variable-length data
+        const char* m_charData;
+        uint32_t    m_charDataLength;
+        uint32_t    m_queryNameLength;  // includes terminating null
+        uint32_t    m_tagDataOffset;
+
+        // holds record if it straddled BGZF blocks
+        std::string m_spillBuffer;
+
+        // system data
+        bool m_isBigEndian;
+
+    friend class Internal::BamReaderPrivate;
+};
+
+// ----------------------------------------------------------------
+// BamRecordView core field accessors
+
+inline int32_t BamRecordView::RefID(void) const {
+    return m_refID;
+}
+
+inline int32_t BamRecordView::Position(void) const {
+    return m_position;
+}
+
+inline uint16_t BamRecordView::Bin(void) const {
+    return m_bin;
+}
+
+inline uint16_t BamRecordView::MapQuality(void) const {
+    return m_mapQuality;
+}
+
+inline uint32_t BamRecordView::AlignmentFlag(void) const {
+    return m_alignmentFlag;
+}
+
+inline int32_t BamRecordView::Length(void) const {
+    return m_length;
+}
+
+inline int32_t BamRecordView::MateRefID(void) const {
+    return m_mateRefID;
+}
+
+inline int32_t BamRecordView::MatePosition(void) const {
+    return m_matePosition;
+}
+
+inline int32_t BamRecordView::InsertSize(void) const {
+    return m_insertSize;
+}
+
+inline uint32_t BamRecordView::NumCigarOperations(void) const {
+    return m_numCigarOperations;
+}
+
+} // namespace BamTools
+
+#endif // BAMRECORDVIEW_H
@@ -0,0 +1,15 @@
+// Copyright 2007-2010 Baptiste Lepilleur
+// Distributed under MIT license, or public domain if desired and
+// recognized in your jurisdiction.
+// See file LICENSE for detail or copy at http://jsoncpp.sourceforge.net/LICENSE
+
+#ifndef JSON_JSON_H_INCLUDED
+# define JSON_JSON_H_INCLUDED
+
+//# include "autolink.h"
+# include "json_value.h"
+# include "json_reader.h"
+# include "json_writer.h"
+# include "json_features.h"
+
+#endif // JSON_JSON_H_INCLUDED
@@ -0,0 +1,152 @@
+// ***************************************************************************
+// premo.h (c) 2012 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Main Premo workhorse
+// ***************************************************************************
+
+#ifndef PREMO_H
+#define PREMO_H
+
+#include "fastqreader.h"
+#include "premo_result.h"
+#include "premo_settings.h"
+#include "result.h"
+#include "ubamreader.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class PairedEndBatch;
+
+namespace BamTools {
+    class BamReader;
+} // namespace BamTools
+
+namespace Json {
+    class Value;
+} // namespace Json
+
+// progress info, reported after each completed batch
+struct PremoProgress {
+
+    // data members
+    int BatchNumber;
+    BatchSummary Batch;     // this batch only
+    BatchSummary Overall;   // all batches so far
+    bool IsFinished;        // true if no more batches will be run
+
+    // ctors & dtor
+    PremoProgress(void)
+        : BatchNumber(0)
+        , IsFinished(false)
+    { }
+    PremoProgress(const PremoProgress& other)
+        : BatchNumber(other.BatchNumber)
+        , Batch(other.Batch)
+        , Overall(other.Overall)
+        , IsFinished(other.IsFinished)
+    { }
+    ~PremoProgress(void) { }
+};
+
+// subclass & attach to a Premo run to receive progress updates
+// N.B. - called from the thread running the batches
+class PremoObserver {
+    public:
+        virtual ~PremoObserver(void) { }
+        virtual void batchFinished(const PremoProgress& progress) =0;
+};
+
+// JSON form of a batch/overall summary, as found in the output file
+Json::Value summaryToJson(const BatchSummary& summary, const bool isSingleEndMode);
+
+class Premo {
+
+    // ctor & dtor
+    public:
+        Premo(const PremoSettings& settings);
+        ~Premo(void);
+
+    // Premo interface
+    public:
+        std::string errorString(void) const;
+        bool run(void);    // equivalent to: start(), runBatch() until isFinished(), finish()
+
+    // library interface
+    public:
+        bool estimate(PremoResult* result);      // like run(), but returns result instead of writing output (-out not needed)
+        PremoResult result(void) const;         // summary of the batches run so far
+        void toJson(Json::Value* root) const;    // same content as the output file
+        void setObserver(PremoObserver* observer); // not owned, may be 0
+
+        // cancellation may be requested from any thread, takes effect before the next batch
+        void cancel(void);
+        bool isCancelled(void) const;
+
+    // step-wise interface (for interleaving batches of many Premo runs)
+    public:
+        bool start(void);  // validates settings & opens input
+        bool runBatch(void);
+        bool isFinished(void) const;
+        bool finish(void); // writes output
+
+    // internal methods
+    private:
+        bool isProjectingResources(void) const;
+        bool loadPrior(void);
+        bool openInputFiles(void);
+        ResourceProjection projectResources(void) const;
+        void notifyObserver(const Result& batchResult) const;
+        void runCalibrationBatch(const PairedEndBatch* batch, const uint64_t numBatchPairs);
+        bool scanReadLengths(void);
+        bool tuneParameters(void);
+        bool validateSettings(void);
+        bool writeOutput(void);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        bool m_isFinished;
+        bool m_isOutputRequired;
+        int m_batchNumber;
+
+        PremoObserver* m_observer;
+        bool m_isCancelled;
+        mutable pthread_mutex_t m_cancelMutex;
+
+        FastqReader m_reader1;
+        FastqReader m_reader2;
+        UnalignedBamReader m_bamReader;
+        std::vector<BamTools::BamReader*> m_alignedBamReaders;
+
+        std::vector<Result> m_batchResults;
+        Result m_currentResult;
+
+        // earlier run's overall result (-prior), used as convergence baseline
+        BatchSummary m_prior;
+        int m_numPriorBatches;
+        bool m_isPriorConfirmed;
+
+        // exact read length counts (-exact), indexed by read length
+        std::vector<uint64_t> m_readLengthCounts;
+
+        // final batch's FASTQ pair & results of aligning it with candidate parameters (-tune)
+        std::string m_tuningFastq1;
+        std::string m_tuningFastq2;
+        std::vector<TuningCandidate> m_tuningCandidates;
+
+        // telemetry
+        double m_startTime;
+        std::vector<BatchTimings> m_batchTimings;
+        BatchTimings m_calibrationTimings;   // smaller re-run of first batch's reads, for projectResources()
+
+        bool m_createdScratchDirectory;
+
+        std::string m_errorString;
+};
+
+#endif // PREMO_H
@@ -0,0 +1,223 @@
+// ***************************************************************************
+// premo_result.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Summary structs returned by the Premo library interface
+// ***************************************************************************
+
+#ifndef PREMO_RESULT_H
+#define PREMO_RESULT_H
+
+#include "telemetry.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// count & quartiles of a set of lengths (quartiles are 0.0 if Count is 0)
+struct LengthSummary {
+
+    // data members
+    uint64_t Count;
+    double Median;
+    double Q1;
+    double Q3;
+
+    // ctors & dtor
+    LengthSummary(void)
+        : Count(0)
+        , Median(0.0)
+        , Q1(0.0)
+        , Q3(0.0)
+    { }
+    LengthSummary(const LengthSummary& other)
+        : Count(other.Count)
+        , Median(other.Median)
+        , Q1(other.Q1)
+        , Q3(other.Q3)
+    { }
+    ~LengthSummary(void) { }
+};
+
+// fragment length (& unpaired mates) are not calculated in single-end mode
+struct BatchSummary {
+
+    // data members
+    LengthSummary FragmentLength;
+    LengthSummary ReadLength;
+    uint64_t NumUnpairedMates;   // mates without a partner in the aligner output
+
+    // ctors & dtor
+    BatchSummary(void)
+        : NumUnpairedMates(0)
+    { }
+    BatchSummary(const BatchSummary& other)
+        : FragmentLength(other.FragmentLength)
+        , ReadLength(other.ReadLength)
+        , NumUnpairedMates(other.NumUnpairedMates)
+    { }
+    ~BatchSummary(void) { }
+};
+
+// generated Mosaik parameter set
+// N.B. - LocalSearchRadius & MedianFragmentLength are only set in paired-end mode
+struct MosaikParameters {
+
+    // MosaikAligner
+    double       Act;                 // -act
+    unsigned int Bandwidth;           // -bw
+    unsigned int HashSize;            // -hs
+    double       LocalSearchRadius;   // -ls
+    unsigned int Mhp;                 // -mhp
+    double       Mmp;                 // -mmp
+
+    // MosaikBuild
+    int          MedianFragmentLength; // -mfl
+    std::string  SeqTech;              // -st
+
+    // ctors & dtor
+    MosaikParameters(void)
+        : Act(0.0)
+        , Bandwidth(0)
+        , HashSize(0)
+        , LocalSearchRadius(0.0)
+        , Mhp(0)
+        , Mmp(0.0)
+        , MedianFragmentLength(0)
+    { }
+    MosaikParameters(const MosaikParameters& other)
+        : Act(other.Act)
+        , Bandwidth(other.Bandwidth)
+        , HashSize(other.HashSize)
+        , LocalSearchRadius(other.LocalSearchRadius)
+        , Mhp(other.Mhp)
+        , Mmp(other.Mmp)
+        , MedianFragmentLength(other.MedianFragmentLength)
+        , SeqTech(other.SeqTech)
+    { }
+    ~MosaikParameters(void) { }
+};
+
+// one parameter set tried by the -tune phase, on the final batch's reads
+struct TuningCandidate {
+
+    // data members
+    MosaikParameters Parameters;
+    double   AlignerSeconds;
+    double   StartupSeconds;   // fixed cost per MosaikAligner run, fit from a second run on a fraction of the reads
+    uint64_t NumPairs;
+    uint64_t NumPairsMapped;   // both mates mapped
+    bool     IsParetoOptimal;  // no other candidate is both faster & maps more pairs
+
+    // ctors & dtor
+    TuningCandidate(void)
+        : AlignerSeconds(0.0)
+        , StartupSeconds(0.0)
+        , NumPairs(0)
+        , NumPairsMapped(0)
+        , IsParetoOptimal(false)
+    { }
+    TuningCandidate(const TuningCandidate& other)
+        : Parameters(other.Parameters)
+        , AlignerSeconds(other.AlignerSeconds)
+        , StartupSeconds(other.StartupSeconds)
+        , NumPairs(other.NumPairs)
+        , NumPairsMapped(other.NumPairsMapped)
+        , IsParetoOptimal(other.IsParetoOptimal)
+    { }
+    ~TuningCandidate(void) { }
+
+    // throughput (excluding start-up) & sensitivity
+    double pairsPerSecond(void) const {
+        const double alignSeconds = AlignerSeconds - StartupSeconds;
+        return ( alignSeconds > 0.0 ? NumPairs / alignSeconds : 0.0 );
+    }
+    double fractionMapped(void) const {
+        return ( NumPairs != 0 ? static_cast<double>(NumPairsMapped) / NumPairs : 0.0 );
+    }
+};
+
+// projected cost of aligning the full input with the generated parameters, extrapolated from
+// the Mosaik batch runs (only available for paired-end FASTQ input, aligned locally)
+// N.B. - peak memory is the largest observed Mosaik process, as it depends on the reference rather than the input size
+struct ResourceProjection {
+
+    // data members
+    bool   IsAvailable;
+    double InputBytes;              // FASTQ text, both mates
+    bool   IsInputBytesEstimated;   // gzipped input: file size x compression ratio observed so far
+    double NumReads;
+    double WallSeconds;
+    double CpuHours;
+    long   PeakRssKb;
+    bool   IsLinearFit;             // if false, costs are proportional to the batch rate, (over-)counting
+                                    // Mosaik start-up once per batch's worth of input
+                                    // N.B. - part of the first batch is re-aligned as a calibration run,
+                                    //        so a fit is available unless that run failed
+
+    // ctors & dtor
+    ResourceProjection(void)
+        : IsAvailable(false)
+        , InputBytes(0.0)
+        , IsInputBytesEstimated(false)
+        , NumReads(0.0)
+        , WallSeconds(0.0)
+        , CpuHours(0.0)
+        , PeakRssKb(0)
+        , IsLinearFit(false)
+    { }
+    ResourceProjection(const ResourceProjection& other)
+        : IsAvailable(other.IsAvailable)
+        , InputBytes(other.InputBytes)
+        , IsInputBytesEstimated(other.IsInputBytesEstimated)
+        , NumReads(other.NumReads)
+        , WallSeconds(other.WallSeconds)
+        , CpuHours(other.CpuHours)
+        , PeakRssKb(other.PeakRssKb)
+        , IsLinearFit(other.IsLinearFit)
+    { }
+    ~ResourceProjection(void) { }
+};
+
+struct PremoResult {
+
+    // data members
+    bool IsSingleEndMode;
+    BatchSummary Overall;
+    std::vector<BatchSummary> Batches;
+    MosaikParameters Parameters;
+    std::vector<TuningCandidate> Tuning;  // empty unless -tune requested
+
+    // -prior
+    bool HasPrior;
+    bool IsPriorConfirmed;                // new batches matched prior's medians, before converging on their own
+
+    // telemetry
+    double TotalSeconds;
+    std::vector<BatchTimings> Timings;   // one per batch (or the whole -exact scan)
+    ResourceProjection Projection;
+
+    // ctors & dtor
+    PremoResult(void)
+        : IsSingleEndMode(false)
+        , HasPrior(false)
+        , IsPriorConfirmed(false)
+        , TotalSeconds(0.0)
+    { }
+    PremoResult(const PremoResult& other)
+        : IsSingleEndMode(other.IsSingleEndMode)
+        , Overall(other.Overall)
+        , Batches(other.Batches)
+        , Parameters(other.Parameters)
+        , Tuning(other.Tuning)
+        , HasPrior(other.HasPrior)
+        , IsPriorConfirmed(other.IsPriorConfirmed)
+        , TotalSeconds(other.TotalSeconds)
+        , Timings(other.Timings)
+        , Projection(other.Projection)
+    { }
+    ~PremoResult(void) { }
+};
+
+#endif // PREMO_RESULT_H
@@ -0,0 +1,34 @@
+// ***************************************************************************
+// result.h (c) 2012 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Aggregation struct for results
+// ***************************************************************************
+
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <vector>
+
+struct Result {
+
+    // data members
+    std::vector<int> FragmentLengths;
+    std::vector<int> ReadLengths;
+    unsigned int NumUnpairedMates;   // paired-end mates whose partner was not found in aligner output
+
+    // ctors & dtor
+    Result(void)
+        : NumUnpairedMates(0)
+    { }
+    Result(const Result& other)
+        : FragmentLengths(other.FragmentLengths)
+        , ReadLengths(other.ReadLengths)
+        , NumUnpairedMates(other.NumUnpairedMates)
+    { }
+    ~Result(void) { }
+};
+
+#endif // RESULT_H
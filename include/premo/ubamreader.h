@@ -0,0 +1,56 @@
+// ***************************************************************************
+// ubamreader.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Unaligned BAM (uBAM) reader, provides FASTQ entries & read lengths
+// ***************************************************************************
+
+#ifndef UBAMREADER_H
+#define UBAMREADER_H
+
+#include <string>
+class Fastq;
+
+namespace BamTools {
+    class BamAlignment;
+    class BamReader;
+} // namespace BamTools
+
+class UnalignedBamReader {
+
+    // ctor & dtor
+    public:
+        UnalignedBamReader(void);
+        ~UnalignedBamReader(void);
+
+    // UnalignedBamReader interface
+    public:
+        void close(void);
+        std::string errorString(void) const;
+        std::string filename(void) const;
+        bool isEOF(void) const;                         // N.B. - returns false if unopened
+        bool isOpen(void) const;
+        bool open(const std::string& filename);
+        bool readNextLength(int* length);               // core fields only, no FASTQ entry built
+        bool readNextPair(Fastq* mate1, Fastq* mate2);  // expects mates to be adjacent in file
+
+        // BGZF blocks are decompressed on up to numThreads threads (set before open())
+        void setNumThreads(const unsigned int numThreads);
+
+    // internal methods
+    private:
+        bool readNextPrimary(BamTools::BamAlignment* alignment, const bool isCoreOnly);
+
+    // data members
+    private:
+        BamTools::BamReader* m_reader;
+        bool m_isEOF;
+        unsigned int m_numThreads;
+
+        std::string m_filename;
+        std::string m_errorString;
+};
+
+#endif // UBAMREADER_H
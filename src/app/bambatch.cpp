@@ -0,0 +1,310 @@
+// ***************************************************************************
+// bambatch.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Aligned BAM batch - samples indexed regions instead of running Mosaik
+// ***************************************************************************
+
+#include "bambatch.h"
+
+#include "premo_settings.h"
+#include "stats.h"
+
+#include "bamtools/api/BamReader.h"
+
+#include <pthread.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// sampling constants
+// ------------------------
+
+// length (bp) of each sampled region
+static const int REGION_LENGTH = 100000;
+
+// cap on samples taken from any single region, so that each batch is spread
+// across many regions (& therefore references)
+static const unsigned int MAX_SAMPLES_PER_REGION = 100;
+
+// give up on a sampling task after this many consecutive regions with no data
+static const unsigned int MAX_EMPTY_REGIONS = 1000;
+
+// secondary & supplementary records would count a read more than once
+static const uint32_t NON_PRIMARY_FLAGS = 0x100 | 0x800;
+
+// -------------------------
+// utility methods
+// -------------------------
+
+// splitmix64 - small, fast & good enough for picking regions
+static inline
+uint64_t nextRandom(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// identifies a mate pair from either mate's core fields
+struct PairKey {
+
+    // data members
+    int32_t LeftPosition;
+    int32_t RightPosition;
+    int32_t InsertSize;
+
+    // ctor
+    PairKey(const int32_t left, const int32_t right, const int32_t insertSize)
+        : LeftPosition(left)
+        , RightPosition(right)
+        , InsertSize(abs(insertSize))
+    { }
+
+    bool operator<(const PairKey& other) const {
+        if ( LeftPosition  != other.LeftPosition  ) return LeftPosition  < other.LeftPosition;
+        if ( RightPosition != other.RightPosition ) return RightPosition < other.RightPosition;
+        return InsertSize < other.InsertSize;
+    }
+};
+
+// -------------------------
+// per-thread sampling task
+// -------------------------
+
+struct SampleTask {
+
+    // input
+    BamTools::BamReader* Reader;
+    uint64_t RandomState;
+    unsigned int TargetCount;   // # of fragment lengths (PE) or read lengths (SE)
+    bool IsSingleEndMode;
+
+    // output
+    Result TaskResult;
+    bool IsOk;
+    std::string ErrorString;
+
+    // ctor
+    SampleTask(BamTools::BamReader* reader = 0,
+               const uint64_t seed = 0,
+               const unsigned int targetCount = 0,
+               const bool isSingleEndMode = false)
+        : Reader(reader)
+        , RandomState(seed)
+        , TargetCount(targetCount)
+        , IsSingleEndMode(isSingleEndMode)
+        , IsOk(true)
+    { }
+};
+
+// samples a single region, returns number of samples taken
+static
+unsigned int sampleRegion(SampleTask* task, const int refId, const int start, const int end) {
+
+    if ( !task->Reader->SetRegion(refId, start, refId, end) ) {
+        task->ErrorString = task->Reader->GetErrorString();
+        task->IsOk = false;
+        return 0;
+    }
+
+    Result& result = task->TaskResult;
+    unsigned int numSamples = 0;
+    map<PairKey, int32_t> pendingMates;
+
+    BamTools::BamAlignment alignment;
+    while ( numSamples < MAX_SAMPLES_PER_REGION &&
+            task->Reader->GetNextAlignmentCore(alignment) )
+    {
+        if ( (alignment.AlignmentFlag & NON_PRIMARY_FLAGS) != 0 )
+            continue;
+
+        // store read length, regardless of aligned state
+        result.ReadLengths.push_back(alignment.Length);
+
+        if ( task->IsSingleEndMode ) {
+            ++numSamples;
+            continue;
+        }
+
+        // only pairs with both mates mapped to same reference provide a fragment length
+        if ( !alignment.IsPaired()     ||
+             !alignment.IsMapped()     ||
+             !alignment.IsMateMapped() ||
+             alignment.RefID != alignment.MateRefID )
+        {
+            continue;
+        }
+
+        // store leftmost mate's length until its partner shows up
+        const bool isLeftMate = ( alignment.Position < alignment.MatePosition ) ||
+                                ( alignment.Position == alignment.MatePosition && alignment.IsFirstMate() );
+        if ( isLeftMate ) {
+            pendingMates[ PairKey(alignment.Position, alignment.MatePosition, alignment.InsertSize) ] = alignment.Length;
+            continue;
+        }
+
+        // otherwise, look up partner & calculate fragment length (same as PairedEndBatch)
+        map<PairKey, int32_t>::iterator mateIter =
+            pendingMates.find( PairKey(alignment.MatePosition, alignment.Position, alignment.InsertSize) );
+        if ( mateIter != pendingMates.end() ) {
+            result.FragmentLengths.push_back( mateIter->second + abs(alignment.InsertSize) + alignment.Length );
+            pendingMates.erase(mateIter);
+            ++numSamples;
+        }
+    }
+
+    return numSamples;
+}
+
+static
+void* runSampleTask(void* data) {
+
+    SampleTask* task = static_cast<SampleTask*>(data);
+    assert(task);
+
+    // set up cumulative reference lengths, for picking uniformly across the genome
+    const BamTools::RefVector& references = task->Reader->GetReferenceData();
+    vector<int64_t> cumulativeLengths;
+    cumulativeLengths.reserve(references.size());
+    int64_t totalLength = 0;
+    for ( size_t i = 0; i < references.size(); ++i ) {
+        totalLength += references.at(i).RefLength;
+        cumulativeLengths.push_back(totalLength);
+    }
+    if ( totalLength <= 0 ) {
+        task->ErrorString = "BAM file has no reference sequences to sample";
+        task->IsOk = false;
+        return 0;
+    }
+
+    // sample regions until we have enough data (or give up on an empty-looking file)
+    unsigned int numSamples = 0;
+    unsigned int numEmptyRegions = 0;
+    while ( numSamples < task->TargetCount && numEmptyRegions < MAX_EMPTY_REGIONS ) {
+
+        // pick random region
+        const int64_t genomePosition = nextRandom(&task->RandomState) % totalLength;
+        const int refId = upper_bound(cumulativeLengths.begin(), cumulativeLengths.end(), genomePosition)
+                        - cumulativeLengths.begin();
+        const int64_t refStart = cumulativeLengths.at(refId) - references.at(refId).RefLength;
+        const int start = static_cast<int>(genomePosition - refStart);
+        const int end   = min(start + REGION_LENGTH, references.at(refId).RefLength);
+
+        // sample it
+        const unsigned int regionSamples = sampleRegion(task, refId, start, end);
+        if ( !task->IsOk )
+            return 0;
+
+        if ( regionSamples == 0 )
+            ++numEmptyRegions;
+        else
+            numEmptyRegions = 0;
+        numSamples += regionSamples;
+    }
+
+    return 0;
+}
+
+// --------------------------------
+// AlignedBamBatch implementation
+// --------------------------------
+
+AlignedBamBatch::AlignedBamBatch(const int batchNumber,
+                                 const vector<BamTools::BamReader*>& readers,
+                                 PremoSettings* settings)
+    : Batch(settings)
+    , m_batchNumber(batchNumber)
+    , m_readers(readers)
+{ }
+
+AlignedBamBatch::~AlignedBamBatch(void) { }
+
+Batch::RunStatus AlignedBamBatch::run(void) {
+
+    assert( !m_readers.empty() );
+
+    // ---------------------------------------
+    // set up one sampling task per reader
+    // ---------------------------------------
+
+    const size_t numTasks = m_readers.size();
+    const unsigned int targetCount = (m_settings->BatchSize + numTasks - 1) / numTasks;
+
+    vector<SampleTask> tasks;
+    tasks.reserve(numTasks);
+    for ( size_t i = 0; i < numTasks; ++i ) {
+        const uint64_t seed = (static_cast<uint64_t>(m_batchNumber) << 32) | i;
+        tasks.push_back( SampleTask(m_readers.at(i), seed, targetCount, m_settings->IsSingleEndMode) );
+    }
+
+    // ---------------------------------------
+    // run tasks (one thread per task)
+    // ---------------------------------------
+
+    StageTimer timer(&m_timings, "BAM sampling");
+
+    vector<pthread_t> threads(numTasks);
+    vector<bool> isThreadStarted(numTasks, false);
+    for ( size_t i = 1; i < numTasks; ++i )
+        isThreadStarted[i] = ( pthread_create(&threads[i], 0, runSampleTask, &tasks[i]) == 0 );
+
+    // calling thread handles the first task, plus any that failed to start
+    runSampleTask(&tasks[0]);
+    for ( size_t i = 1; i < numTasks; ++i ) {
+        if ( isThreadStarted[i] )
+            pthread_join(threads[i], 0);
+        else
+            runSampleTask(&tasks[i]);
+    }
+
+    // ---------------------------------------
+    // merge task results
+    // ---------------------------------------
+
+    for ( size_t i = 0; i < numTasks; ++i ) {
+
+        const SampleTask& task = tasks.at(i);
+        if ( !task.IsOk ) {
+            m_errorString = "could not sample input BAM file: ";
+            m_errorString.append(task.Reader->GetFilename());
+            m_errorString.append("\n\tbecause: ");
+            m_errorString.append(task.ErrorString);
+            return Batch::Error;
+        }
+
+        const Result& taskResult = task.TaskResult;
+        m_result.ReadLengths.insert(m_result.ReadLengths.end(),
+                                    taskResult.ReadLengths.begin(),
+                                    taskResult.ReadLengths.end());
+        m_result.FragmentLengths.insert(m_result.FragmentLengths.end(),
+                                        taskResult.FragmentLengths.begin(),
+                                        taskResult.FragmentLengths.end());
+    }
+
+    timer.stop();
+    m_timings.NumReads = m_result.ReadLengths.size();
+
+    // make sure we found something
+    const bool isEmpty = ( m_settings->IsSingleEndMode ? m_result.ReadLengths.empty()
+                                                       : m_result.FragmentLengths.empty() );
+    if ( isEmpty ) {
+        m_errorString = "no usable alignments found in sampled regions of input BAM file: ";
+        m_errorString.append(m_readers.at(0)->GetFilename());
+        return Batch::Error;
+    }
+
+    // remove extreme outliers
+    removeOutliers(m_result.FragmentLengths);
+    removeOutliers(m_result.ReadLengths);
+
+    // if we get here, all should be OK
+    return Batch::Normal;
+}
@@ -0,0 +1,43 @@
+// ***************************************************************************
+// bambatch.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Aligned BAM batch - samples indexed regions instead of running Mosaik
+// ***************************************************************************
+
+#ifndef BAMBATCH_H
+#define BAMBATCH_H
+
+#include "batch.h"
+#include <vector>
+
+namespace BamTools {
+    class BamReader;
+} // namespace BamTools
+
+class AlignedBamBatch : public Batch {
+
+    // ctor & dtor
+    public:
+        // each reader must already be opened, with its index loaded
+        // one thread is used per reader
+        AlignedBamBatch(const int batchNumber,
+                        const std::vector<BamTools::BamReader*>& readers,
+                        PremoSettings* settings);
+        ~AlignedBamBatch(void);
+
+    // Batch interface
+    public:
+        Batch::RunStatus run(void);
+
+    // data members
+    private:
+        int m_batchNumber;
+
+        // copies from main Premo app, not owned
+        std::vector<BamTools::BamReader*> m_readers;
+};
+
+#endif // BAMBATCH_H
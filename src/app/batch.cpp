@@ -2,7 +2,7 @@
 // batch.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Premo batch
 // ***************************************************************************
@@ -17,7 +17,9 @@ using namespace std;
 
 Batch::Batch(PremoSettings* settings)
     : m_settings(settings)
-{ }
+{
+    m_timings.JobName = m_settings->BatchFilePrefix;
+}
 
 Batch::~Batch(void) { }
 
@@ -28,3 +30,11 @@ string Batch::errorString(void) const {
 Result Batch::result(void) const {
     return m_result;
 }
+
+void Batch::setBatchNumber(const int batchNumber) {
+    m_timings.BatchNumber = batchNumber;
+}
+
+BatchTimings Batch::timings(void) const {
+    return m_timings;
+}
@@ -2,7 +2,7 @@
 // batch.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Premo batch interface
 // ***************************************************************************
@@ -11,6 +11,7 @@
 #define BATCH_H
 
 #include "result.h"
+#include "telemetry.h"
 #include <string>
 class PremoSettings;
 
@@ -36,6 +37,8 @@ class Batch {
         virtual std::string errorString(void) const;
         virtual Result result(void) const;
         virtual Batch::RunStatus run(void) =0;        // implementation depends on SE/PE mode
+        virtual BatchTimings timings(void) const;
+        void setBatchNumber(const int batchNumber);   // for labelling timings only
 
     // data members (accessible to subclasses)
     protected:
@@ -46,6 +49,9 @@ class Batch {
         // our main result
         Result m_result;
 
+        // stage timings & throughput
+        BatchTimings m_timings;
+
         // error reporting
         std::string m_errorString;
 };
@@ -0,0 +1,173 @@
+// ***************************************************************************
+// client.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Submits a single job to a Premo server (-serve) & writes its output
+// ***************************************************************************
+
+#include "client.h"
+#include "fastqreader.h"
+#include "linesocket.h"
+#include "premo_utils.h"
+
+#include "jsoncpp/json_reader.h"
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// Client implementation
+// ------------------------
+
+Client::Client(const PremoSettings& settings)
+    : m_settings(settings)
+{ }
+
+Client::~Client(void) { }
+
+string Client::errorString(void) const {
+    return m_errorString;
+}
+
+bool Client::run(void) {
+
+    if ( !validateSettings() )
+        return false;
+
+    // ---------------------------------------
+    // build request
+    // ---------------------------------------
+
+    // N.B. - server may be running in a different directory
+    Json::Value request(Json::objectValue);
+    request["id"] = m_settings.OutputFilename;
+    if ( m_settings.HasFastqFilename1 )
+        request["fq1"] = absolutePath(m_settings.FastqFilename1);
+    if ( m_settings.HasFastqFilename2 )
+        request["fq2"] = absolutePath(m_settings.FastqFilename2);
+    if ( m_settings.HasUnalignedBamFilename )
+        request["ubam"] = absolutePath(m_settings.UnalignedBamFilename);
+    if ( m_settings.HasAlignedBamFilename )
+        request["bam"] = absolutePath(m_settings.AlignedBamFilename);
+    if ( m_settings.HasSeqTech )
+        request["st"] = m_settings.SeqTech;
+    if ( m_settings.HasBatchSize )
+        request["n"] = m_settings.BatchSize;
+    request["se"] = m_settings.IsSingleEndMode;
+
+    // ---------------------------------------
+    // submit & wait for result
+    // ---------------------------------------
+
+    LineSocket socket;
+    Json::FastWriter writer;
+    if ( !socket.connect(m_settings.SubmitSocketFilename) ||
+         !socket.writeLine(writer.write(request)) )
+    {
+        m_errorString = socket.errorString();
+        return false;
+    }
+
+    Json::Reader reader;
+    Json::Value response;
+    string line;
+    while ( true ) {
+
+        if ( !socket.readLine(&line) ) {
+            m_errorString = "lost connection to server";
+            if ( !socket.errorString().empty() ) {
+                m_errorString.append(": ");
+                m_errorString.append(socket.errorString());
+            }
+            return false;
+        }
+
+        if ( !reader.parse(line, response) || !response.isObject() ) {
+            m_errorString = "invalid response from server: ";
+            m_errorString.append(line);
+            return false;
+        }
+
+        // report progress
+        const string event = response.get("event", "").asString();
+        if ( event == "progress" ) {
+            if ( m_settings.IsVerbose ) {
+                cerr << "batch " << response.get("batch", 0).asInt() << " done, overall result: "
+                     << writer.write(response["overall"]);
+            }
+            continue;
+        }
+
+        if ( event == "result" )
+            break;
+    }
+
+    if ( response.get("status", "").asString() != "ok" ) {
+        m_errorString = response.get("error", "unknown server error").asString();
+        return false;
+    }
+
+    // ---------------------------------------
+    // write output
+    // ---------------------------------------
+
+    ofstream outFile(m_settings.OutputFilename.c_str());
+    if ( !outFile ) {
+        m_errorString = "could not open final output file: ";
+        m_errorString.append(m_settings.OutputFilename);
+        return false;
+    }
+
+    Json::StyledStreamWriter styledWriter("  ");
+    styledWriter.write(outFile, response["output"]);
+    outFile.close();
+
+    if ( m_settings.IsVerbose )
+        cerr << "results written OK" << endl;
+    return true;
+}
+
+bool Client::validateSettings(void) {
+
+    stringstream missing("");
+    bool hasMissing = false;
+
+    if ( !m_settings.HasOutputFilename || m_settings.OutputFilename.empty() ) {
+        missing << endl << "\t-out (output filename)";
+        hasMissing = true;
+    }
+
+    if ( !m_settings.HasFastqFilename1 && !m_settings.HasUnalignedBamFilename && !m_settings.HasAlignedBamFilename ) {
+        missing << endl << "\t-fq1 (FASTQ filename), -ubam (unaligned BAM filename) or -bam (aligned BAM filename)";
+        hasMissing = true;
+    }
+
+    if ( hasMissing ) {
+        m_errorString = "\nthe following parameters are missing:";
+        m_errorString.append(missing.str());
+        return false;
+    }
+
+    if ( m_settings.HasManifestFilename || m_settings.HasServeSocketFilename ) {
+        m_errorString = "\nthe following parameters are invalid:"
+                        "\n\t-submit cannot be combined with -manifest or -serve";
+        return false;
+    }
+
+    // the server opens input files itself
+    if ( FastqReader::isStandardIn(m_settings.FastqFilename1) ||
+         FastqReader::isStandardIn(m_settings.FastqFilename2) )
+    {
+        m_errorString = "\nthe following parameters are invalid:"
+                        "\n\t-submit sends filenames to the server, it cannot read FASTQ from stdin";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,38 @@
+// ***************************************************************************
+// client.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Submits a single job to a Premo server (-serve) & writes its output
+// ***************************************************************************
+
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include "premo_settings.h"
+#include <string>
+
+class Client {
+
+    // ctor & dtor
+    public:
+        Client(const PremoSettings& settings);
+        ~Client(void);
+
+    // Client interface
+    public:
+        std::string errorString(void) const;
+        bool run(void);   // returns false if job could not be submitted, or failed
+
+    // internal methods
+    private:
+        bool validateSettings(void);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        std::string m_errorString;
+};
+
+#endif // CLIENT_H
@@ -2,7 +2,7 @@
 // fastq.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 June 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // FASTQ entry
 // ***************************************************************************
@@ -26,3 +26,7 @@ Fastq::Fastq(const Fastq &other)
 { }
 
 Fastq::~Fastq(void) { }
+
+size_t Fastq::textLength(void) const {
+    return Header.length() + Bases.length() + PLUS.length() + Qualities.length() + 4;
+}
@@ -2,7 +2,7 @@
 // fastq.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 June 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // FASTQ entry
 // ***************************************************************************
@@ -26,6 +26,9 @@ struct Fastq {
     Fastq(const Fastq& other);
     ~Fastq(void);
 
+    // size of entry as FASTQ text (header, bases, '+' & qualities lines)
+    size_t textLength(void) const;
+
     // constants
     static const std::string AT;
     static const std::string PLUS;
@@ -2,7 +2,7 @@
 // fastqreader.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 9 May 2013 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // FASTQ file reader
 // ***************************************************************************
@@ -10,11 +10,21 @@
 #include "fastqreader.h"
 #include "fastq.h"
 #include <zlib.h>
+#ifdef PREMO_HAVE_ZSTD
+#include <zstd.h>
+#endif
 #include <bamtools/api/bamtools_global.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
+#include <vector>
 using namespace std;
 
 // -------------------------
@@ -29,11 +39,13 @@ class IStream {
 
     public:
         virtual void  close(void) =0;
+        virtual int64_t compressedTell(void) const =0;
+        virtual std::string errorString(void) const { return std::string(); } // decoding errors
         virtual char  getc(void) =0;
         virtual char* gets(char* dest, const size_t length) =0;
         virtual bool  isEOF(void) const =0;
         virtual bool  isOpen(void) const =0;
-        virtual void  open(const char* filename) =0;
+        virtual int64_t tell(void) const =0;
         virtual int   ungetc(const char c) =0;
 };
 
@@ -44,11 +56,13 @@ class FileStream : public IStream {
         ~FileStream(void) { }
     public:
         void close(void)                            { fclose(file); }
+        int64_t compressedTell(void) const          { return ftell(file); }
         char getc(void)                             { return fgetc(file); }
         char* gets(char* dest, const size_t length) { return fgets(dest, length, file); }
         bool isEOF(void) const                      { return ( feof(file) != 0 ); }
         bool isOpen(void) const                     { return file != 0; }
-        void open(const char* filename)             { file = fopen(filename, "rb"); }
+        void open(const int fd)                     { file = fdopen(fd, "rb"); if ( file == 0 ) ::close(fd); }
+        int64_t tell(void) const                    { return ftell(file); }
         int ungetc(const char c)                    { return ::ungetc(c, file); }
     private:
         FILE* file;
@@ -61,16 +75,550 @@ class GzFileStream : public IStream {
         ~GzFileStream(void) { }
     public:
         void close(void)                            { gzclose(file); }
+        int64_t compressedTell(void) const          { return gzoffset(file); }
         char getc(void)                             { return gzgetc(file); }
         char* gets(char* dest, const size_t length) { return gzgets(file, dest, length); }
         bool isEOF(void) const                      { return ( gzeof(file) != 0 ); }
         bool isOpen(void) const                     { return file != 0; }
-        void open(const char* filename)             { file = gzopen(filename, "rb"); }
+        void open(const int fd)                     { file = gzdopen(fd, "rb"); if ( file == 0 ) ::close(fd); }
+        int64_t tell(void) const                    { return gztell(file); }
         int ungetc(const char c)                    { return gzungetc(c, file); }
     private:
         gzFile file;
 };
 
+// ------------------------------------------------------------------
+// buffered, decoding streams
+// (used for input that cannot be re-read after sniffing its format,
+//  and for codecs without a stdio-like library interface)
+// ------------------------------------------------------------------
+
+static const size_t RAW_BUFFER_SIZE     = 131072;
+static const size_t DECODED_BUFFER_SIZE = 131072;
+
+// read-ahead buffer on a file descriptor (owned), allows peeking at magic numbers without seeking
+class RawInput {
+
+    public:
+        RawInput(const int fd)
+            : m_fd(fd)
+            , m_buffer(RAW_BUFFER_SIZE)
+            , m_begin(0)
+            , m_end(0)
+            , m_offset(0)
+            , m_isEOF(false)
+            , m_isError(false)
+        { }
+        ~RawInput(void) { ::close(m_fd); }
+
+    public:
+        void consume(const size_t n)  { assert(n <= size()); m_begin += n; }
+        const char* data(void) const  { return &m_buffer[m_begin]; }
+        bool isError(void) const      { return m_isError; }
+        int64_t offset(void) const    { return m_offset; } // bytes read from descriptor
+        size_t size(void) const       { return m_end - m_begin; }
+
+        // reads until at least minimumSize bytes are buffered, returns false if not possible (EOF or error)
+        bool fill(const size_t minimumSize = 1) {
+
+            assert(minimumSize <= m_buffer.size());
+
+            // move any unconsumed bytes to front
+            if ( m_begin != 0 ) {
+                memmove(&m_buffer[0], &m_buffer[m_begin], size());
+                m_end -= m_begin;
+                m_begin = 0;
+            }
+
+            while ( size() < minimumSize && !m_isEOF && !m_isError ) {
+                const ssize_t numBytes = ::read(m_fd, &m_buffer[m_end], m_buffer.size() - m_end);
+                if ( numBytes > 0 ) {
+                    m_end += numBytes;
+                    m_offset += numBytes;
+                }
+                else if ( numBytes == 0 )
+                    m_isEOF = true;
+                else if ( errno != EINTR )
+                    m_isError = true;
+            }
+            return ( size() >= minimumSize );
+        }
+
+    private:
+        int m_fd;
+        vector<char> m_buffer;
+        size_t m_begin;
+        size_t m_end;
+        int64_t m_offset;
+        bool m_isEOF;
+        bool m_isError;
+};
+
+// line-oriented reads over blocks produced by decode()
+class DecodedStream : public IStream {
+
+    protected:
+        DecodedStream(void)
+            : IStream()
+            , m_buffer(DECODED_BUFFER_SIZE)
+            , m_pos(0)
+            , m_end(0)
+            , m_decodedOffset(0)
+            , m_isEOF(false)
+        { }
+    public:
+        virtual ~DecodedStream(void) { }
+
+    public:
+        std::string errorString(void) const { return m_errorString; }
+        bool isEOF(void) const              { return m_isEOF; }
+        int64_t tell(void) const            { return m_decodedOffset - static_cast<int64_t>(m_end - m_pos); }
+
+        char getc(void) {
+            if ( m_pos == m_end && !refill() )
+                return EOF;
+            return m_buffer[m_pos++];
+        }
+
+        // same semantics as fgets()
+        char* gets(char* dest, const size_t length) {
+            size_t n = 0;
+            while ( n + 1 < length ) {
+                if ( m_pos == m_end && !refill() )
+                    break;
+                const char c = m_buffer[m_pos++];
+                dest[n++] = c;
+                if ( c == '\n' )
+                    break;
+            }
+            dest[n] = '\0';
+            return ( n != 0 ? dest : 0 );
+        }
+
+        int ungetc(const char c) {
+            if ( c == EOF || m_pos == 0 || m_isEOF )
+                return EOF;
+            m_buffer[--m_pos] = c;
+            return c;
+        }
+
+    protected:
+        // decodes up to capacity bytes into dest, returns 0 at end of input (sets m_errorString on failure)
+        virtual size_t decode(char* dest, const size_t capacity) =0;
+
+    private:
+        bool refill(void) {
+            if ( m_isEOF || !m_errorString.empty() )
+                return false;
+            m_pos = 0;
+            m_end = decode(&m_buffer[0], m_buffer.size());
+            m_decodedOffset += m_end;
+            if ( m_end == 0 ) {
+                m_isEOF = m_errorString.empty();
+                return false;
+            }
+            return true;
+        }
+
+    protected:
+        std::string m_errorString;
+    private:
+        vector<char> m_buffer;
+        size_t m_pos;
+        size_t m_end;
+        int64_t m_decodedOffset;
+        bool m_isEOF;
+};
+
+// decoding stream over a RawInput (owned)
+class RawDecodedStream : public DecodedStream {
+
+    protected:
+        RawDecodedStream(RawInput* input) : DecodedStream(), m_input(input) { }
+    public:
+        virtual ~RawDecodedStream(void) { delete m_input; }
+
+    public:
+        void close(void)                   { delete m_input; m_input = 0; }
+        int64_t compressedTell(void) const { return m_input->offset(); }
+        bool isOpen(void) const            { return m_input != 0; }
+
+    protected:
+        // refills input if empty, returns false at end of input (setting error if input failed)
+        bool ensureInput(void) {
+            if ( m_input->size() != 0 || m_input->fill() )
+                return true;
+            if ( m_input->isError() )
+                m_errorString = "could not read from input";
+            return false;
+        }
+
+    protected:
+        RawInput* m_input;
+};
+
+class PlainStream : public RawDecodedStream {
+
+    public:
+        PlainStream(RawInput* input) : RawDecodedStream(input) { }
+
+    protected:
+        size_t decode(char* dest, const size_t capacity) {
+            if ( !ensureInput() )
+                return 0;
+            const size_t n = min(capacity, m_input->size());
+            memcpy(dest, m_input->data(), n);
+            m_input->consume(n);
+            return n;
+        }
+};
+
+// gzip, including concatenated members (pigz, bgzip)
+class GzipStream : public RawDecodedStream {
+
+    public:
+        GzipStream(RawInput* input)
+            : RawDecodedStream(input)
+            , m_isMemberEnd(false)
+            , m_hasPendingOutput(false)
+        {
+            memset(&m_zstream, 0, sizeof(m_zstream));
+            if ( inflateInit2(&m_zstream, 15 + 16) != Z_OK )
+                m_errorString = "could not initialize gzip decompression";
+        }
+        ~GzipStream(void) { inflateEnd(&m_zstream); }
+
+    protected:
+        size_t decode(char* dest, const size_t capacity) {
+
+            m_zstream.next_out  = reinterpret_cast<Bytef*>(dest);
+            m_zstream.avail_out = capacity;
+
+            while ( m_zstream.avail_out == capacity ) {
+
+                // get more input, unless inflate still holds output for us
+                if ( !m_hasPendingOutput && !ensureInput() ) {
+                    if ( m_errorString.empty() && !m_isMemberEnd )
+                        m_errorString = "truncated gzip input";
+                    break;
+                }
+
+                // start next member
+                if ( m_isMemberEnd && m_input->size() != 0 ) {
+                    inflateReset(&m_zstream);
+                    m_isMemberEnd = false;
+                }
+
+                const size_t available = m_input->size();
+                m_zstream.next_in  = reinterpret_cast<Bytef*>( const_cast<char*>(m_input->data()) );
+                m_zstream.avail_in = available;
+                const int status = inflate(&m_zstream, Z_NO_FLUSH);
+                m_input->consume(available - m_zstream.avail_in);
+
+                if ( status == Z_STREAM_END )
+                    m_isMemberEnd = true;
+                else if ( status != Z_OK && status != Z_BUF_ERROR ) {
+                    m_errorString = "gzip decompression failed: ";
+                    m_errorString.append( m_zstream.msg ? m_zstream.msg : "corrupt input" );
+                    break;
+                }
+                m_hasPendingOutput = ( m_zstream.avail_out == 0 );
+            }
+
+            return capacity - m_zstream.avail_out;
+        }
+
+    private:
+        z_stream m_zstream;
+        bool m_isMemberEnd;
+        bool m_hasPendingOutput;
+};
+
+#ifdef PREMO_HAVE_ZSTD
+
+// zstd, any number of frames (skippable frames, e.g. seek tables, are ignored)
+class ZstdStream : public RawDecodedStream {
+
+    public:
+        ZstdStream(RawInput* input)
+            : RawDecodedStream(input)
+            , m_dstream(ZSTD_createDStream())
+            , m_isFrameEnd(true)
+            , m_hasPendingOutput(false)
+        {
+            if ( m_dstream == 0 || ZSTD_isError(ZSTD_initDStream(m_dstream)) )
+                m_errorString = "could not initialize zstd decompression";
+        }
+        ~ZstdStream(void) { ZSTD_freeDStream(m_dstream); }
+
+    protected:
+        size_t decode(char* dest, const size_t capacity) {
+
+            ZSTD_outBuffer output = { dest, capacity, 0 };
+            while ( output.pos == 0 ) {
+
+                // get more input, unless decoder still holds output for us
+                if ( !m_hasPendingOutput && !ensureInput() ) {
+                    if ( m_errorString.empty() && !m_isFrameEnd )
+                        m_errorString = "truncated zstd input";
+                    break;
+                }
+
+                ZSTD_inBuffer input = { m_input->data(), m_input->size(), 0 };
+                const size_t status = ZSTD_decompressStream(m_dstream, &output, &input);
+                m_input->consume(input.pos);
+
+                if ( ZSTD_isError(status) ) {
+                    m_errorString = "zstd decompression failed: ";
+                    m_errorString.append( ZSTD_getErrorName(status) );
+                    break;
+                }
+                m_isFrameEnd = ( status == 0 );
+                m_hasPendingOutput = ( output.pos == output.size );
+            }
+
+            return output.pos;
+        }
+
+    private:
+        ZSTD_DStream* m_dstream;
+        bool m_isFrameEnd;
+        bool m_hasPendingOutput;
+};
+
+// -----------------------------------------------------------------------
+// seekable zstd - independent frames, listed in a seek table at the end
+// of the file, so that groups of frames can be decompressed in parallel
+// -----------------------------------------------------------------------
+
+static const uint32_t ZSTD_SKIPPABLE_MAGIC_NUMBER = 0x184D2A5E;
+static const uint32_t ZSTD_SEEKABLE_MAGIC_NUMBER  = 0x8F92EAB1;
+static const size_t   ZSTD_SEEK_TABLE_FOOTER_SIZE = 9;
+
+struct ZstdFrame {
+    int64_t  Offset;
+    uint32_t CompressedSize;
+    uint32_t DecompressedSize;
+};
+
+static inline
+uint32_t readLittleEndian32(const unsigned char* data) {
+    return static_cast<uint32_t>(data[0])         |
+           (static_cast<uint32_t>(data[1]) << 8)  |
+           (static_cast<uint32_t>(data[2]) << 16) |
+           (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// returns false if file has no (valid) seek table
+static
+bool readZstdSeekTable(const int fd, const int64_t fileSize, vector<ZstdFrame>* frames) {
+
+    // footer: frame count, descriptor (bit 7 = checksums present), seekable magic number
+    if ( fileSize < static_cast<int64_t>(8 + ZSTD_SEEK_TABLE_FOOTER_SIZE) )
+        return false;
+    unsigned char footer[ZSTD_SEEK_TABLE_FOOTER_SIZE];
+    if ( pread(fd, footer, sizeof(footer), fileSize - sizeof(footer)) != static_cast<ssize_t>(sizeof(footer)) )
+        return false;
+    if ( readLittleEndian32(footer + 5) != ZSTD_SEEKABLE_MAGIC_NUMBER )
+        return false;
+
+    const uint32_t numFrames = readLittleEndian32(footer);
+    const size_t entrySize = ( (footer[4] & 0x80) != 0 ? 12 : 8 );
+    const int64_t tableSize = 8 + static_cast<int64_t>(numFrames) * entrySize + ZSTD_SEEK_TABLE_FOOTER_SIZE;
+    if ( numFrames == 0 || tableSize > fileSize )
+        return false;
+
+    // table is a skippable frame
+    vector<unsigned char> table(tableSize);
+    if ( pread(fd, &table[0], tableSize, fileSize - tableSize) != tableSize )
+        return false;
+    if ( readLittleEndian32(&table[0]) != ZSTD_SKIPPABLE_MAGIC_NUMBER ||
+         readLittleEndian32(&table[4]) != static_cast<uint32_t>(tableSize - 8) )
+    {
+        return false;
+    }
+
+    // frame entries: compressed size, decompressed size (, checksum)
+    frames->clear();
+    frames->reserve(numFrames);
+    int64_t offset = 0;
+    for ( uint32_t i = 0; i < numFrames; ++i ) {
+        const unsigned char* entry = &table[8 + i * entrySize];
+        ZstdFrame frame;
+        frame.Offset           = offset;
+        frame.CompressedSize   = readLittleEndian32(entry);
+        frame.DecompressedSize = readLittleEndian32(entry + 4);
+        frames->push_back(frame);
+        offset += frame.CompressedSize;
+    }
+
+    // frames must account for the rest of the file
+    return ( offset + tableSize == fileSize );
+}
+
+struct ZstdFrameTask {
+
+    // input
+    int Fd;
+    const ZstdFrame* Frame;
+    char* Dest;
+
+    // output
+    bool IsOk;
+    std::string ErrorString;
+
+    // ctor
+    ZstdFrameTask(void)
+        : Fd(-1)
+        , Frame(0)
+        , Dest(0)
+        , IsOk(true)
+    { }
+};
+
+static
+void* runZstdFrameTask(void* data) {
+
+    ZstdFrameTask* task = static_cast<ZstdFrameTask*>(data);
+    assert(task && task->Frame);
+
+    vector<char> compressed(task->Frame->CompressedSize);
+    if ( pread(task->Fd, &compressed[0], compressed.size(), task->Frame->Offset) !=
+         static_cast<ssize_t>(compressed.size()) )
+    {
+        task->ErrorString = "could not read zstd frame from input";
+        task->IsOk = false;
+        return 0;
+    }
+
+    const size_t result = ZSTD_decompress(task->Dest, task->Frame->DecompressedSize,
+                                          &compressed[0], compressed.size());
+    if ( ZSTD_isError(result) ) {
+        task->ErrorString = "zstd decompression failed: ";
+        task->ErrorString.append( ZSTD_getErrorName(result) );
+        task->IsOk = false;
+    } else if ( result != task->Frame->DecompressedSize ) {
+        task->ErrorString = "zstd frame size does not match seek table";
+        task->IsOk = false;
+    }
+    return 0;
+}
+
+// decompresses the next numThreads frames at once (one thread per frame)
+class ParallelZstdStream : public DecodedStream {
+
+    public:
+        ParallelZstdStream(const int fd, const vector<ZstdFrame>& frames, const unsigned int numThreads)
+            : DecodedStream()
+            , m_fd(fd)
+            , m_frames(frames)
+            , m_numThreads(numThreads)
+            , m_nextFrame(0)
+            , m_groupPos(0)
+            , m_compressedOffset(0)
+        {
+            assert(m_numThreads > 0);
+        }
+        ~ParallelZstdStream(void) { close(); }
+
+    public:
+        void close(void)                   { if ( m_fd >= 0 ) ::close(m_fd); m_fd = -1; }
+        int64_t compressedTell(void) const { return m_compressedOffset; }
+        bool isOpen(void) const            { return m_fd >= 0; }
+
+    protected:
+        size_t decode(char* dest, const size_t capacity) {
+            if ( m_groupPos == m_group.size() && !decodeNextGroup() )
+                return 0;
+            const size_t n = min(capacity, m_group.size() - m_groupPos);
+            memcpy(dest, &m_group[m_groupPos], n);
+            m_groupPos += n;
+            return n;
+        }
+
+    private:
+        bool decodeNextGroup(void) {
+
+            // skip empty frames, stop at end of table
+            while ( m_nextFrame < m_frames.size() && m_frames.at(m_nextFrame).DecompressedSize == 0 )
+                m_compressedOffset += m_frames.at(m_nextFrame++).CompressedSize;
+            if ( m_nextFrame == m_frames.size() )
+                return false;
+
+            // set up one task per frame
+            const size_t numTasks = min<size_t>(m_numThreads, m_frames.size() - m_nextFrame);
+            size_t groupSize = 0;
+            for ( size_t i = 0; i < numTasks; ++i )
+                groupSize += m_frames.at(m_nextFrame + i).DecompressedSize;
+            m_group.resize(groupSize);
+            m_groupPos = 0;
+
+            vector<ZstdFrameTask> tasks(numTasks);
+            size_t destOffset = 0;
+            for ( size_t i = 0; i < numTasks; ++i ) {
+                ZstdFrameTask& task = tasks[i];
+                task.Fd    = m_fd;
+                task.Frame = &m_frames.at(m_nextFrame + i);
+                task.Dest  = ( groupSize != 0 ? &m_group[destOffset] : 0 );
+                destOffset += task.Frame->DecompressedSize;
+            }
+
+            // run tasks (calling thread handles the first task, plus any that failed to start)
+            vector<pthread_t> threads(numTasks);
+            vector<bool> isThreadStarted(numTasks, false);
+            for ( size_t i = 1; i < numTasks; ++i )
+                isThreadStarted[i] = ( pthread_create(&threads[i], 0, runZstdFrameTask, &tasks[i]) == 0 );
+            runZstdFrameTask(&tasks[0]);
+            for ( size_t i = 1; i < numTasks; ++i ) {
+                if ( isThreadStarted[i] )
+                    pthread_join(threads[i], 0);
+                else
+                    runZstdFrameTask(&tasks[i]);
+            }
+
+            for ( size_t i = 0; i < numTasks; ++i ) {
+                if ( !tasks.at(i).IsOk ) {
+                    m_errorString = tasks.at(i).ErrorString;
+                    m_group.clear();
+                    return false;
+                }
+                m_compressedOffset += tasks.at(i).Frame->CompressedSize;
+            }
+
+            m_nextFrame += numTasks;
+            return true;
+        }
+
+    private:
+        int m_fd;
+        vector<ZstdFrame> m_frames;
+        unsigned int m_numThreads;
+        size_t m_nextFrame;
+        vector<char> m_group;     // decompressed frames of current group
+        size_t m_groupPos;
+        int64_t m_compressedOffset;
+};
+
+#endif // PREMO_HAVE_ZSTD
+
+// ------------------------
+// magic numbers
+// ------------------------
+
+enum InputFormat { PlainFormat = 0
+                 , GzipFormat
+                 , ZstdFormat
+                 };
+
+static
+InputFormat detectFormat(const unsigned char* data, const size_t length) {
+    if ( length >= 2 && data[0] == 0x1f && data[1] == 0x8b )
+        return GzipFormat;
+    if ( length >= 4 && data[0] == 0x28 && data[1] == 0xb5 && data[2] == 0x2f && data[3] == 0xfd )
+        return ZstdFormat;
+    return PlainFormat;
+}
+
 // ------------------------
 // static utility methods
 // ------------------------
@@ -98,6 +646,8 @@ void chomp(char* s) {
 FastqReader::FastqReader(void)
     : m_stream(0)
     , m_isCompressed(false)
+    , m_isStream(false)
+    , m_numThreads(1)
     , m_buffer(0)
     , m_bufferLength(0)
 { }
@@ -108,9 +658,10 @@ FastqReader::~FastqReader(void) {
 
 void FastqReader::close(void) {
 
-    // close file stream
-    if ( isOpen() ) {
-        m_stream->close();
+    // close file stream (also cleans up after a failed open)
+    if ( m_stream ) {
+        if ( m_stream->isOpen() )
+            m_stream->close();
         delete m_stream;
         m_stream = 0;
     }
@@ -125,6 +676,14 @@ void FastqReader::close(void) {
     // clear any other file-dependent data
     m_filename.clear();
     m_isCompressed = false;
+    m_isStream = false;
+}
+
+int64_t FastqReader::compressedOffset(void) const {
+    if ( isOpen() )
+        return m_stream->compressedTell();
+    else
+        return -1;
 }
 
 string FastqReader::errorString(void) const {
@@ -142,6 +701,18 @@ bool FastqReader::isEOF(void) const {
         return false;
 }
 
+bool FastqReader::isCompressed(void) const {
+    return m_isCompressed;
+}
+
+bool FastqReader::isStandardIn(const string& filename) {
+    return ( filename == "-" || filename == "stdin" );
+}
+
+bool FastqReader::isStream(void) const {
+    return m_isStream;
+}
+
 bool FastqReader::isOpen(void) const {
     return m_stream != 0 && m_stream->isOpen();
 }
@@ -152,40 +723,96 @@ bool FastqReader::open(const string& filename) {
     close();
     assert(m_stream == 0);
 
-    // -----------------------------
-    // check the compression state
-    // -----------------------------
+    // ------------------------------------------
+    // open descriptor (stdin, pipe, FIFO or file)
+    // ------------------------------------------
 
-    FILE* checkStream = fopen(filename.c_str(), "rb");
-    if ( checkStream == 0 ) {
-
-        // if failed, set error & return failure
+    const bool isStdin = isStandardIn(filename);
+    const int fd = ( isStdin ? dup(STDIN_FILENO) : ::open(filename.c_str(), O_RDONLY) );
+    if ( fd < 0 ) {
         m_errorString = "could not open input FASTQ file: ";
         m_errorString.append(filename);
         return false;
     }
 
-    const uint16_t GZIP_MAGIC_NUMBER = 0x8b1f;
-    uint16_t magicNumber = 0;
-    const size_t numElements = fread((char*)&magicNumber, sizeof(magicNumber), 1, checkStream);
-    if ( numElements != 1 ) {
-        m_errorString = "could not read from input FASTQ file: ";
+    struct stat st;
+    m_isStream = ( fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) );
+
+    // ------------------------------------------------------------
+    // check the compression state & set up matching input stream
+    // ------------------------------------------------------------
+
+    // regular file - peek at magic number, without moving file position
+    if ( !m_isStream ) {
+
+        unsigned char magicNumber[4] = { 0, 0, 0, 0 };
+        const ssize_t magicLength = pread(fd, magicNumber, sizeof(magicNumber), 0);
+        if ( magicLength < 2 ) {
+            ::close(fd);
+            m_errorString = "could not read from input FASTQ file: ";
+            m_errorString.append(filename);
+            return false;
+        }
+
+        const InputFormat format = detectFormat(magicNumber, magicLength);
+        if ( format == GzipFormat ) {
+            GzFileStream* stream = new GzFileStream;
+            stream->open(fd);
+            m_stream = stream;
+        }
+        else if ( format == ZstdFormat ) {
+#ifdef PREMO_HAVE_ZSTD
+            vector<ZstdFrame> frames;
+            if ( m_numThreads > 1 && readZstdSeekTable(fd, st.st_size, &frames) )
+                m_stream = new ParallelZstdStream(fd, frames, m_numThreads);
+            else
+                m_stream = new ZstdStream(new RawInput(fd));
+#else
+            ::close(fd);
+#endif
+        }
+        else {
+            FileStream* stream = new FileStream;
+            stream->open(fd);
+            m_stream = stream;
+        }
+        m_isCompressed = ( format != PlainFormat );
+    }
+
+    // stream - cannot be re-read, so sniff magic number in our own read-ahead buffer
+    else {
+
+        RawInput* input = new RawInput(fd);
+        input->fill(4);
+        const InputFormat format =
+            detectFormat(reinterpret_cast<const unsigned char*>(input->data()), input->size());
+
+        if ( format == GzipFormat )
+            m_stream = new GzipStream(input);
+        else if ( format == ZstdFormat ) {
+#ifdef PREMO_HAVE_ZSTD
+            m_stream = new ZstdStream(input);
+#else
+            delete input;
+#endif
+        }
+        else
+            m_stream = new PlainStream(input);
+        m_isCompressed = ( format != PlainFormat );
+    }
+
+#ifndef PREMO_HAVE_ZSTD
+    if ( m_stream == 0 ) {
+        m_errorString = "input FASTQ file is zstd-compressed, but Premo was built without Zstandard support: ";
         m_errorString.append(filename);
         return false;
     }
-    fclose(checkStream);
-
-    m_isCompressed = ( magicNumber == GZIP_MAGIC_NUMBER );
-    if ( m_isCompressed )
-        m_stream = new GzFileStream;
-    else
-        m_stream = new FileStream;
+#endif
 
     // ----------------------
     // attempt to open file
     // ----------------------
 
-    m_stream->open(filename.c_str());
     if ( !isOpen() ) {
 
         // if failed, set error & return failure
@@ -203,6 +830,13 @@ bool FastqReader::open(const string& filename) {
     return true;
 }
 
+int64_t FastqReader::offset(void) const {
+    if ( isOpen() )
+        return m_stream->tell();
+    else
+        return -1;
+}
+
 bool FastqReader::readNext(Fastq *entry) {
 
     // fail if unopened file
@@ -218,6 +852,12 @@ bool FastqReader::readNext(Fastq *entry) {
     // read header
     char* result;
     result = m_stream->gets(m_buffer, m_bufferLength);
+    if ( !m_stream->errorString().empty() ) {
+        m_errorString = m_stream->errorString();
+        m_errorString.append(" - ");
+        m_errorString.append(m_filename);
+        return false;
+    }
     if ( m_stream->isEOF() ) {
         m_errorString = "could not read full FASTQ entry from file: ";
         m_errorString.append(m_filename);
@@ -237,7 +877,7 @@ bool FastqReader::readNext(Fastq *entry) {
     while ( true ) {
         const char c = m_stream->getc();
         m_stream->ungetc(c);
-        if ( c == '+' || m_stream->isEOF() )
+        if ( c == '+' || m_stream->isEOF() || !m_stream->errorString().empty() )
             break;
         result = m_stream->gets(m_buffer, m_bufferLength);
         chomp(m_buffer);
@@ -253,7 +893,7 @@ bool FastqReader::readNext(Fastq *entry) {
     while ( true ) {
         const char c = m_stream->getc();
         m_stream->ungetc(c);
-        if ( m_stream->isEOF() )
+        if ( m_stream->isEOF() || !m_stream->errorString().empty() )
             break;
         result = m_stream->gets(m_buffer, m_bufferLength);
         chomp(m_buffer);
@@ -264,6 +904,14 @@ bool FastqReader::readNext(Fastq *entry) {
     }
     entry->Qualities.assign(m_buffer);
 
+    // decoding error mid-entry
+    if ( !m_stream->errorString().empty() ) {
+        m_errorString = m_stream->errorString();
+        m_errorString.append(" - ");
+        m_errorString.append(m_filename);
+        return false;
+    }
+
     // sanity check
     if ( entry->Qualities.length() != entry->Bases.length() ) {
         m_errorString = "malformed FASTQ entry - the number of qualities does not match the number of bases";
@@ -273,3 +921,7 @@ bool FastqReader::readNext(Fastq *entry) {
     // return success
     return true;
 }
+
+void FastqReader::setNumThreads(const unsigned int numThreads) {
+    m_numThreads = ( numThreads > 0 ? numThreads : 1 );
+}
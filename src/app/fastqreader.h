@@ -2,7 +2,7 @@
 // fastqreader.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 9 May 2013 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // FASTQ file reader
 // ***************************************************************************
@@ -10,6 +10,7 @@
 #ifndef FASTQREADER_H
 #define FASTQREADER_H
 
+#include <stdint.h>
 #include <string>
 class Fastq;
 class IStream;
@@ -27,14 +28,28 @@ class FastqReader {
         std::string errorString(void) const;
         std::string filename(void) const;
         bool isEOF(void) const;              // N.B. - returns true if unopened, otherwise true if EOF
+        bool isCompressed(void) const;
         bool isOpen(void) const;
-        bool open(const std::string& filename);
+        bool isStream(void) const;           // stdin, pipe or FIFO (size unknown, cannot be re-read)
+        bool open(const std::string& filename);  // "-" or "stdin" reads from standard input
         bool readNext(Fastq* entry);
 
+        // threads used to decompress seekable zstd input (set before open(), default 1)
+        void setNumThreads(const unsigned int numThreads);
+
+        // read positions (-1 if unopened), in FASTQ text & in the file itself (differ only if compressed)
+        // N.B. - compressed offset includes zlib's read-ahead
+        int64_t offset(void) const;
+        int64_t compressedOffset(void) const;
+
+        static bool isStandardIn(const std::string& filename);
+
     // data members
     private:
         IStream* m_stream;
         bool m_isCompressed;
+        bool m_isStream;
+        unsigned int m_numThreads;
 
         char*  m_buffer;
         size_t m_bufferLength;
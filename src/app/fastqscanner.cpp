@@ -0,0 +1,341 @@
+// ***************************************************************************
+// fastqscanner.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Multi-threaded, whole-file read length scanner (uncompressed FASTQ only)
+// ***************************************************************************
+
+#include "fastqscanner.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+// don't bother splitting the input into ranges smaller than this
+static const size_t MINIMUM_RANGE_LENGTH = 1 << 20; // 1 MB
+
+// returns the start of the line following pos (or end, if none)
+static inline
+const char* nextLine(const char* pos, const char* end) {
+    const char* newline = static_cast<const char*>( memchr(pos, '\n', end - pos) );
+    return ( newline ? newline + 1 : end );
+}
+
+// returns the length of the line starting at pos, without any trailing "\r\n"
+static inline
+size_t lineLength(const char* pos, const char* end) {
+    const char* lineEnd = static_cast<const char*>( memchr(pos, '\n', end - pos) );
+    if ( lineEnd == 0 )
+        lineEnd = end;
+    if ( lineEnd > pos && *(lineEnd - 1) == '\r' )
+        --lineEnd;
+    return lineEnd - pos;
+}
+
+// returns true if the line at pos begins a FASTQ entry
+//
+// A header line starts with '@', but so may a quality line. To disambiguate, we also
+// require that the entry's 3rd line starts with '+' and that its bases & qualities have
+// equal length. A quality line that starts with '@' is followed by the next header,
+// then bases - which can never start with '+' - so it is always rejected here.
+static
+bool isEntryStart(const char* pos, const char* end) {
+
+    if ( pos >= end || *pos != '@' )
+        return false;
+
+    const char* bases = nextLine(pos, end);
+    if ( bases >= end )
+        return false;
+
+    const char* plus = nextLine(bases, end);
+    if ( plus >= end || *plus != '+' )
+        return false;
+
+    const char* qualities = nextLine(plus, end);
+    return ( lineLength(bases, end) == lineLength(qualities, end) );
+}
+
+// returns the start of the first FASTQ entry found at or after pos (or end, if none)
+static
+const char* synchronize(const char* pos, const char* begin, const char* end) {
+
+    // move to the start of a line
+    if ( pos != begin )
+        pos = nextLine(pos - 1, end);
+
+    // skip lines until we find an entry start
+    while ( pos < end && !isEntryStart(pos, end) )
+        pos = nextLine(pos, end);
+    return pos;
+}
+
+// ------------------------
+// per-thread scan data
+// ------------------------
+
+struct ScanRange {
+
+    // data members
+    const char* Begin;   // both Begin & End lie on entry boundaries
+    const char* End;
+    std::vector<uint64_t> ReadLengthCounts;
+    bool IsOk;
+    const char* ErrorPosition;   // start of malformed entry, if not IsOk
+    std::string ErrorString;
+
+    // ctor
+    ScanRange(const char* begin = 0, const char* end = 0)
+        : Begin(begin)
+        , End(end)
+        , IsOk(true)
+        , ErrorPosition(0)
+    { }
+};
+
+static
+void* scanRange(void* data) {
+
+    ScanRange* range = static_cast<ScanRange*>(data);
+    assert(range);
+
+    const char* pos = range->Begin;
+    const char* end = range->End;
+    while ( pos < end ) {
+
+        // skip blank lines (e.g. trailing newlines at end of file)
+        if ( *pos == '\n' || *pos == '\r' ) {
+            pos = nextLine(pos, end);
+            continue;
+        }
+
+        // header
+        if ( *pos != '@' ) {
+            range->ErrorString = "malformed FASTQ entry - expected '@' in header, instead found: ";
+            range->ErrorString.append(1, *pos);
+            range->IsOk = false;
+            range->ErrorPosition = pos;
+            return 0;
+        }
+
+        // bases
+        const char* bases = nextLine(pos, end);
+        const char* plus  = nextLine(bases, end);
+        if ( plus >= end || *plus != '+' ) {
+            range->ErrorString = "malformed FASTQ entry - expected '+' line after bases (multi-line entries are not supported)";
+            range->IsOk = false;
+            range->ErrorPosition = pos;
+            return 0;
+        }
+
+        // qualities
+        const char* qualities = nextLine(plus, end);
+        const size_t numBases = lineLength(bases, end);
+        if ( qualities >= end || lineLength(qualities, end) != numBases ) {
+            range->ErrorString = "malformed FASTQ entry - the number of qualities does not match the number of bases";
+            range->IsOk = false;
+            range->ErrorPosition = pos;
+            return 0;
+        }
+
+        // store read length
+        if ( numBases >= range->ReadLengthCounts.size() )
+            range->ReadLengthCounts.resize(numBases + 1, 0);
+        ++range->ReadLengthCounts[numBases];
+
+        // move to next entry
+        pos = nextLine(qualities, end);
+    }
+
+    return 0;
+}
+
+// -----------------------------
+// FastqScanner implementation
+// -----------------------------
+
+FastqScanner::FastqScanner(void)
+    : m_data(0)
+    , m_dataLength(0)
+{ }
+
+FastqScanner::~FastqScanner(void) {
+    close();
+}
+
+void FastqScanner::close(void) {
+
+    // unmap file contents
+    if ( m_data ) {
+        munmap( const_cast<char*>(m_data), m_dataLength );
+        m_data = 0;
+        m_dataLength = 0;
+    }
+
+    // clear any other file-dependent data
+    m_filename.clear();
+}
+
+string FastqScanner::errorString(void) const {
+    return m_errorString;
+}
+
+string FastqScanner::filename(void) const {
+    return m_filename;
+}
+
+bool FastqScanner::isOpen(void) const {
+    return ( m_data != 0 );
+}
+
+bool FastqScanner::open(const string& filename) {
+
+    // ensure clean slate
+    close();
+
+    // open file & check its size
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if ( fd < 0 ) {
+        m_errorString = "could not open input FASTQ file: ";
+        m_errorString.append(filename);
+        return false;
+    }
+
+    struct stat st;
+    if ( fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ) {
+        ::close(fd);
+        m_errorString = "exact read length scan requires a regular file: ";
+        m_errorString.append(filename);
+        return false;
+    }
+
+    if ( st.st_size == 0 ) {
+        ::close(fd);
+        m_errorString = "input FASTQ file is empty: ";
+        m_errorString.append(filename);
+        return false;
+    }
+
+    // map file contents (the mapping stays valid after closing the descriptor)
+    void* data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( data == MAP_FAILED ) {
+        m_errorString = "could not map input FASTQ file into memory: ";
+        m_errorString.append(filename);
+        return false;
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char*>(data);
+    m_dataLength = st.st_size;
+
+    // compressed (gzip or zstd) input can't be split into byte ranges
+    const unsigned char GZIP_MAGIC[] = { 0x1f, 0x8b };
+    const unsigned char ZSTD_MAGIC[] = { 0x28, 0xb5, 0x2f, 0xfd };
+    if ( ( m_dataLength >= sizeof(GZIP_MAGIC) && memcmp(m_data, GZIP_MAGIC, sizeof(GZIP_MAGIC)) == 0 ) ||
+         ( m_dataLength >= sizeof(ZSTD_MAGIC) && memcmp(m_data, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0 ) )
+    {
+        close();
+        m_errorString = "exact read length scan requires an uncompressed FASTQ file: ";
+        m_errorString.append(filename);
+        return false;
+    }
+
+    // store filename & return success
+    m_filename = filename;
+    return true;
+}
+
+bool FastqScanner::scan(const unsigned int numThreads, vector<uint64_t>* readLengthCounts) {
+
+    // fail if unopened file
+    if ( !isOpen() ) {
+        m_errorString = "cannot scan unopened file";
+        return false;
+    }
+
+    // sanity checks
+    assert(readLengthCounts);
+    assert(numThreads > 0);
+
+    // -----------------------------------------------------
+    // split file into ranges, aligned on entry boundaries
+    // -----------------------------------------------------
+
+    const char* begin = m_data;
+    const char* end   = m_data + m_dataLength;
+
+    size_t numRanges = m_dataLength / MINIMUM_RANGE_LENGTH;
+    if ( numRanges > numThreads ) numRanges = numThreads;
+    if ( numRanges == 0 )         numRanges = 1;
+
+    const size_t rangeLength = m_dataLength / numRanges;
+
+    vector<ScanRange> ranges;
+    ranges.reserve(numRanges);
+    const char* rangeBegin = begin;
+    for ( size_t i = 1; i <= numRanges; ++i ) {
+        const char* rangeEnd = ( i == numRanges ? end : synchronize(begin + i*rangeLength, begin, end) );
+        if ( rangeEnd < rangeBegin )
+            rangeEnd = rangeBegin;
+        ranges.push_back( ScanRange(rangeBegin, rangeEnd) );
+        rangeBegin = rangeEnd;
+    }
+
+    // -------------------------------------
+    // scan ranges (one thread per range)
+    // -------------------------------------
+
+    vector<pthread_t> threads(numRanges);
+    vector<bool> isThreadStarted(numRanges, false);
+    for ( size_t i = 1; i < numRanges; ++i )
+        isThreadStarted[i] = ( pthread_create(&threads[i], 0, scanRange, &ranges[i]) == 0 );
+
+    // calling thread handles the first range, plus any that failed to start
+    scanRange(&ranges[0]);
+    for ( size_t i = 1; i < numRanges; ++i ) {
+        if ( isThreadStarted[i] )
+            pthread_join(threads[i], 0);
+        else
+            scanRange(&ranges[i]);
+    }
+
+    // -----------------------------------
+    // merge per-range read length counts
+    // -----------------------------------
+
+    readLengthCounts->clear();
+    for ( size_t i = 0; i < numRanges; ++i ) {
+
+        const ScanRange& range = ranges.at(i);
+        if ( !range.IsOk ) {
+            stringstream s("");
+            s << "could not scan input FASTQ file: " << m_filename << endl
+              << "\tat byte offset " << (range.ErrorPosition - begin) << ", because: " << range.ErrorString;
+            m_errorString = s.str();
+            return false;
+        }
+
+        if ( range.ReadLengthCounts.size() > readLengthCounts->size() )
+            readLengthCounts->resize(range.ReadLengthCounts.size(), 0);
+        for ( size_t length = 0; length < range.ReadLengthCounts.size(); ++length )
+            (*readLengthCounts)[length] += range.ReadLengthCounts[length];
+    }
+
+    // return success
+    return true;
+}
@@ -0,0 +1,46 @@
+// ***************************************************************************
+// fastqscanner.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Multi-threaded, whole-file read length scanner (uncompressed FASTQ only)
+// ***************************************************************************
+
+#ifndef FASTQSCANNER_H
+#define FASTQSCANNER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class FastqScanner {
+
+    // ctor & dtor
+    public:
+        FastqScanner(void);
+        ~FastqScanner(void);
+
+    // FastqScanner interface
+    public:
+        void close(void);
+        std::string errorString(void) const;
+        std::string filename(void) const;
+        bool isOpen(void) const;
+        bool open(const std::string& filename);
+
+        // counts the read length of every entry in the file, splitting the work across
+        // numThreads byte ranges. On success, readLengthCounts[length] holds the number
+        // of reads found with that length.
+        bool scan(const unsigned int numThreads, std::vector<uint64_t>* readLengthCounts);
+
+    // data members
+    private:
+        const char* m_data;
+        size_t m_dataLength;
+
+        std::string m_filename;
+        std::string m_errorString;
+};
+
+#endif // FASTQSCANNER_H
@@ -0,0 +1,172 @@
+// ***************************************************************************
+// linesocket.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Newline-delimited messages over a Unix domain socket
+// ***************************************************************************
+
+#include "linesocket.h"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+using namespace std;
+
+// don't let a vanished peer kill the process with SIGPIPE
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+
+static const size_t READ_BLOCK_SIZE = 4096;
+
+bool makeSocketAddress(const string& socketFilename, struct sockaddr_un* address) {
+
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+
+    // sun_path must be null-terminated
+    if ( socketFilename.empty() || socketFilename.length() >= sizeof(address->sun_path) )
+        return false;
+
+    strncpy(address->sun_path, socketFilename.c_str(), sizeof(address->sun_path) - 1);
+    return true;
+}
+
+// ---------------------------
+// LineSocket implementation
+// ---------------------------
+
+LineSocket::LineSocket(const int descriptor)
+    : m_descriptor(descriptor)
+{ }
+
+LineSocket::~LineSocket(void) {
+    close();
+}
+
+void LineSocket::close(void) {
+    if ( m_descriptor >= 0 ) {
+        ::close(m_descriptor);
+        m_descriptor = -1;
+    }
+    m_buffer.clear();
+}
+
+bool LineSocket::connect(const string& socketFilename) {
+
+    // ensure clean slate
+    close();
+
+    struct sockaddr_un address;
+    if ( !makeSocketAddress(socketFilename, &address) ) {
+        m_errorString = "invalid socket filename: ";
+        m_errorString.append(socketFilename);
+        return false;
+    }
+
+    m_descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( m_descriptor < 0 ) {
+        m_errorString = "could not create socket: ";
+        m_errorString.append(strerror(errno));
+        return false;
+    }
+
+    if ( ::connect(m_descriptor, (struct sockaddr*)&address, sizeof(address)) != 0 ) {
+        m_errorString = "could not connect to socket: ";
+        m_errorString.append(socketFilename);
+        m_errorString.append(" - ");
+        m_errorString.append(strerror(errno));
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+int LineSocket::descriptor(void) const {
+    return m_descriptor;
+}
+
+string LineSocket::errorString(void) const {
+    return m_errorString;
+}
+
+bool LineSocket::isOpen(void) const {
+    return ( m_descriptor >= 0 );
+}
+
+bool LineSocket::readLine(string* line) {
+
+    m_errorString.clear();
+    if ( !isOpen() ) {
+        m_errorString = "cannot read from unopened socket";
+        return false;
+    }
+
+    char block[READ_BLOCK_SIZE];
+    while ( true ) {
+
+        // return next complete line, if buffered
+        const size_t newlinePos = m_buffer.find('\n');
+        if ( newlinePos != string::npos ) {
+            line->assign(m_buffer, 0, newlinePos);
+            m_buffer.erase(0, newlinePos + 1);
+            return true;
+        }
+
+        // otherwise read more data
+        const ssize_t numBytesRead = recv(m_descriptor, block, READ_BLOCK_SIZE, 0);
+        if ( numBytesRead < 0 && errno == EINTR )
+            continue;
+        if ( numBytesRead < 0 ) {
+            m_errorString = "could not read from socket: ";
+            m_errorString.append(strerror(errno));
+            return false;
+        }
+        if ( numBytesRead == 0 ) {
+            // N.B. - a partial (unterminated) last line is dropped
+            m_buffer.clear();
+            return false;
+        }
+        m_buffer.append(block, numBytesRead);
+    }
+}
+
+bool LineSocket::writeLine(const string& line) {
+
+    m_errorString.clear();
+    if ( !isOpen() ) {
+        m_errorString = "cannot write to unopened socket";
+        return false;
+    }
+
+    string data = line;
+    if ( data.empty() || data[data.length() - 1] != '\n' )
+        data.append(1, '\n');
+
+    size_t numBytesWritten = 0;
+    while ( numBytesWritten < data.length() ) {
+        const ssize_t result = send(m_descriptor,
+                                    data.data() + numBytesWritten,
+                                    data.length() - numBytesWritten,
+                                    SEND_FLAGS);
+        if ( result < 0 && errno == EINTR )
+            continue;
+        if ( result < 0 ) {
+            m_errorString = "could not write to socket: ";
+            m_errorString.append(strerror(errno));
+            return false;
+        }
+        numBytesWritten += result;
+    }
+
+    return true;
+}
@@ -0,0 +1,43 @@
+// ***************************************************************************
+// linesocket.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Newline-delimited messages over a Unix domain socket
+// ***************************************************************************
+
+#ifndef LINESOCKET_H
+#define LINESOCKET_H
+
+#include <string>
+
+class LineSocket {
+
+    // ctor & dtor
+    public:
+        LineSocket(const int descriptor = -1); // takes ownership of descriptor
+        ~LineSocket(void);
+
+    // LineSocket interface
+    public:
+        void close(void);
+        bool connect(const std::string& socketFilename);
+        int descriptor(void) const;
+        std::string errorString(void) const;
+        bool isOpen(void) const;
+        bool readLine(std::string* line);        // returns false on EOF or error (errorString() empty on EOF)
+        bool writeLine(const std::string& line); // appends newline, if missing
+
+    // data members
+    private:
+        int m_descriptor;
+        std::string m_buffer;
+        std::string m_errorString;
+};
+
+// fills in a sockaddr_un for socketFilename, returns false if name is too long
+struct sockaddr_un;
+bool makeSocketAddress(const std::string& socketFilename, struct sockaddr_un* address);
+
+#endif // LINESOCKET_H
@@ -2,15 +2,20 @@
 // main.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 3 June 2014 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Main entry point for the Premo app.
 // ***************************************************************************
 
+#include "client.h"
 #include "options.h"
 #include "premo.h"
 #include "premo_settings.h"
 #include "premo_version.h"
+#include "scheduler.h"
+#include "server.h"
+#include "spool.h"
+#include "telemetry.h"
 #include <iostream>
 #include <string>
 using namespace std;
@@ -27,6 +32,21 @@ void printVersion(void) {
          << endl;
 }
 
+// writes trace file, if requested (also after a failed run), & returns exit code
+static
+int finishRun(const PremoSettings& settings, const int exitCode) {
+
+    if ( settings.HasTraceFilename ) {
+        string errorString;
+        if ( !Trace::write(settings.TraceFilename, &errorString) ) {
+            cerr << "premo ERROR: " << errorString << endl;
+            return 1;
+        }
+    }
+
+    return exitCode;
+}
+
 int main(int argc, char* argv[]) {
 
     // -------------------------------------------------------
@@ -47,7 +67,7 @@ int main(int argc, char* argv[]) {
                              "Note - Mosaik does not support this output file directly, but the "
                              "file can be parsed and used to generate a reasonable Mosaik command "
                              "line");
-    const string usage("-fq1 <file> -out <file> -st <technology> [options]");
+    const string usage("(-fq1 <file> | -ubam <file> | -bam <file>) -out <file> -st <technology> [options]");
     Options::SetProgramInfo(name, description, usage);
 
     // hook up command-line options to our settings structure
@@ -55,32 +75,61 @@ int main(int argc, char* argv[]) {
 
     OptionGroup* IO_Opts = Options::CreateOptionGroup("General & I/O Options");
 
+    const string bam("input aligned, indexed BAM file. Lengths are sampled from regions across all references, without running Mosaik");
     const string annpe("neural network filename (paired-end) - required for paired-end data");
     const string annse("neural network filename (single-end) - required for paired-end data");
-    const string fq1("input FASTQ file (mate 1 or single-end)");
-    const string fq2("input FASTQ file (mate 2) - required for paired-end data");
+    const string fq1("input FASTQ file (mate 1 or single-end). May be gzip- or zstd-compressed, a pipe/FIFO, or '-' for stdin");
+    const string fq2("input FASTQ file (mate 2) - required for paired-end data. May be gzip- or zstd-compressed, a pipe/FIFO, or '-' for stdin");
     const string jump("stub for jump database files  - required for paired-end data");
     const string keep("keep generated files (auto-deleted by default)");
+    const string manifest("job manifest: one library per line, as '<fq1> <fq2> <out>' (or '<fq1> <out>' with -se). "
+                          "Jobs share the other settings, the -tmp directory & a pool of -t workers, "
+                          "which interleave batches from different libraries");
     const string mosaik("/path/to/Mosaik/bin  - required for paired-end data");
     const string out("output file (JSON). Contains generated Mosaik parameters & raw batch results");
+    const string prior("output file (JSON) from an earlier Premo run on this library. Premo stops as soon as new batches "
+                       "confirm its overall medians (within -delta-fl/-delta-rl), instead of converging from scratch");
     const string ref("MosaikBuild-generated reference archive  - required for paired-end data");
+    const string serve("run as a service, accepting jobs (as newline-delimited JSON) on this Unix socket until interrupted. "
+                       "Jobs take their input files from each request & share the other settings, the -tmp directory "
+                       "& up to -t concurrent job slots");
     const string singleEnd("run Premo in single-end data mode. By default, Premo assumes paired-end data.");
+    const string spool("paired-end only: hand each batch to 'premo -worker' processes watching this (shared) directory, "
+                       "instead of running Mosaik locally");
+    const string spoolTimeout("seconds to wait for a -spool worker's batch result before failing (0 for no limit). "
+                              "Jobs whose worker stops renewing its claim are requeued, & runs fail if no worker is running");
+    const string submit("submit this run's input files (& -se, -st, -n) as a job to the server listening on this Unix socket, "
+                        "then write its result to -out. All other settings are the server's");
     const string tmp("scratch directory for any generated files - only used for paired-end data");
+    const string trace("write a timeline of batch stages (Chrome trace format, see chrome://tracing) to this file");
+    const string ubam("input unaligned BAM file, used instead of -fq1/-fq2. For paired-end data, mates are split using the BAM flags");
     const string verbose("verbose output (to stderr)");
+    const string worker("run as a spool worker: align batches published in this directory by '-spool' runs, "
+                        "until interrupted. Uses this process's -mosaik, -ref, -annpe, -annse, -jmp, -p & -tmp");
     const string version("show version information");
 
     const string FN("filename");
     const string DIR("directory");
 
+    Options::AddValueOption("-bam",    FN,  bam,    "", settings.HasAlignedBamFilename, settings.AlignedBamFilename, IO_Opts);
     Options::AddValueOption("-annpe",  FN,  annpe,  "", settings.HasAnnPeFilename,     settings.AnnPeFilename,     IO_Opts);
     Options::AddValueOption("-annse",  FN,  annse,  "", settings.HasAnnSeFilename,     settings.AnnSeFilename,     IO_Opts);
     Options::AddValueOption("-fq1",    FN,  fq1,    "", settings.HasFastqFilename1,    settings.FastqFilename1,    IO_Opts);
     Options::AddValueOption("-fq2",    FN,  fq2,    "", settings.HasFastqFilename2,    settings.FastqFilename2,    IO_Opts);
     Options::AddValueOption("-jmp",    FN,  jump,   "", settings.HasJumpDbStub,        settings.JumpDbStub,        IO_Opts);
+    Options::AddValueOption("-manifest", FN, manifest, "", settings.HasManifestFilename, settings.ManifestFilename, IO_Opts);
     Options::AddValueOption("-mosaik", DIR, mosaik, "", settings.HasMosaikPath,        settings.MosaikPath,        IO_Opts);
     Options::AddValueOption("-out",    FN,  out,    "", settings.HasOutputFilename,    settings.OutputFilename,    IO_Opts);
+    Options::AddValueOption("-prior",  FN,  prior,  "", settings.HasPriorFilename,     settings.PriorFilename,     IO_Opts);
     Options::AddValueOption("-ref",    FN,  ref,    "", settings.HasReferenceFilename, settings.ReferenceFilename, IO_Opts);
+    Options::AddValueOption("-serve",  FN,  serve,  "", settings.HasServeSocketFilename,  settings.ServeSocketFilename,  IO_Opts);
+    Options::AddValueOption("-spool",  DIR, spool,  "", settings.HasSpoolPath,           settings.SpoolPath,            IO_Opts);
+    Options::AddValueOption("-spool-timeout", "int", spoolTimeout, "", settings.HasSpoolTimeout, settings.SpoolTimeout, IO_Opts, Defaults::SpoolTimeout);
+    Options::AddValueOption("-submit", FN,  submit, "", settings.HasSubmitSocketFilename, settings.SubmitSocketFilename, IO_Opts);
     Options::AddValueOption("-tmp",    DIR, tmp,    "", settings.HasScratchPath,       settings.ScratchPath,       IO_Opts, Defaults::ScratchPath);
+    Options::AddValueOption("-trace",  FN,  trace,  "", settings.HasTraceFilename,       settings.TraceFilename,        IO_Opts);
+    Options::AddValueOption("-ubam",   FN,  ubam,   "", settings.HasUnalignedBamFilename, settings.UnalignedBamFilename, IO_Opts);
+    Options::AddValueOption("-worker", DIR, worker, "", settings.HasWorkerSpoolPath,     settings.WorkerSpoolPath,      IO_Opts);
     Options::AddOption("-keep",    keep,      settings.IsKeepGeneratedFiles, IO_Opts);
     Options::AddOption("-se",      singleEnd, settings.IsSingleEndMode,      IO_Opts );
     Options::AddOption("-v",       verbose,   settings.IsVerbose,            IO_Opts);
@@ -90,11 +139,19 @@ int main(int argc, char* argv[]) {
 
     const string dfl("delta fragment length (fraction). Premo can stop when overall median fragment length changes by less than this amount after a new batch result");
     const string drl("delta read length (fraction). Premo can stop when overall median read length changes by less than this amount after a new batch result");
+    const string exact("single-end only: count the exact read length of every entry in the (uncompressed) input, instead of sampling batches");
     const string n("# of pairs to align per batch");
+    const string t("number of threads for Premo's own processing. 0 uses all available processors");
+    const string tune("paired-end only: after convergence, align the final batch with a grid of -hs/-mhp/-act values around "
+                      "the generated set (one at a time, each also on a fraction of the batch to discount start-up cost) "
+                      "& report the fastest/most sensitive trade-offs under 'parameters'");
 
     Options::AddValueOption("-delta-fl", "double", dfl, "", settings.HasDeltaFragmentLength, settings.DeltaFragmentLength, PremoOpts, Defaults::DeltaFragmentLength);
     Options::AddValueOption("-delta-rl", "double", drl, "", settings.HasDeltaReadLength,     settings.DeltaReadLength,     PremoOpts, Defaults::DeltaReadLength);
     Options::AddValueOption("-n",        "int",    n,   "", settings.HasBatchSize,           settings.BatchSize,           PremoOpts, Defaults::BatchSize);
+    Options::AddValueOption("-t",        "int",    t,   "", settings.HasNumThreads,          settings.NumThreads,          PremoOpts, Defaults::NumThreads);
+    Options::AddOption("-exact", exact, settings.IsExactReadLengthScan, PremoOpts);
+    Options::AddOption("-tune",  tune,  settings.IsTuningParameters,    PremoOpts);
 
     OptionGroup* MosaikOpts = Options::CreateOptionGroup("Mosaik Options");
 
@@ -128,6 +185,62 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    // record stage timeline, if requested
+    if ( settings.HasTraceFilename )
+        Trace::enable();
+
+    // -------------------------------------------------------
+    // run manifest jobs, if requested
+    // -------------------------------------------------------
+
+    if ( settings.HasManifestFilename ) {
+
+        Scheduler scheduler(settings);
+        if ( !scheduler.run() ) {
+            cerr << "premo ERROR: " << scheduler.errorString() << endl;
+            return finishRun(settings, 1);
+        }
+        return finishRun(settings, 0);
+    }
+
+    // -------------------------------------------------------
+    // run as (or submit to) a Premo server, if requested
+    // -------------------------------------------------------
+
+    if ( settings.HasServeSocketFilename ) {
+
+        Server server(settings);
+        if ( !server.run() ) {
+            cerr << "premo ERROR: " << server.errorString() << endl;
+            return finishRun(settings, 1);
+        }
+        return finishRun(settings, 0);
+    }
+
+    if ( settings.HasSubmitSocketFilename ) {
+
+        Client client(settings);
+        if ( !client.run() ) {
+            cerr << "premo ERROR: " << client.errorString() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // -------------------------------------------------------
+    // run as a spool worker, if requested
+    // -------------------------------------------------------
+
+    if ( settings.HasWorkerSpoolPath ) {
+
+        SpoolWorker worker(settings);
+        if ( !worker.run() ) {
+            cerr << "premo ERROR: " << worker.errorString() << endl;
+            return finishRun(settings, 1);
+        }
+        return finishRun(settings, 0);
+    }
+
     // -------------------------------------------------------
     // run Premo using settings
     // -------------------------------------------------------
@@ -140,9 +253,9 @@ int main(int argc, char* argv[]) {
 
         // print error & return failure
         cerr << "premo ERROR: " << premo.errorString() << endl;
-        return 1;
+        return finishRun(settings, 1);
     }
 
     // otherwise return success
-    return 0;
+    return finishRun(settings, 0);
 }
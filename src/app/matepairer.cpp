@@ -0,0 +1,143 @@
+// ***************************************************************************
+// matepairer.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Pairs up mates by read name, in any record order
+// ***************************************************************************
+
+#include "matepairer.h"
+
+#include "bamtools/api/BamAlignment.h"
+
+#include <cassert>
+#include <cstring>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+// length of read name, ignoring any "/1" or "/2" mate suffix
+static inline
+size_t baseNameLength(const string& name) {
+    const size_t length = name.length();
+    if ( length > 2 && name[length-2] == '/' && ( name[length-1] == '1' || name[length-1] == '2' ) )
+        return length - 2;
+    return length;
+}
+
+// FNV-1a
+static inline
+uint64_t hashName(const char* name, const size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for ( size_t i = 0; i < length; ++i ) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// ---------------------------
+// MatePairer implementation
+// ---------------------------
+
+MatePairer::MatePairer(const size_t maxPending)
+    : m_mask(0)
+    , m_maxPending(maxPending)
+    , m_numPending(0)
+    , m_numDropped(0)
+{
+    // keep load factor at 0.5 or below, so probe sequences stay short
+    size_t numSlots = 16;
+    while ( numSlots < 2 * m_maxPending )
+        numSlots *= 2;
+    m_slots.resize(numSlots);
+    m_mask = numSlots - 1;
+}
+
+MatePairer::~MatePairer(void) { }
+
+bool MatePairer::add(const BamTools::BamAlignment& alignment, MateInfo* mate) {
+
+    assert(mate);
+
+    const char* name = alignment.Name.data();
+    const size_t nameLength = baseNameLength(alignment.Name);
+    const uint64_t hash = hashName(name, nameLength);
+
+    // partner already seen - hand it back & free its slot
+    const size_t slot = findSlot(hash, name, nameLength);
+    Slot& s = m_slots[slot];
+    if ( s.IsUsed ) {
+        *mate = s.Info;
+        removeSlot(slot);
+        --m_numPending;
+        return true;
+    }
+
+    // otherwise hold this mate, if there's room
+    if ( m_numPending >= m_maxPending ) {
+        ++m_numDropped;
+        return false;
+    }
+
+    s.IsUsed = true;
+    s.Hash   = hash;
+    s.Name.assign(name, nameLength);
+    s.Info.Length     = alignment.Length;
+    s.Info.RefID      = alignment.RefID;
+    s.Info.InsertSize = alignment.InsertSize;
+    s.Info.IsMapped   = alignment.IsMapped();
+    ++m_numPending;
+    return false;
+}
+
+// returns slot holding name, or the empty slot where it would go
+size_t MatePairer::findSlot(const uint64_t hash, const char* name, const size_t nameLength) const {
+    size_t slot = hash & m_mask;
+    while ( true ) {
+        const Slot& s = m_slots[slot];
+        if ( !s.IsUsed )
+            return slot;
+        if ( s.Hash == hash &&
+             s.Name.length() == nameLength &&
+             memcmp(s.Name.data(), name, nameLength) == 0 )
+        {
+            return slot;
+        }
+        slot = (slot + 1) & m_mask;
+    }
+}
+
+uint64_t MatePairer::numUnpaired(void) const {
+    return m_numPending + m_numDropped;
+}
+
+// linear probing deletion - shifts later entries of the probe run back, instead of leaving tombstones
+void MatePairer::removeSlot(size_t slot) {
+
+    size_t next = slot;
+    while ( true ) {
+        next = (next + 1) & m_mask;
+        Slot& n = m_slots[next];
+        if ( !n.IsUsed )
+            break;
+
+        // entry can move into the hole only if its home slot is not within (slot, next]
+        const size_t home = n.Hash & m_mask;
+        const bool isHomeInRange = ( slot <= next ? ( slot < home && home <= next )
+                                                  : ( slot < home || home <= next ) );
+        if ( isHomeInRange )
+            continue;
+
+        Slot& hole = m_slots[slot];
+        hole.Hash = n.Hash;
+        hole.Name.swap(n.Name);
+        hole.Info = n.Info;
+        slot = next;
+    }
+
+    m_slots[slot].IsUsed = false;
+}
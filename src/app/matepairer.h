@@ -0,0 +1,82 @@
+// ***************************************************************************
+// matepairer.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Pairs up mates by read name, in any record order
+// ***************************************************************************
+
+#ifndef MATEPAIRER_H
+#define MATEPAIRER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace BamTools {
+    struct BamAlignment;
+} // namespace BamTools
+
+// core fields of a mate, enough for read & fragment lengths
+struct MateInfo {
+
+    // data members
+    int32_t Length;
+    int32_t RefID;
+    int32_t InsertSize;
+    bool IsMapped;
+
+    // ctor
+    MateInfo(void)
+        : Length(0)
+        , RefID(-1)
+        , InsertSize(0)
+        , IsMapped(false)
+    { }
+};
+
+// holds each mate until its partner (same read name) shows up, in an open-addressing hash table
+// with a fixed capacity - mates that don't fit are dropped (& counted) rather than growing the table
+// N.B. - expects primary records only, with read names populated (see BamAlignment::BuildName())
+class MatePairer {
+
+    // ctor & dtor
+    public:
+        MatePairer(const size_t maxPending);
+        ~MatePairer(void);
+
+    // MatePairer interface
+    public:
+        // returns true if alignment completes a pair (& sets its partner), otherwise holds it as pending
+        bool add(const BamTools::BamAlignment& alignment, MateInfo* mate);
+
+        // mates without a partner so far: still pending, plus any dropped for lack of space
+        uint64_t numUnpaired(void) const;
+
+    // internal methods
+    private:
+        size_t findSlot(const uint64_t hash, const char* name, const size_t nameLength) const;
+        void removeSlot(size_t slot);
+
+    // embedded types
+    private:
+        struct Slot {
+            bool IsUsed;
+            uint64_t Hash;
+            std::string Name;
+            MateInfo Info;
+
+            Slot(void) : IsUsed(false), Hash(0) { }
+        };
+
+    // data members
+    private:
+        std::vector<Slot> m_slots;   // power-of-2 size, at most half full
+        size_t m_mask;
+        size_t m_maxPending;
+        size_t m_numPending;
+        uint64_t m_numDropped;
+};
+
+#endif // MATEPAIRER_H
@@ -2,7 +2,7 @@
 // pebatch.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 3 June 2014 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Paired-end batch
 // ***************************************************************************
@@ -12,8 +12,12 @@
 #include "fastq.h"
 #include "fastqreader.h"
 #include "fastqwriter.h"
+#include "matepairer.h"
 #include "premo_settings.h"
+#include "premo_utils.h"
+#include "spool.h"
 #include "stats.h"
+#include "ubamreader.h"
 
 #include "bamtools/api/BamReader.h"
 
@@ -32,8 +36,11 @@ using namespace std;
 // utility methods
 // -------------------------
 
+// secondary & supplementary records would count a read more than once
+static const uint32_t NON_PRIMARY_FLAGS = 0x100 | 0x800;
+
 static inline
-int32_t calculateFragmentLength(const BamTools::BamAlignment& mate1,
+int32_t calculateFragmentLength(const MateInfo& mate1,
                                 const BamTools::BamAlignment& mate2)
 {
     assert( abs(mate1.InsertSize) == abs(mate2.InsertSize) );
@@ -51,24 +58,92 @@ PairedEndBatch::PairedEndBatch(const int batchNumber,
     : Batch(settings)
     , m_reader1(reader1)
     , m_reader2(reader2)
+    , m_bamReader(0)
+    , m_ownsFastqFiles(true)
+    , m_runner(0)
+{
+    initializeFilenames(batchNumber);
+}
+
+PairedEndBatch::PairedEndBatch(const int batchNumber,
+                               UnalignedBamReader* reader,
+                               PremoSettings* settings)
+    : Batch(settings)
+    , m_reader1(0)
+    , m_reader2(0)
+    , m_bamReader(reader)
+    , m_ownsFastqFiles(true)
+    , m_runner(0)
+{
+    initializeFilenames(batchNumber);
+}
+
+PairedEndBatch::PairedEndBatch(const string& fastq1,
+                               const string& fastq2,
+                               PremoSettings* settings)
+    : Batch(settings)
+    , m_reader1(0)
+    , m_reader2(0)
+    , m_bamReader(0)
+    , m_ownsFastqFiles(false)
+    , m_runner(0)
 {
+    initializeFilenames(0);
+    m_generatedFastq1 = fastq1;
+    m_generatedFastq2 = fastq2;
+}
+
+PairedEndBatch::~PairedEndBatch(void) {
+
+    // auto-delete any generated files (unless requested otherwise)
+    if ( !m_settings->IsKeepGeneratedFiles ) {
+        if ( m_ownsFastqFiles ) {
+            remove(m_generatedFastq1.c_str());
+            remove(m_generatedFastq2.c_str());
+        }
+        remove(m_generatedReadArchive.c_str());
+        remove(m_generatedBam.c_str());
+        remove(m_generatedMosaikLog.c_str());
+        remove(m_generatedMultipleBam.c_str());
+        remove(m_generatedSpecialBam.c_str());
+        remove(m_generatedStatFile.c_str());
+    }
+
+    // spool files are never kept (an unclaimed job must not outlive its FASTQs)
+    if ( m_settings->HasSpoolPath )
+        removeSpoolJob(m_spoolStem);
+}
+
+void PairedEndBatch::initializeFilenames(const int batchNumber) {
+
     // ----------------------------
     // set up generated filenames
     // ----------------------------
 
-    const string prefix("premo_batch");
+    const string& prefix = m_settings->BatchFilePrefix;
 
     stringstream s;
 
-    // mate1 FASTQ
-    s.str("");
-    s << m_settings->ScratchPath << prefix << batchNumber << "_mate1.fq";
-    m_generatedFastq1 = s.str();
+    // spooled batches need FASTQs & job files where workers can see them
+    if ( m_settings->HasSpoolPath ) {
 
-    // mate2 FASTQ
-    s.str("");
-    s << m_settings->ScratchPath << prefix << batchNumber << "_mate2.fq";
-    m_generatedFastq2 = s.str();
+        m_spoolStem = m_settings->SpoolPath + spoolStem(prefix, batchNumber);
+        m_generatedFastq1 = m_spoolStem + "_mate1.fq";
+        m_generatedFastq2 = m_spoolStem + "_mate2.fq";
+    }
+
+    else {
+
+        // mate1 FASTQ
+        s.str("");
+        s << m_settings->ScratchPath << prefix << batchNumber << "_mate1.fq";
+        m_generatedFastq1 = s.str();
+
+        // mate2 FASTQ
+        s.str("");
+        s << m_settings->ScratchPath << prefix << batchNumber << "_mate2.fq";
+        m_generatedFastq2 = s.str();
+    }
 
     // Mosaik read archive
     s.str("");
@@ -96,23 +171,11 @@ PairedEndBatch::PairedEndBatch(const int batchNumber,
     m_generatedStatFile.append(".stat");
 }
 
-PairedEndBatch::~PairedEndBatch(void) {
-
-    // auto-delete any generated files (unless requested otherwise)
-    if ( !m_settings->IsKeepGeneratedFiles ) {
-        remove(m_generatedFastq1.c_str());
-        remove(m_generatedFastq2.c_str());
-        remove(m_generatedReadArchive.c_str());
-        remove(m_generatedBam.c_str());
-        remove(m_generatedMosaikLog.c_str());
-        remove(m_generatedMultipleBam.c_str());
-        remove(m_generatedSpecialBam.c_str());
-        remove(m_generatedStatFile.c_str());
-    }
-}
-
 Batch::RunStatus PairedEndBatch::generateTempFastqFiles(void) {
 
+    StageTimer timer(&m_timings, "FASTQ extraction");
+    m_timings.BytesIn = 0;
+
     // ------------------------------
     // open temp FASTQ output files
     // ------------------------------
@@ -156,13 +219,22 @@ Batch::RunStatus PairedEndBatch::generateTempFastqFiles(void) {
     // iterate over requested number of entries
     for ( size_t i = 0; i < m_settings->BatchSize; ++i ) {
 
-        // attempt to read from FASTQ
-        const bool read1Ok = m_reader1->readNext(&f1);
-        const bool read2Ok = m_reader2->readNext(&f2);
+        // attempt to read from input (uBAM input provides both mates at once)
+        bool read1Ok;
+        bool read2Ok;
+        if ( m_bamReader )
+            read1Ok = read2Ok = m_bamReader->readNextPair(&f1, &f2);
+        else {
+            read1Ok = m_reader1->readNext(&f1);
+            read2Ok = m_reader2->readNext(&f2);
+        }
 
         // if both read OK
         if ( read1Ok && read2Ok ) {
 
+            m_timings.NumReads += 2;
+            m_timings.BytesIn  += f1.textLength() + f2.textLength();
+
             // attempt to write to FASTQ
             const bool write1Ok = writer1.write(&f1);
             const bool write2Ok = writer2.write(&f2);
@@ -190,7 +262,23 @@ Batch::RunStatus PairedEndBatch::generateTempFastqFiles(void) {
             }
         }
 
-        // handle read errors
+        // handle uBAM read errors
+        else if ( m_bamReader ) {
+
+            // handle EOF or empty file
+            if ( m_bamReader->isEOF() )
+                return ( (i != 0) ? Batch::HitEOF : Batch::NoData );
+
+            // for any other errors, build error string
+            stringstream s("");
+            s << "could not read from input BAM file: " << endl
+              << m_bamReader->filename() << endl
+              << "\tbecause: " << m_bamReader->errorString();
+            m_errorString = s.str();
+            return Batch::Error;
+        }
+
+        // handle FASTQ read errors
         else {
 
             // handle EOF or empty file
@@ -231,6 +319,8 @@ Batch::RunStatus PairedEndBatch::generateTempFastqFiles(void) {
 
 Batch::RunStatus PairedEndBatch::parseAlignmentFile(void) {
 
+    StageTimer timer(&m_timings, "BAM parsing");
+
     // open reader on new BAM alignment file
     BamTools::BamReader reader;
     if ( !reader.Open(m_generatedBam) ) {
@@ -244,30 +334,42 @@ Batch::RunStatus PairedEndBatch::parseAlignmentFile(void) {
     m_result.ReadLengths.reserve(2 * m_settings->BatchSize);
     m_result.FragmentLengths.reserve(m_settings->BatchSize);
 
-    // plow through alignments
-    BamTools::BamAlignment mate1;
-    BamTools::BamAlignment mate2;
-    while ( reader.GetNextAlignmentCore(mate1) ) {
-
-        // store mate1 read length, regardless of aligned state
-        m_result.ReadLengths.push_back(mate1.Length);
-
-        // read mate2
-        if ( reader.GetNextAlignmentCore(mate2) ) {
-
-            // store mate2 read length, regardless of aligned state
-            m_result.ReadLengths.push_back(mate2.Length);
+    // plow through alignments, pairing mates by read name
+    // (so aligner output need not keep mates adjacent, or in any particular order)
+    MatePairer pairer(m_settings->BatchSize);
+    BamTools::BamAlignment alignment;
+    MateInfo mate;
+    while ( reader.GetNextAlignmentCore(alignment) ) {
+
+        if ( (alignment.AlignmentFlag & NON_PRIMARY_FLAGS) != 0 )
+            continue;
+
+        // store read length, regardless of aligned state
+        m_result.ReadLengths.push_back(alignment.Length);
+
+        // mates are paired by name, so it must be available
+        if ( !alignment.BuildName() ) {
+            m_errorString = "could not read alignment name from generated BAM file: ";
+            m_errorString.append(m_generatedBam);
+            m_errorString.append("\n");
+            m_errorString.append(alignment.GetErrorString());
+            return Batch::Error;
+        }
 
-            // if both mates mapped to same reference
-            if ( mate1.IsMapped() &&
-                 mate2.IsMapped() &&
-                 (mate1.RefID == mate2.RefID) )
-            {
-                // calculate & store fragment length
-                m_result.FragmentLengths.push_back( calculateFragmentLength(mate1, mate2) );
-            }
+        // if both mates mapped to same reference
+        if ( pairer.add(alignment, &mate) &&
+             mate.IsMapped &&
+             alignment.IsMapped() &&
+             (mate.RefID == alignment.RefID) )
+        {
+            // calculate & store fragment length
+            m_result.FragmentLengths.push_back( calculateFragmentLength(mate, alignment) );
         }
     }
+    m_result.NumUnpairedMates = pairer.numUnpaired();
+    if ( m_result.NumUnpairedMates != 0 && m_settings->IsVerbose )
+        cerr << "batch BAM " << m_generatedBam << " has " << m_result.NumUnpairedMates
+             << " mate(s) without a partner" << endl;
     reader.Close();
 
     // remove extreme outliers
@@ -278,27 +380,52 @@ Batch::RunStatus PairedEndBatch::parseAlignmentFile(void) {
     return Batch::Normal;
 }
 
+void PairedEndBatch::fastqFiles(string* fastq1, string* fastq2) const {
+    assert(fastq1 && fastq2);
+    *fastq1 = m_generatedFastq1;
+    *fastq2 = m_generatedFastq2;
+}
+
+void PairedEndBatch::releaseFastqFiles(string* fastq1, string* fastq2) {
+    assert(fastq1 && fastq2);
+    *fastq1 = m_generatedFastq1;
+    *fastq2 = m_generatedFastq2;
+    m_ownsFastqFiles = false;
+}
+
 Batch::RunStatus PairedEndBatch::run(void) {
 
     Batch::RunStatus status;
 
-    // generate temp files
-    status = generateTempFastqFiles();
-    if ( (status != Batch::Normal) && (status != Batch::HitEOF) ) // EOF on FASTQ is ok, we still have data to align
-        return status;
+    // generate temp files (unless aligning an existing FASTQ pair)
+    if ( m_reader1 != 0 || m_bamReader != 0 ) {
+        status = generateTempFastqFiles();
+        if ( (status != Batch::Normal) && (status != Batch::HitEOF) ) // EOF on FASTQ is ok, we still have data to align
+            return status;
+    }
 
-    // run mosaik
-    status = runMosaikPipeline();
-    if ( status != Batch::Normal )
-        return status;
+    // hand off to a spool worker, if requested
+    if ( m_settings->HasSpoolPath )
+        status = runSpooled();
 
-    // parse BAM for counts & return final status
-    status = parseAlignmentFile();
+    // otherwise, run mosaik & parse BAM for counts
+    else {
+        status = runMosaikPipeline();
+        if ( status == Batch::Normal )
+            status = parseAlignmentFile();
+    }
+
+    // record size of generated files & return final status
+    if ( m_ownsFastqFiles )
+        m_timings.BytesOut += fileSize(m_generatedFastq1) + fileSize(m_generatedFastq2);
+    m_timings.BytesOut += fileSize(m_generatedReadArchive) + fileSize(m_generatedBam);
     return status;
 }
 
 Batch::RunStatus PairedEndBatch::runMosaikAligner(void) {
 
+    StageTimer timer(&m_timings, "MosaikAligner");
+
     // setup MosaikAlign command line
     stringstream commandStream("");
     commandStream << m_settings->MosaikPath << "MosaikAligner"
@@ -326,6 +453,8 @@ Batch::RunStatus PairedEndBatch::runMosaikAligner(void) {
 
 Batch::RunStatus PairedEndBatch::runMosaikBuild(void) {
 
+    StageTimer timer(&m_timings, "MosaikBuild");
+
     // setup MosaikBuild command line
     stringstream commandStream("");
     commandStream << m_settings->MosaikPath << "MosaikBuild"
@@ -355,3 +484,30 @@ Batch::RunStatus PairedEndBatch::runMosaikPipeline(void) {
     status = runMosaikAligner();
     return status;
 }
+
+Batch::RunStatus PairedEndBatch::runSpooled(void) {
+
+    StageTimer timer(&m_timings, "spool worker");
+
+    // publish job
+    SpoolJob job;
+    job.Fastq1   = m_generatedFastq1;
+    job.Fastq2   = m_generatedFastq2;
+    job.NumPairs = m_timings.NumReads / 2;
+    job.SeqTech  = m_settings->SeqTech;
+    job.HashSize = m_settings->HashSize;
+    job.Mhp      = m_settings->Mhp;
+    job.Mmp      = m_settings->Mmp;
+
+    if ( m_settings->IsVerbose )
+        cerr << "waiting for a spool worker to align: " << m_spoolStem << endl;
+
+    // publish job & wait for a worker's result (job's spool files are removed either way)
+    if ( !runSpoolJob(m_spoolStem, job, m_settings->SpoolTimeout, m_runner, &m_result, &m_errorString) )
+        return Batch::Error;
+    return Batch::Normal;
+}
+
+void PairedEndBatch::setRunner(const Premo* runner) {
+    m_runner = runner;
+}
@@ -2,7 +2,7 @@
 // pebatch.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Paired-end batch
 // ***************************************************************************
@@ -13,6 +13,8 @@
 #include "batch.h"
 #include <vector>
 class FastqReader;
+class Premo;
+class UnalignedBamReader;
 
 class PairedEndBatch : public Batch {
 
@@ -22,26 +24,48 @@ class PairedEndBatch : public Batch {
                        FastqReader* reader1,
                        FastqReader* reader2,
                        PremoSettings* settings);
+        PairedEndBatch(const int batchNumber,
+                       UnalignedBamReader* reader,
+                       PremoSettings* settings);
+        // aligns an existing FASTQ pair (spool worker), files are not removed
+        PairedEndBatch(const std::string& fastq1,
+                       const std::string& fastq2,
+                       PremoSettings* settings);
         ~PairedEndBatch(void);
 
     // Batch interface
     public:
         Batch::RunStatus run(void);
 
+    // PairedEndBatch interface
+    public:
+        // generated (or existing) FASTQ pair, still owned by batch
+        void fastqFiles(std::string* fastq1, std::string* fastq2) const;
+        // hands generated FASTQ pair over to caller, which becomes responsible for removing it
+        void releaseFastqFiles(std::string* fastq1, std::string* fastq2);
+        // runner whose cancellation stops a wait for a spool worker (not owned, may be 0)
+        void setRunner(const Premo* runner);
+
     // internal methods
     private:
         RunStatus generateTempFastqFiles(void);
+        void initializeFilenames(const int batchNumber);
         RunStatus parseAlignmentFile(void);
         RunStatus runMosaikAligner(void);
         RunStatus runMosaikBuild(void);
         RunStatus runMosaikPipeline(void);
+        RunStatus runSpooled(void);
 
     // data members
     private:
 
         // copies from main Premo app, not owned
+        // (either both FASTQ readers, or the uBAM reader, are used)
         FastqReader* m_reader1;
         FastqReader* m_reader2;
+        UnalignedBamReader* m_bamReader;
+        bool m_ownsFastqFiles;
+        const Premo* m_runner;
 
         // store all possible generated filenames, for proper cleanup
         std::string m_generatedFastq1;
@@ -53,6 +77,7 @@ class PairedEndBatch : public Batch {
         std::string m_generatedMultipleBam;
         std::string m_generatedSpecialBam;
         std::string m_generatedStatFile;
+        std::string m_spoolStem;
 };
 
 #endif // PEBATCH_H
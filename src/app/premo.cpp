@@ -2,29 +2,35 @@
 // premo.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 9 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Main Premo workhorse
 // ***************************************************************************
 
 #include "premo.h"
 
+#include "bambatch.h"
 #include "batch.h"
-#include "options.h"
+#include "fastq.h"
+#include "fastqscanner.h"
+#include "fastqwriter.h"
 #include "pebatch.h"
+#include "premo_utils.h"
 #include "sebatch.h"
+#include "spool.h"
 #include "stats.h"
+#include "telemetry.h"
+#include "tuner.h"
 
+#include "bamtools/api/BamReader.h"
+#include "jsoncpp/json_reader.h"
 #include "jsoncpp/json_value.h"
 #include "jsoncpp/json_writer.h"
 
-#include <dirent.h>
-#include <sys/stat.h>
-#include <sys/types.h>
-#include <unistd.h>
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
@@ -38,10 +44,10 @@ using namespace std;
 // ------------------------
 
 static
-Json::Value containerStats(const vector<int>& container) {
+LengthSummary containerSummary(const vector<int>& container) {
 
-    Json::Value result(Json::objectValue);
-    result["count"] = static_cast<Json::UInt>(container.size());
+    LengthSummary summary;
+    summary.Count = container.size();
 
     if ( !container.empty() ) {
 
@@ -49,25 +55,74 @@ Json::Value containerStats(const vector<int>& container) {
         sort(c.begin(), c.end());
 
         const Quartiles quartiles = calculateQuartiles(c);
-        result["median"] = quartiles.Q2;
-        result["Q1"] = quartiles.Q1;
-        result["Q3"] = quartiles.Q3;
+        summary.Median = quartiles.Q2;
+        summary.Q1 = quartiles.Q1;
+        summary.Q3 = quartiles.Q3;
     }
 
-    return result;
+    return summary;
+}
+
+static
+LengthSummary histogramSummary(const vector<uint64_t>& histogram) {
+
+    LengthSummary summary;
+    summary.Count = histogramCount(histogram);
+
+    if ( summary.Count != 0 ) {
+        const Quartiles quartiles = calculateHistogramQuartiles(histogram);
+        summary.Median = quartiles.Q2;
+        summary.Q1 = quartiles.Q1;
+        summary.Q3 = quartiles.Q3;
+    }
+
+    return summary;
+}
+
+static
+BatchSummary resultSummary(const Result& result, const bool isSingleEndMode) {
+
+    BatchSummary summary;
+
+    // fragment length results only available in PE mode
+    if ( !isSingleEndMode ) {
+        summary.FragmentLength = containerSummary(result.FragmentLengths);
+        summary.NumUnpairedMates = result.NumUnpairedMates;
+    }
+
+    // always include read length results
+    summary.ReadLength = containerSummary(result.ReadLengths);
+
+    return summary;
 }
 
 static
-Json::Value resultToJson(const Result& result, const bool isSingleEndMode) {
+Json::Value summaryToJson(const LengthSummary& summary) {
+
+    Json::Value json(Json::objectValue);
+    json["count"] = static_cast<double>(summary.Count);   // may exceed 32 bits (-exact)
+
+    if ( summary.Count != 0 ) {
+        json["median"] = summary.Median;
+        json["Q1"] = summary.Q1;
+        json["Q3"] = summary.Q3;
+    }
+
+    return json;
+}
+
+Json::Value summaryToJson(const BatchSummary& summary, const bool isSingleEndMode) {
 
     Json::Value json(Json::objectValue);
 
     // include fragment length results if PE mode
-    if ( !isSingleEndMode )
-        json["fragment length"] = containerStats(result.FragmentLengths);
+    if ( !isSingleEndMode ) {
+        json["fragment length"] = summaryToJson(summary.FragmentLength);
+        json["unpaired mates"]  = static_cast<double>(summary.NumUnpairedMates);
+    }
 
     // always include read length results
-    json["read length"] = containerStats(result.ReadLengths);
+    json["read length"] = summaryToJson(summary.ReadLength);
 
     return json;
 }
@@ -97,6 +152,40 @@ bool isConverged(const vector<int>& previous,
     return ( observedDelta <= cutoffDelta );
 }
 
+// checks current values' median against an earlier run's median
+static
+bool isConfirmed(const double priorMedian,
+                 const vector<int>& current,
+                 const double cutoffDelta)
+{
+    if ( current.empty() || priorMedian <= 0.0 )
+        return false;
+
+    // sort (a copy of) input container (req'd for median calculation)
+    vector<int> currentValues = current;
+    sort(currentValues.begin(), currentValues.end());
+
+    // check delta (ratio) from prior median
+    const double currentMedian = calculateMedian(currentValues);
+    return ( fabs(currentMedian - priorMedian) / priorMedian <= cutoffDelta );
+}
+
+static
+bool checkPriorConfirmed(const BatchSummary& prior,
+                         const Result& currentResult,
+                         const PremoSettings& settings)
+{
+    // read length always checked, fragment length in PE mode only
+    const bool isReadLengthConfirmed = isConfirmed(prior.ReadLength.Median,
+                                                   currentResult.ReadLengths,
+                                                   settings.DeltaReadLength);
+    if ( settings.IsSingleEndMode )
+        return isReadLengthConfirmed;
+    return isReadLengthConfirmed && isConfirmed(prior.FragmentLength.Median,
+                                                currentResult.FragmentLengths,
+                                                settings.DeltaFragmentLength);
+}
+
 static
 bool checkFinished(const Result& previousResult,
                    const Result& currentResult,
@@ -124,81 +213,225 @@ bool checkFinished(const Result& previousResult,
     }
 }
 
-template<typename T>
-void append(std::vector<T>& dest, const std::vector<T>& source) {
-    dest.insert(dest.end(), source.begin(), source.end());
+static
+Json::Value alignerParametersToJson(const MosaikParameters& parameters, const bool isSingleEndMode) {
+
+    Json::Value json(Json::objectValue);
+    json["-act"] = parameters.Act;
+    json["-bw"]  = parameters.Bandwidth;
+    json["-hs"]  = parameters.HashSize;
+    json["-mhp"] = parameters.Mhp;
+    json["-mmp"] = parameters.Mmp;
+    if ( !isSingleEndMode )
+        json["-ls"] = parameters.LocalSearchRadius;
+    return json;
 }
 
-static inline
-bool endsWith(const string& str, const string& query) {
-    return ( str.find_last_of(query) == (str.length() - query.length()) );
+static
+Json::Value tuningCandidateToJson(const TuningCandidate& candidate) {
+
+    Json::Value json(Json::objectValue);
+    json["MosaikAligner"]    = alignerParametersToJson(candidate.Parameters, false);
+    json["aligner seconds"]  = candidate.AlignerSeconds;
+    json["startup seconds"]  = candidate.StartupSeconds;
+    json["pairs"]            = static_cast<double>(candidate.NumPairs);
+    json["pairs per second"] = candidate.pairsPerSecond();
+    json["fraction mapped"]  = candidate.fractionMapped();
+    return json;
 }
 
+// fastest first
 static
-bool dirExists(const char* directory) {
+bool isFasterCandidate(const TuningCandidate& lhs, const TuningCandidate& rhs) {
+    return lhs.pairsPerSecond() > rhs.pairsPerSecond();
+}
 
-    // Borrowed from Mosaik source (w/o Windows compatibility)
-    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+// reads a summary, as written by summaryToJson()
+static
+bool lengthSummaryFromJson(const Json::Value& json, LengthSummary* summary) {
 
-    bool foundDirectory = false;
+    if ( !json.isObject() || !json["count"].isNumeric() )
+        return false;
 
-    struct stat st;
-    if ( stat(directory, &st) == 0 ) {
-        DIR* pDirectory = opendir(directory);
-        if ( pDirectory != NULL ) {
-            foundDirectory = true;
-            closedir( pDirectory );
-        }
-    }
+    summary->Count = static_cast<uint64_t>( json["count"].asDouble() );
+    if ( summary->Count == 0 )
+        return true;
 
-    return foundDirectory;
+    if ( !json["median"].isNumeric() || !json["Q1"].isNumeric() || !json["Q3"].isNumeric() )
+        return false;
+    summary->Median = json["median"].asDouble();
+    summary->Q1     = json["Q1"].asDouble();
+    summary->Q3     = json["Q3"].asDouble();
+    return true;
 }
 
 static
-bool createDirectory(const char* directory) {
+Json::Value timingsToJson(const BatchTimings& timings) {
+
+    Json::Value json(Json::objectValue);
+    json["batch"] = timings.BatchNumber;
+    json["wall seconds"] = timings.WallSeconds;
+
+    Json::Value stages(Json::objectValue);
+    vector<StageTiming>::const_iterator stageIter = timings.Stages.begin();
+    vector<StageTiming>::const_iterator stageEnd  = timings.Stages.end();
+    for ( ; stageIter != stageEnd; ++stageIter )
+        stages[stageIter->Name] = stages.get(stageIter->Name, 0.0).asDouble() + stageIter->Seconds;
+    json["stage seconds"] = stages;
+
+    json["reads"] = static_cast<double>(timings.NumReads);
+    if ( timings.WallSeconds > 0.0 )
+        json["reads per second"] = timings.NumReads / timings.WallSeconds;
+    if ( timings.BytesIn >= 0 )
+        json["bytes in"] = static_cast<double>(timings.BytesIn);
+    json["bytes out"] = static_cast<double>(timings.BytesOut);
+
+    json["child user cpu seconds"]   = timings.Usage.ChildUserSeconds;
+    json["child system cpu seconds"] = timings.Usage.ChildSystemSeconds;
+    json["peak rss kb"]              = static_cast<double>(timings.Usage.PeakRssKb);
+    json["child peak rss kb"]        = static_cast<double>(timings.Usage.ChildPeakRssKb);
+    return json;
+}
 
-    // Borrowed from Mosaik source (** w/o Windows compatibility **)
-    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+// calibration run aligns this fraction (1/N) of the first batch's pairs, so that batch sizes differ enough
+// to separate Mosaik's fixed (start-up, reference & jump database loading) & per-read costs
+static const uint64_t CALIBRATION_BATCH_DIVISOR = 4;
 
-    // return success if directory already exists
-    if ( dirExists(directory) )
-        return true;
+// copies the first numPairs entries of a FASTQ pair, adding their text length to numBytes
+static
+bool copyLeadingPairs(const string& sourceFastq1,
+                      const string& sourceFastq2,
+                      const string& fastq1,
+                      const string& fastq2,
+                      const uint64_t numPairs,
+                      int64_t* numBytes)
+{
+    assert(numBytes);
+
+    FastqReader reader1;
+    FastqReader reader2;
+    FastqWriter writer1;
+    FastqWriter writer2;
+    if ( !reader1.open(sourceFastq1) || !reader2.open(sourceFastq2) ||
+         !writer1.open(fastq1)       || !writer2.open(fastq2) )
+    {
+        return false;
+    }
 
-    // otherwise return success/failure of creatin directory
-    return ( mkdir(directory, S_IRWXU | S_IRGRP | S_IXGRP) == 0 );
+    Fastq f1;
+    Fastq f2;
+    for ( uint64_t i = 0; i < numPairs; ++i ) {
+        if ( !reader1.readNext(&f1) || !reader2.readNext(&f2) )
+            return false;
+        if ( !writer1.write(&f1) || !writer2.write(&f2) )
+            return false;
+        *numBytes += f1.textLength() + f2.textLength();
+    }
+    return true;
 }
 
+// least-squares fit of: y = intercept + slope * x
+// N.B. - fails if the x values are too close together to separate the two terms, or if either term is negative
 static
-void removeDirectory(string directory) {
+bool fitLine(const vector<double>& x,
+             const vector<double>& y,
+             double* intercept,
+             double* slope)
+{
+    assert(x.size() == y.size());
+    const size_t n = x.size();
+    if ( n < 2 )
+        return false;
 
-    // Borrowed from Mosaik source (** w/o Windows compatibility **)
-    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+    const double minX = *min_element(x.begin(), x.end());
+    const double maxX = *max_element(x.begin(), x.end());
+    if ( (maxX - minX) < 0.1 * maxX )
+        return false;
 
-    // skip out if directory doesn't exist
-    if( !dirExists( directory.c_str() ) )
-        return;
+    double sumX  = 0.0;
+    double sumY  = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+    for ( size_t i = 0; i < n; ++i ) {
+        sumX  += x.at(i);
+        sumY  += y.at(i);
+        sumXX += x.at(i) * x.at(i);
+        sumXY += x.at(i) * y.at(i);
+    }
 
-    // open directory
-    DIR* pdir = NULL;
-    pdir = opendir( directory.c_str() );
-    if ( pdir == NULL )
-        return;
+    const double denominator = n * sumXX - sumX * sumX;
+    if ( denominator <= 0.0 )
+        return false;
 
-    string file;
-    struct dirent* pent = NULL;
+    *slope     = ( n * sumXY - sumX * sumY ) / denominator;
+    *intercept = ( sumY - (*slope) * sumX ) / n;
+    return ( *slope > 0.0 && *intercept >= 0.0 );
+}
 
-    // iterate over directory contents
-    while ( (pent = readdir(pdir)) != NULL ) {
-        if ( pent == NULL ) return;
+// projects per-batch costs (y) to the full input size, from each batch's input size (x)
+static
+double projectCost(const vector<double>& x,
+                   const vector<double>& y,
+                   const double fullX,
+                   bool* isLinearFit)
+{
+    double intercept = 0.0;
+    double slope = 0.0;
+    *isLinearFit = fitLine(x, y, &intercept, &slope);
+    if ( *isLinearFit )
+        return intercept + slope * fullX;
+
+    // otherwise, scale up observed rate
+    double sumX = 0.0;
+    double sumY = 0.0;
+    for ( size_t i = 0; i < x.size(); ++i ) {
+        sumX += x.at(i);
+        sumY += y.at(i);
+    }
+    return ( sumX > 0.0 ? fullX * (sumY / sumX) : 0.0 );
+}
 
-        // get full path to file & remove it
-        file = directory + pent->d_name;
-        remove(file.c_str());
+static
+double stageSeconds(const BatchTimings& timings, const string& name) {
+    double seconds = 0.0;
+    vector<StageTiming>::const_iterator stageIter = timings.Stages.begin();
+    vector<StageTiming>::const_iterator stageEnd  = timings.Stages.end();
+    for ( ; stageIter != stageEnd; ++stageIter ) {
+        if ( stageIter->Name == name )
+            seconds += stageIter->Seconds;
     }
+    return seconds;
+}
+
+// FASTQ text size of reader's input, estimated from compression ratio if gzipped
+// returns -1.0 if not known
+static
+double inputTextBytes(const FastqReader& reader, bool* isEstimated) {
+
+    if ( !reader.isOpen() || reader.isStream() )
+        return -1.0;
+
+    const double bytes = static_cast<double>( fileSize(reader.filename()) );
+    if ( !reader.isCompressed() )
+        return bytes;
+
+    const int64_t offset = reader.offset();
+    const int64_t compressedOffset = reader.compressedOffset();
+    if ( offset <= 0 || compressedOffset <= 0 )
+        return -1.0;
+
+    *isEstimated = true;
+    return bytes * ( static_cast<double>(offset) / static_cast<double>(compressedOffset) );
+}
+
+template<typename T>
+void append(std::vector<T>& dest, const std::vector<T>& source) {
+    dest.insert(dest.end(), source.begin(), source.end());
+}
 
-    // close the directory & remove it
-    closedir(pdir);
-    rmdir(directory.c_str());
+static inline
+bool endsWith(const string& str, const string& query) {
+    return ( str.find_last_of(query) == (str.length() - query.length()) );
 }
 
 // ----------------------
@@ -208,11 +441,31 @@ void removeDirectory(string directory) {
 Premo::Premo(const PremoSettings& settings)
     : m_settings(settings)
     , m_isFinished(false)
+    , m_isOutputRequired(true)
+    , m_batchNumber(0)
+    , m_observer(0)
+    , m_isCancelled(false)
+    , m_numPriorBatches(0)
+    , m_isPriorConfirmed(false)
+    , m_startTime(wallTime())
     , m_createdScratchDirectory(false)
-{ }
+{
+    pthread_mutex_init(&m_cancelMutex, 0);
+}
 
 Premo::~Premo(void) {
 
+    // remove final batch's FASTQ pair, kept for -tune
+    if ( !m_settings.IsKeepGeneratedFiles && !m_tuningFastq1.empty() ) {
+        remove(m_tuningFastq1.c_str());
+        remove(m_tuningFastq2.c_str());
+    }
+
+    // close any aligned BAM readers
+    for ( size_t i = 0; i < m_alignedBamReaders.size(); ++i )
+        delete m_alignedBamReaders.at(i);
+    m_alignedBamReaders.clear();
+
     // if user doesn't want to keep any generated files &
     // we have a scratch directory we created within this run
     if ( !m_settings.IsKeepGeneratedFiles &&
@@ -222,15 +475,173 @@ Premo::~Premo(void) {
         // remove the generated scratch directory
         removeDirectory(m_settings.ScratchPath);
     }
+
+    pthread_mutex_destroy(&m_cancelMutex);
+}
+
+void Premo::cancel(void) {
+    pthread_mutex_lock(&m_cancelMutex);
+    m_isCancelled = true;
+    pthread_mutex_unlock(&m_cancelMutex);
 }
 
 string Premo::errorString(void) const {
     return m_errorString;
 }
 
+bool Premo::estimate(PremoResult* result) {
+
+    assert(result);
+
+    // no output file for library callers
+    m_isOutputRequired = false;
+
+    // check settings & prepare input
+    if ( !start() )
+        return false;
+
+    // main loop - batch processing
+    while ( !m_isFinished ) {
+        if ( !runBatch() )
+            return false;
+    }
+
+    // return results
+    *result = this->result();
+    return true;
+}
+
+// returns true if full-run costs can be projected from the batch runs
+// (paired-end FASTQ input, with Mosaik run locally)
+bool Premo::isProjectingResources(void) const {
+    return ( !m_settings.IsSingleEndMode &&
+             !m_settings.HasSpoolPath &&
+             m_reader1.isOpen() &&
+             m_reader2.isOpen() );
+}
+
+bool Premo::isCancelled(void) const {
+    pthread_mutex_lock(&m_cancelMutex);
+    const bool isCancelled = m_isCancelled;
+    pthread_mutex_unlock(&m_cancelMutex);
+    return isCancelled;
+}
+
+void Premo::notifyObserver(const Result& batchResult) const {
+
+    if ( m_observer == 0 )
+        return;
+
+    PremoProgress progress;
+    progress.BatchNumber = m_batchNumber;
+    progress.Batch       = resultSummary(batchResult, m_settings.IsSingleEndMode);
+    progress.Overall     = resultSummary(m_currentResult, m_settings.IsSingleEndMode);
+    progress.IsFinished  = m_isFinished;
+    m_observer->batchFinished(progress);
+}
+
+bool Premo::loadPrior(void) {
+
+    // parse earlier output file
+    ifstream file(m_settings.PriorFilename.c_str());
+    if ( !file ) {
+        m_errorString = "could not open -prior file: ";
+        m_errorString.append(m_settings.PriorFilename);
+        return false;
+    }
+
+    Json::Value root;
+    Json::Reader reader;
+    if ( !reader.parse(file, root) || !root.isObject() ) {
+        m_errorString = "could not parse -prior file: ";
+        m_errorString.append(m_settings.PriorFilename);
+        m_errorString.append("\n\t");
+        m_errorString.append(reader.getFormatedErrorMessages());
+        return false;
+    }
+
+    // load overall result (fragment length is only present in PE output)
+    const Json::Value& overall = root["overall result"];
+    bool isOk = lengthSummaryFromJson(overall["read length"], &m_prior.ReadLength) &&
+                m_prior.ReadLength.Count != 0;
+    if ( isOk && !m_settings.IsSingleEndMode ) {
+        isOk = lengthSummaryFromJson(overall["fragment length"], &m_prior.FragmentLength) &&
+               m_prior.FragmentLength.Count != 0;
+    }
+    if ( !isOk ) {
+        m_errorString = "-prior file has no usable 'overall result'";
+        if ( !m_settings.IsSingleEndMode )
+            m_errorString.append(" (paired-end runs need a paired-end prior, with fragment lengths)");
+        m_errorString.append(": ");
+        m_errorString.append(m_settings.PriorFilename);
+        return false;
+    }
+
+    // number of batches behind prior estimate (for reporting)
+    const Json::Value& batches = root["batch results"];
+    m_numPriorBatches = ( batches.isArray() ? static_cast<int>(batches.size()) : 0 );
+
+    if ( m_settings.IsVerbose ) {
+        cerr << "loaded prior from " << m_numPriorBatches << " batch(es): median read length "
+             << m_prior.ReadLength.Median;
+        if ( !m_settings.IsSingleEndMode )
+            cerr << ", median fragment length " << m_prior.FragmentLength.Median;
+        cerr << endl;
+    }
+    return true;
+}
+
 bool Premo::openInputFiles(void) {
 
-    // open FASTQ input files for reading
+    // open aligned BAM input file, if requested
+    // (one reader, with its index, per sampling thread)
+    if ( m_settings.HasAlignedBamFilename ) {
+
+        for ( unsigned int i = 0; i < m_settings.NumThreads; ++i ) {
+
+            BamTools::BamReader* reader = new BamTools::BamReader;
+            m_alignedBamReaders.push_back(reader);
+
+            if ( !reader->Open(m_settings.AlignedBamFilename) ||
+                 !reader->LocateIndex() )
+            {
+                stringstream s("");
+                s << "could not open input BAM file (an index - .bai or .bti - is required):" << endl
+                  << m_settings.AlignedBamFilename << endl
+                  << "\tbecause: " << reader->GetErrorString();
+                m_errorString = s.str();
+                return false;
+            }
+        }
+
+        if ( m_settings.IsVerbose )
+            cerr << "input BAM file & index opened OK" << endl;
+        return true;
+    }
+
+    // open uBAM input file for reading, if requested
+    // (BGZF blocks are decompressed on up to -t threads)
+    if ( m_settings.HasUnalignedBamFilename ) {
+
+        m_bamReader.setNumThreads(m_settings.NumThreads);
+        if ( !m_bamReader.open(m_settings.UnalignedBamFilename) ) {
+            stringstream s("");
+            s << "could not open input BAM file:" << endl
+              << m_settings.UnalignedBamFilename << endl
+              << "\tbecause: " << m_bamReader.errorString();
+            m_errorString = s.str();
+            return false;
+        }
+
+        if ( m_settings.IsVerbose )
+            cerr << "input BAM file opened OK" << endl;
+        return true;
+    }
+
+    // otherwise, open FASTQ input files for reading
+    // (seekable zstd input is decompressed on up to -t threads)
+    m_reader1.setNumThreads(m_settings.NumThreads);
+    m_reader2.setNumThreads(m_settings.NumThreads);
     bool openedOk = true;
     openedOk &= m_reader1.open(m_settings.FastqFilename1);
     if ( !m_settings.IsSingleEndMode )
@@ -269,89 +680,255 @@ bool Premo::openInputFiles(void) {
 
 bool Premo::run(void) {
 
+    // let interrupts stop a wait for -spool workers, so that spool files are cleaned up
+    SpoolInterruptGuard interruptGuard(m_settings.HasSpoolPath);
+
+    // check settings & prepare input
+    if ( !start() )
+        return false;
+
+    // main loop - batch processing
+    while ( !m_isFinished ) {
+        if ( !runBatch() )
+            return false;
+    }
+
+    // output results
+    return finish();
+}
+
+bool Premo::start(void) {
+
+    m_startTime = wallTime();
+
     // check that settings are valid
     if ( !validateSettings() )
         return false;
 
-    // open our input files for reading (FastqReader dtor closes FASTQ file)
-    if ( !openInputFiles() )
+    // load earlier result, if requested
+    if ( m_settings.HasPriorFilename && !loadPrior() )
         return false;
 
-    // main loop - batch processing
-    int batchNumber = 0;
-    while ( !m_isFinished ) {
+    // exact mode - scan entire input, no batches
+    if ( m_settings.IsExactReadLengthScan ) {
+        if ( !scanReadLengths() )
+            return false;
+        m_isFinished = true;
+        return true;
+    }
 
-        if ( m_settings.IsVerbose )
-            cerr << "running batch: " << batchNumber << endl;
+    // otherwise, open our input files for reading (reader dtors close input files)
+    return openInputFiles();
+}
 
-        // run batch
-        Batch* batch(0);
-        if ( m_settings.IsSingleEndMode )
-            batch = new SingleEndBatch(&m_reader1, &m_settings);
-        else
-            batch = new PairedEndBatch(batchNumber, &m_reader1, &m_reader2, &m_settings);
+// aligns a fraction of the batch's pairs (as an extra, smaller batch) & stores its timings for projectResources()
+// N.B. - best effort: its result is not used for estimation, & failure only loses the projection's linear fit
+void Premo::runCalibrationBatch(const PairedEndBatch* batch, const uint64_t numBatchPairs) {
 
-        const Batch::RunStatus status = batch->run();
+    assert(batch);
 
-        // if we used up entire input on previous batches, that's OK...
-        // but we do need to stop trying batches (and no result is available from this one)
-        if ( status == Batch::NoData && batchNumber != 0 ) {
+    const uint64_t numPairs = numBatchPairs / CALIBRATION_BATCH_DIVISOR;
+    if ( numPairs == 0 )
+        return;
 
-            // clean up
-            delete batch;
-            batch = 0;
+    if ( m_settings.IsVerbose )
+        cerr << "running calibration batch: " << numPairs << " pairs, for resource projection" << endl;
+
+    // own file prefix, so that its files don't collide with the batches'
+    PremoSettings settings(m_settings);
+    settings.BatchFilePrefix.append("calibration_");
+    const string fastq1 = settings.ScratchPath + settings.BatchFilePrefix + "mate1.fq";
+    const string fastq2 = settings.ScratchPath + settings.BatchFilePrefix + "mate2.fq";
+
+    // copy leading pairs & align them
+    string batchFastq1;
+    string batchFastq2;
+    batch->fastqFiles(&batchFastq1, &batchFastq2);
+    int64_t numBytes = 0;
+    bool isOk = copyLeadingPairs(batchFastq1, batchFastq2, fastq1, fastq2, numPairs, &numBytes);
+
+    BatchTimings timings;
+    const ResourceUsage usageBefore = ResourceUsage::current();
+    if ( isOk ) {
+        PairedEndBatch calibrationBatch(fastq1, fastq2, &settings);
+        isOk = ( calibrationBatch.run() == Batch::Normal );
+        timings = calibrationBatch.timings();
+    }
+    const ResourceUsage usageAfter = ResourceUsage::current();
 
-            // break out of batch loop
-            break;
-        }
+    if ( !m_settings.IsKeepGeneratedFiles ) {
+        remove(fastq1.c_str());
+        remove(fastq2.c_str());
+    }
 
-        // if batch failed, set error & return failure
-        else if ( status == Batch::Error ) {
+    if ( !isOk ) {
+        if ( m_settings.IsVerbose )
+            cerr << "calibration batch failed, projected costs will not be fit" << endl;
+        return;
+    }
 
-            // set error string
-            stringstream s("");
-            s << "batch " << batchNumber << " failed - " << endl
-              << batch->errorString();
-            m_errorString = s.str();
+    // store timings
+    timings.NumReads = 2 * numPairs;
+    timings.BytesIn  = numBytes;
+    timings.Usage = usageAfter;
+    timings.Usage.ChildUserSeconds   -= usageBefore.ChildUserSeconds;
+    timings.Usage.ChildSystemSeconds -= usageBefore.ChildSystemSeconds;
+    m_calibrationTimings = timings;
+}
 
-            // clean up
-            delete batch;
-            batch = 0;
+bool Premo::runBatch(void) {
 
-            // return failure
-            return false;
-        }
-        assert( (status == Batch::Normal) || (status == Batch::HitEOF) );
+    // stop here if caller no longer wants results
+    if ( isCancelled() ) {
+        m_errorString = "cancelled";
+        m_isFinished = true;
+        return false;
+    }
 
-        // store batch results
-        const Result result = batch->result();
-        m_batchResults.push_back( result );
+    if ( m_settings.IsVerbose )
+        cerr << "running batch: " << m_batchNumber << endl;
+
+    // run batch
+    const double batchStart = wallTime();
+    const ResourceUsage usageBefore = ResourceUsage::current();
+    Batch* batch(0);
+    PairedEndBatch* pairedBatch(0);
+    const bool isUnalignedBam = m_settings.HasUnalignedBamFilename;
+    if ( m_settings.HasAlignedBamFilename )
+        batch = new AlignedBamBatch(m_batchNumber, m_alignedBamReaders, &m_settings);
+    else if ( m_settings.IsSingleEndMode ) {
+        if ( isUnalignedBam )
+            batch = new SingleEndBatch(&m_bamReader, &m_settings);
+        else
+            batch = new SingleEndBatch(&m_reader1, &m_settings);
+    } else {
+        if ( isUnalignedBam )
+            pairedBatch = new PairedEndBatch(m_batchNumber, &m_bamReader, &m_settings);
+        else
+            pairedBatch = new PairedEndBatch(m_batchNumber, &m_reader1, &m_reader2, &m_settings);
+        pairedBatch->setRunner(this);
+        batch = pairedBatch;
+    }
 
-        // store previous result before adding batch data to "current" result
-        const Result previousResult = m_currentResult;
+    batch->setBatchNumber(m_batchNumber);
+    const Batch::RunStatus status = batch->run();
 
-        // add batch's data to current, overall result
-        append(m_currentResult.ReadLengths, result.ReadLengths);
-        if ( !m_settings.IsSingleEndMode )
-            append(m_currentResult.FragmentLengths, result.FragmentLengths);
+    // if we used up entire input on previous batches, that's OK...
+    // but we do need to stop trying batches (and no result is available from this one)
+    if ( status == Batch::NoData && m_batchNumber != 0 ) {
+
+        // clean up
+        delete batch;
+        batch = 0;
 
-        // if we hit EOF on the input, then we're done
-        // (we can't process any more batches)
-        if ( status == Batch::HitEOF )
-            m_isFinished = true;
+        // no more batches to run
+        m_isFinished = true;
+        return ( m_settings.IsTuningParameters ? tuneParameters() : true );
+    }
 
-        // otherwise, we finished normally - check to see if we're done
-        // (unless this was the first batch)
-        else if ( batchNumber > 0 )
-            m_isFinished = checkFinished(previousResult, m_currentResult, m_settings);
+    // empty input (possible for streams, which are not checked when opened)
+    else if ( status == Batch::NoData ) {
+        m_errorString = "no reads found in input";
+        delete batch;
+        batch = 0;
+        m_isFinished = true;
+        return false;
+    }
 
-        // increment our batch counter
-        ++batchNumber;
+    // if batch failed, set error & return failure
+    else if ( status == Batch::Error ) {
+
+        // set error string
+        stringstream s("");
+        s << "batch " << m_batchNumber << " failed - " << endl
+          << batch->errorString();
+        m_errorString = s.str();
 
         // clean up
         delete batch;
         batch = 0;
+
+        // return failure
+        m_isFinished = true;
+        return false;
     }
+    assert( (status == Batch::Normal) || (status == Batch::HitEOF) );
+
+    // store batch results
+    const Result result = batch->result();
+    m_batchResults.push_back( result );
+
+    // keep (only) the latest batch's reads for -tune
+    if ( m_settings.IsTuningParameters && pairedBatch ) {
+        if ( !m_settings.IsKeepGeneratedFiles && !m_tuningFastq1.empty() ) {
+            remove(m_tuningFastq1.c_str());
+            remove(m_tuningFastq2.c_str());
+        }
+        pairedBatch->releaseFastqFiles(&m_tuningFastq1, &m_tuningFastq2);
+    }
+
+    // store previous result before adding batch data to "current" result
+    const Result previousResult = m_currentResult;
+
+    // add batch's data to current, overall result
+    append(m_currentResult.ReadLengths, result.ReadLengths);
+    if ( !m_settings.IsSingleEndMode ) {
+        append(m_currentResult.FragmentLengths, result.FragmentLengths);
+        m_currentResult.NumUnpairedMates += result.NumUnpairedMates;
+    }
+
+    // if we hit EOF on the input, then we're done
+    // (we can't process any more batches)
+    BatchTimings timings = batch->timings();
+    StageTimer convergenceTimer(&timings, "convergence check");
+    if ( status == Batch::HitEOF )
+        m_isFinished = true;
+
+    // if new data agrees with an earlier run, we're done (this may happen after the first batch)
+    else if ( m_settings.HasPriorFilename &&
+              checkPriorConfirmed(m_prior, m_currentResult, m_settings) )
+    {
+        m_isPriorConfirmed = true;
+        m_isFinished = true;
+    }
+
+    // otherwise, we finished normally - check to see if we're done
+    // (unless this was the first batch)
+    else if ( m_batchNumber > 0 )
+        m_isFinished = checkFinished(previousResult, m_currentResult, m_settings);
+    convergenceTimer.stop();
+
+    // store batch timings & resource usage
+    const ResourceUsage usageAfter = ResourceUsage::current();
+    timings.WallSeconds = wallTime() - batchStart;
+    timings.Usage = usageAfter;
+    timings.Usage.ChildUserSeconds   -= usageBefore.ChildUserSeconds;
+    timings.Usage.ChildSystemSeconds -= usageBefore.ChildSystemSeconds;
+    m_batchTimings.push_back(timings);
+
+    // re-align part of the first batch, so that projected costs can be fit as (fixed + per-read)
+    if ( m_batchNumber == 0 && pairedBatch && isProjectingResources() && !isCancelled() )
+        runCalibrationBatch(pairedBatch, timings.NumReads / 2);
+
+    // report progress
+    notifyObserver(result);
+
+    // increment our batch counter
+    ++m_batchNumber;
+
+    // clean up
+    delete batch;
+    batch = 0;
+
+    // benchmark candidate parameters, once converged
+    if ( m_isFinished && m_settings.IsTuningParameters )
+        return tuneParameters();
+
+    // return success
+    return true;
+}
+
+bool Premo::finish(void) {
 
     // output results
     if ( !writeOutput() )
@@ -361,6 +938,188 @@ bool Premo::run(void) {
     return true;
 }
 
+bool Premo::isFinished(void) const {
+    return m_isFinished;
+}
+
+PremoResult Premo::result(void) const {
+
+    PremoResult result;
+    result.IsSingleEndMode = m_settings.IsSingleEndMode;
+
+    // ------------------------------
+    // summarize results
+    // ------------------------------
+
+    if ( m_settings.IsExactReadLengthScan )
+        result.Overall.ReadLength = histogramSummary(m_readLengthCounts);
+    else
+        result.Overall = resultSummary(m_currentResult, m_settings.IsSingleEndMode);
+
+    vector<Result>::const_iterator batchIter = m_batchResults.begin();
+    vector<Result>::const_iterator batchEnd  = m_batchResults.end();
+    for ( ; batchIter != batchEnd; ++batchIter )
+        result.Batches.push_back( resultSummary(*batchIter, m_settings.IsSingleEndMode) );
+
+    // telemetry
+    result.TotalSeconds = wallTime() - m_startTime;
+    result.Timings = m_batchTimings;
+    result.Projection = projectResources();
+    result.Tuning = m_tuningCandidates;
+    result.HasPrior = m_settings.HasPriorFilename;
+    result.IsPriorConfirmed = m_isPriorConfirmed;
+
+    // -------------------------------
+    // generate Mosaik parameter set
+    // -------------------------------
+
+    const double readLengthMedian = result.Overall.ReadLength.Median;
+    const double fragLengthMedian = result.Overall.FragmentLength.Median; // 0.0 if SE mode
+
+    // calculate bandwidth parameter, rounding down to nearest odd integer
+    unsigned int bandwidth = ceil( m_settings.BwMultiplier * readLengthMedian );
+    if ( (bandwidth & 1) == 0  )
+        bandwidth -= 1;
+
+    MosaikParameters& parameters = result.Parameters;
+    parameters.Act       = (m_settings.ActSlope * readLengthMedian) + m_settings.ActIntercept;
+    parameters.Bandwidth = bandwidth;
+    parameters.HashSize  = m_settings.HashSize;
+    parameters.Mhp       = m_settings.Mhp;
+    parameters.Mmp       = m_settings.Mmp;
+    parameters.SeqTech   = m_settings.SeqTech;
+    if ( !m_settings.IsSingleEndMode ) {
+        parameters.LocalSearchRadius    = fragLengthMedian;
+        parameters.MedianFragmentLength = static_cast<int>(fragLengthMedian);
+    }
+
+    return result;
+}
+
+ResourceProjection Premo::projectResources(void) const {
+
+    ResourceProjection projection;
+
+    // need locally-run Mosaik batches on FASTQ input
+    if ( !isProjectingResources() )
+        return projection;
+
+    // collect per-batch Mosaik costs
+    vector<double> batchBytes;
+    vector<double> batchSeconds;
+    vector<double> batchCpuSeconds;
+    double numReads = 0.0;
+    double sampledBytes = 0.0;
+    vector<BatchTimings>::const_iterator timingsIter = m_batchTimings.begin();
+    vector<BatchTimings>::const_iterator timingsEnd  = m_batchTimings.end();
+    for ( ; timingsIter != timingsEnd; ++timingsIter ) {
+
+        const BatchTimings& timings = (*timingsIter);
+        const double alignerSeconds = stageSeconds(timings, "MosaikAligner");
+        if ( timings.BytesIn <= 0 || alignerSeconds <= 0.0 )
+            continue;
+
+        batchBytes.push_back( static_cast<double>(timings.BytesIn) );
+        batchSeconds.push_back( stageSeconds(timings, "MosaikBuild") + alignerSeconds );
+        batchCpuSeconds.push_back( timings.Usage.ChildUserSeconds + timings.Usage.ChildSystemSeconds );
+        numReads += static_cast<double>(timings.NumReads);
+        sampledBytes += static_cast<double>(timings.BytesIn);
+
+        projection.PeakRssKb = max(projection.PeakRssKb, timings.Usage.ChildPeakRssKb);
+    }
+    if ( batchBytes.empty() )
+        return projection;
+
+    // add calibration run's costs (its reads were already counted in the first batch)
+    const double calibrationAlignerSeconds = stageSeconds(m_calibrationTimings, "MosaikAligner");
+    if ( m_calibrationTimings.BytesIn > 0 && calibrationAlignerSeconds > 0.0 ) {
+        batchBytes.push_back( static_cast<double>(m_calibrationTimings.BytesIn) );
+        batchSeconds.push_back( stageSeconds(m_calibrationTimings, "MosaikBuild") + calibrationAlignerSeconds );
+        batchCpuSeconds.push_back( m_calibrationTimings.Usage.ChildUserSeconds +
+                                   m_calibrationTimings.Usage.ChildSystemSeconds );
+    }
+
+    // full input size
+    bool isEstimated = false;
+    const double bytes1 = inputTextBytes(m_reader1, &isEstimated);
+    const double bytes2 = inputTextBytes(m_reader2, &isEstimated);
+    if ( bytes1 < 0.0 || bytes2 < 0.0 )
+        return projection;
+    projection.InputBytes = bytes1 + bytes2;
+    projection.IsInputBytesEstimated = isEstimated;
+
+    // extrapolate
+    projection.NumReads = numReads * ( projection.InputBytes / sampledBytes );
+
+    bool isWallFit = false;
+    bool isCpuFit  = false;
+    projection.WallSeconds = projectCost(batchBytes, batchSeconds, projection.InputBytes, &isWallFit);
+    projection.CpuHours    = projectCost(batchBytes, batchCpuSeconds, projection.InputBytes, &isCpuFit) / 3600.0;
+    projection.IsLinearFit = ( isWallFit && isCpuFit );
+    projection.IsAvailable = true;
+    return projection;
+}
+
+void Premo::setObserver(PremoObserver* observer) {
+    m_observer = observer;
+}
+
+bool Premo::scanReadLengths(void) {
+
+    // open input file
+    FastqScanner scanner;
+    if ( !scanner.open(m_settings.FastqFilename1) ) {
+        m_errorString = scanner.errorString();
+        return false;
+    }
+
+    if ( m_settings.IsVerbose )
+        cerr << "scanning read lengths using " << m_settings.NumThreads << " thread(s)" << endl;
+
+    // count every entry's read length
+    BatchTimings timings;
+    timings.JobName = m_settings.BatchFilePrefix;
+    StageTimer scanTimer(&timings, "read length scan");
+    if ( !scanner.scan(m_settings.NumThreads, &m_readLengthCounts) ) {
+        m_errorString = scanner.errorString();
+        return false;
+    }
+    scanTimer.stop();
+
+    // store scan timings
+    timings.WallSeconds = timings.Stages.back().Seconds;
+    timings.NumReads    = histogramCount(m_readLengthCounts);
+    timings.BytesIn     = fileSize(m_settings.FastqFilename1);
+    timings.Usage       = ResourceUsage::current();
+    m_batchTimings.push_back(timings);
+
+    if ( m_settings.IsVerbose )
+        cerr << "scanned " << histogramCount(m_readLengthCounts) << " entries" << endl;
+    return true;
+}
+
+bool Premo::tuneParameters(void) {
+
+    if ( m_tuningFastq1.empty() ) {
+        m_errorString = "parameter tuning failed - no batch reads available";
+        return false;
+    }
+
+    // time tuning phase (trace only, it is not a batch)
+    BatchTimings timings;
+    timings.JobName = m_settings.BatchFilePrefix;
+    timings.BatchNumber = m_batchNumber;
+    StageTimer tuningTimer(&timings, "parameter tuning");
+
+    ParameterTuner tuner(m_settings);
+    if ( !tuner.tune(m_tuningFastq1, m_tuningFastq2, result().Parameters, &m_tuningCandidates) ) {
+        m_errorString = "parameter tuning failed - ";
+        m_errorString.append(tuner.errorString());
+        return false;
+    }
+    return true;
+}
+
 bool Premo::validateSettings(void) {
 
     // -------------------------------
@@ -370,14 +1129,28 @@ bool Premo::validateSettings(void) {
     stringstream missing("");
     bool hasMissing = false;
 
-    // -fq1
-    if ( !m_settings.HasFastqFilename1 || m_settings.FastqFilename1.empty() ) {
-        missing << endl << "\t-fq1 (FASTQ filename)";
+    // -fq1 (unless -ubam or -bam provided)
+    const bool hasUnalignedBam = ( m_settings.HasUnalignedBamFilename && !m_settings.UnalignedBamFilename.empty() );
+    const bool hasAlignedBam   = ( m_settings.HasAlignedBamFilename   && !m_settings.AlignedBamFilename.empty() );
+    if ( !hasUnalignedBam && !hasAlignedBam &&
+         (!m_settings.HasFastqFilename1 || m_settings.FastqFilename1.empty()) )
+    {
+        missing << endl << "\t-fq1 (FASTQ filename), -ubam (unaligned BAM filename) or -bam (aligned BAM filename)";
+        hasMissing = true;
+    }
+
+    // -fq2 (paired-end mode, unless -ubam or -bam provided)
+    if ( !m_settings.IsSingleEndMode && !hasUnalignedBam && !hasAlignedBam &&
+         (!m_settings.HasFastqFilename2 || m_settings.FastqFilename2.empty()) )
+    {
+        missing << endl << "\t-fq2 (FASTQ filename)";
         hasMissing = true;
     }
 
-    // -out
-    if ( !m_settings.HasOutputFilename || m_settings.OutputFilename.empty() ) {
+    // -out (unless results are returned to a library caller)
+    if ( m_isOutputRequired &&
+         (!m_settings.HasOutputFilename || m_settings.OutputFilename.empty()) )
+    {
         missing << endl << "\t-out (output filename)";
         hasMissing = true;
     }
@@ -388,8 +1161,11 @@ bool Premo::validateSettings(void) {
         hasMissing = true;
     }
 
-    // check required input for paired-end mode
-    if ( !m_settings.IsSingleEndMode ) {
+    // check required input for Mosaik batch runs
+    // (paired-end mode, unless sampling an existing aligned BAM or handing batches to -spool workers)
+    const bool hasSpool = ( m_settings.HasSpoolPath && !m_settings.SpoolPath.empty() );
+    const bool isRunningMosaik = ( !m_settings.IsSingleEndMode && !hasAlignedBam && !hasSpool );
+    if ( isRunningMosaik ) {
 
         // -annpe
         if ( !m_settings.HasAnnPeFilename || m_settings.AnnPeFilename.empty() ) {
@@ -403,12 +1179,6 @@ bool Premo::validateSettings(void) {
             hasMissing = true;
         }
 
-        // -fq2
-        if ( !m_settings.HasFastqFilename2 || m_settings.FastqFilename2.empty() ) {
-            missing << endl << "\t-fq2 (FASTQ filename)";
-            hasMissing = true;
-        }
-
         // -mosaik
         if ( !m_settings.HasMosaikPath || m_settings.MosaikPath.empty() ) {
             missing << endl << "\t-mosaik (path/to/Mosaik/bin)";
@@ -490,8 +1260,75 @@ bool Premo::validateSettings(void) {
         hasInvalid = true;
     }
 
-    // check valid input for paired-end mode
-    if ( !m_settings.IsSingleEndMode ) {
+    if ( m_settings.IsExactReadLengthScan && !m_settings.IsSingleEndMode ) {
+        invalid << endl << "\t-exact is only available in single-end mode (-se)";
+        hasInvalid = true;
+    }
+
+    if ( FastqReader::isStandardIn(m_settings.FastqFilename1) &&
+         FastqReader::isStandardIn(m_settings.FastqFilename2) )
+    {
+        invalid << endl << "\t-fq1 & -fq2 cannot both read from stdin (use a FIFO for one of them)";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.IsExactReadLengthScan && FastqReader::isStandardIn(m_settings.FastqFilename1) ) {
+        invalid << endl << "\t-exact requires a regular file, it cannot read from stdin";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.IsExactReadLengthScan && m_settings.HasPriorFilename ) {
+        invalid << endl << "\t-exact scans all input, it cannot be used with -prior";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.IsExactReadLengthScan && m_settings.HasUnalignedBamFilename ) {
+        invalid << endl << "\t-exact requires FASTQ input, it cannot be used with -ubam";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.HasUnalignedBamFilename && (m_settings.HasFastqFilename1 || m_settings.HasFastqFilename2) ) {
+        invalid << endl << "\t-ubam cannot be combined with -fq1/-fq2";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.HasAlignedBamFilename &&
+         (m_settings.HasFastqFilename1 || m_settings.HasFastqFilename2 ||
+          m_settings.HasUnalignedBamFilename || m_settings.IsExactReadLengthScan) )
+    {
+        invalid << endl << "\t-bam cannot be combined with -fq1/-fq2, -ubam or -exact";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.IsTuningParameters &&
+         (m_settings.IsSingleEndMode || m_settings.HasAlignedBamFilename || m_settings.HasSpoolPath) )
+    {
+        invalid << endl << "\t-tune runs MosaikAligner locally on paired-end batches, it cannot be used with -se, -bam or -spool";
+        hasInvalid = true;
+    }
+
+    if ( m_settings.HasSpoolPath && (m_settings.IsSingleEndMode || m_settings.HasAlignedBamFilename) ) {
+        invalid << endl << "\t-spool distributes Mosaik batch runs, it cannot be used with -se or -bam";
+        hasInvalid = true;
+    }
+
+    // -spool (workers may run in other directories, so store as absolute path)
+    if ( hasSpool && !m_settings.IsSingleEndMode ) {
+        m_settings.SpoolPath = absolutePath(m_settings.SpoolPath);
+        if ( !endsWith(m_settings.SpoolPath, "/") )
+            m_settings.SpoolPath.append("/");
+        if ( !createDirectory(m_settings.SpoolPath.c_str()) ) {
+            invalid << endl << "\tcould not create the directory specified by -spool. Be sure you have mkdir permissions";
+            hasInvalid = true;
+        }
+    }
+
+    // -t (0 means use all available processors)
+    if ( m_settings.NumThreads == 0 )
+        m_settings.NumThreads = numAvailableProcessors();
+
+    // check valid input for Mosaik batch runs
+    if ( isRunningMosaik ) {
 
         // -tmp
         if ( m_settings.HasScratchPath && !m_settings.ScratchPath.empty() ) {
@@ -541,25 +1378,29 @@ bool Premo::validateSettings(void) {
     return settingsOk;
 }
 
-bool Premo::writeOutput(void) {
+void Premo::toJson(Json::Value* json) const {
+
+    assert(json);
 
-    Json::Value root(Json::objectValue);
+    const PremoResult result = this->result();
+    Json::Value& root = *json;
+    root = Json::Value(Json::objectValue);
 
     // ------------------------------
     // store top-level results
     // ------------------------------
 
-    root["overall result"] = resultToJson(m_currentResult, m_settings.IsSingleEndMode);
+    root["overall result"] = summaryToJson(result.Overall, m_settings.IsSingleEndMode);
 
     // -------------------------
     // store per-batch results
     // -------------------------
 
     Json::Value batches(Json::arrayValue);
-    vector<Result>::const_iterator batchIter = m_batchResults.begin();
-    vector<Result>::const_iterator batchEnd  = m_batchResults.end();
+    vector<BatchSummary>::const_iterator batchIter = result.Batches.begin();
+    vector<BatchSummary>::const_iterator batchEnd  = result.Batches.end();
     for ( ; batchIter != batchEnd; ++batchIter )
-        batches.append( resultToJson(*batchIter, m_settings.IsSingleEndMode) );
+        batches.append( summaryToJson(*batchIter, m_settings.IsSingleEndMode) );
 
     root["batch results"] = batches;
 
@@ -578,51 +1419,122 @@ bool Premo::writeOutput(void) {
     settings["mhp"]                   = m_settings.Mhp;
     settings["mmp"]                   = m_settings.Mmp;
     settings["seq tech"]              = m_settings.SeqTech;
+    if ( m_settings.IsExactReadLengthScan )
+        settings["exact read length scan"] = true;
 
     root["settings"] = settings;
 
-    // -------------------------------
-    // generate Mosaik parameter set
-    // -------------------------------
+    // ------------------------------
+    // store prior used, if any
+    // ------------------------------
 
-    // calculate read length median & related stats
-    vector<int> readLengths  = m_currentResult.ReadLengths;
-    sort(readLengths.begin(), readLengths.end());
-    const double readLengthMedian = calculateMedian(readLengths);
+    if ( result.HasPrior ) {
+        Json::Value prior(Json::objectValue);
+        prior["filename"]       = m_settings.PriorFilename;
+        prior["batch results"]  = m_numPriorBatches;
+        prior["overall result"] = summaryToJson(m_prior, m_settings.IsSingleEndMode);
+        prior["confirmed"]      = result.IsPriorConfirmed;
+        root["prior"] = prior;
+    }
 
-    // calculate bandwidth parameter, rounding down to nearest odd integer
-    unsigned int bandwidth = ceil( m_settings.BwMultiplier * readLengthMedian );
-    if ( (bandwidth & 1) == 0  )
-        bandwidth -= 1;
+    // -------------------------------
+    // store Mosaik parameter set
+    // -------------------------------
 
-    // if PE mode, calculate fragment length median
-    double fragLengthMedian(0.0);
-    if ( !m_settings.IsSingleEndMode ) {
-        vector<int> fragmentLengths = m_currentResult.FragmentLengths;
-        sort(fragmentLengths.begin(), fragmentLengths.end());
-        fragLengthMedian = calculateMedian(fragmentLengths);
-    }
+    const MosaikParameters& p = result.Parameters;
 
-    Json::Value mosaikAlignerParameters(Json::objectValue);
-    mosaikAlignerParameters["-act"] = (m_settings.ActSlope * readLengthMedian) + m_settings.ActIntercept;
-    mosaikAlignerParameters["-bw"]  = bandwidth;
-    mosaikAlignerParameters["-hs"]  = m_settings.HashSize;
-    mosaikAlignerParameters["-mhp"] = m_settings.Mhp;
-    mosaikAlignerParameters["-mmp"] = m_settings.Mmp;
-    if ( !m_settings.IsSingleEndMode )
-        mosaikAlignerParameters["-ls"] = fragLengthMedian;
+    Json::Value mosaikAlignerParameters = alignerParametersToJson(p, m_settings.IsSingleEndMode);
 
     Json::Value mosaikBuildParameters(Json::objectValue);
-    mosaikBuildParameters["-st"] = m_settings.SeqTech;
+    mosaikBuildParameters["-st"] = p.SeqTech;
     if ( !m_settings.IsSingleEndMode )
-        mosaikBuildParameters["-mfl"] = static_cast<int>(fragLengthMedian);
+        mosaikBuildParameters["-mfl"] = p.MedianFragmentLength;
 
     Json::Value parameters(Json::objectValue);
     parameters["MosaikAligner"] = mosaikAlignerParameters;
     parameters["MosaikBuild"]   = mosaikBuildParameters;
 
+    // Pareto-optimal (speed vs. pairs mapped) sets found by -tune, fastest first
+    if ( !result.Tuning.empty() ) {
+
+        vector<TuningCandidate> paretoCandidates;
+        vector<TuningCandidate>::const_iterator tuningIter = result.Tuning.begin();
+        vector<TuningCandidate>::const_iterator tuningEnd  = result.Tuning.end();
+        for ( ; tuningIter != tuningEnd; ++tuningIter ) {
+            if ( tuningIter->IsParetoOptimal )
+                paretoCandidates.push_back(*tuningIter);
+        }
+        stable_sort(paretoCandidates.begin(), paretoCandidates.end(), isFasterCandidate);
+
+        Json::Value tuned(Json::arrayValue);
+        for ( size_t i = 0; i < paretoCandidates.size(); ++i )
+            tuned.append( tuningCandidateToJson(paretoCandidates.at(i)) );
+        parameters["tuned"] = tuned;
+    }
+
     root["parameters"] = parameters;
 
+    // ------------------------------
+    // store timings
+    // ------------------------------
+
+    Json::Value batchTimings(Json::arrayValue);
+    vector<BatchTimings>::const_iterator timingsIter = result.Timings.begin();
+    vector<BatchTimings>::const_iterator timingsEnd  = result.Timings.end();
+    for ( ; timingsIter != timingsEnd; ++timingsIter )
+        batchTimings.append( timingsToJson(*timingsIter) );
+
+    Json::Value timings(Json::objectValue);
+    timings["total seconds"] = result.TotalSeconds;
+    timings["batches"]       = batchTimings;
+
+    root["timings"] = timings;
+
+    // ------------------------------
+    // store full tuning grid
+    // ------------------------------
+
+    if ( !result.Tuning.empty() ) {
+
+        Json::Value candidates(Json::arrayValue);
+        vector<TuningCandidate>::const_iterator tuningIter = result.Tuning.begin();
+        vector<TuningCandidate>::const_iterator tuningEnd  = result.Tuning.end();
+        for ( ; tuningIter != tuningEnd; ++tuningIter ) {
+            Json::Value candidate = tuningCandidateToJson(*tuningIter);
+            candidate["pareto optimal"] = tuningIter->IsParetoOptimal;
+            candidates.append(candidate);
+        }
+
+        Json::Value tuning(Json::objectValue);
+        tuning["candidates"] = candidates;
+        root["tuning"] = tuning;
+    }
+
+    // ------------------------------------
+    // store full-run resource projection
+    // ------------------------------------
+
+    const ResourceProjection& projection = result.Projection;
+    if ( projection.IsAvailable ) {
+
+        Json::Value projectionJson(Json::objectValue);
+        projectionJson["input bytes"]           = projection.InputBytes;
+        projectionJson["input bytes estimated"] = projection.IsInputBytesEstimated;
+        projectionJson["reads"]                 = floor(projection.NumReads + 0.5);
+        projectionJson["wall seconds"]          = projection.WallSeconds;
+        projectionJson["cpu hours"]             = projection.CpuHours;
+        projectionJson["peak rss kb"]           = static_cast<double>(projection.PeakRssKb);
+        projectionJson["model"]                 = ( projection.IsLinearFit ? "linear fit" : "proportional" );
+
+        root["projection"] = projectionJson;
+    }
+}
+
+bool Premo::writeOutput(void) {
+
+    Json::Value root;
+    toJson(&root);
+
     // ---------------------------
     // write JSON to output file
     // ---------------------------
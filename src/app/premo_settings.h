@@ -2,7 +2,7 @@
 // premo_settings.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 3 June 2014 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Premo app settings
 // ***************************************************************************
@@ -27,6 +27,9 @@ const double BwMultiplier = 2.5;
 // number of mate-pairs per premo batch
 const unsigned int BatchSize = 1000;
 
+// number of threads for premo's own processing (0 = use all available processors)
+const unsigned int NumThreads = 0;
+
 // stop running premo batches when the total median (for both FL & RL)
 // changes by less than this fraction after adding a new batch
 const double DeltaFragmentLength = 0.01;
@@ -44,23 +47,39 @@ const double Mmp = 0.15;
 // number of processors for MosaikAligner to use
 const unsigned int NumProcessors = 1;
 
+// seconds a -spool coordinator waits for a worker's batch result (0 = no limit)
+const unsigned int SpoolTimeout = 3600;
+
 // directory for generated files (they're cleaned up by default)
 const std::string ScratchPath(".");
 
+// filename prefix for generated batch files
+const std::string BatchFilePrefix("premo_batch");
+
 } // namespace Defaults
 
 struct PremoSettings {
 
     // I/O flags
+    bool HasAlignedBamFilename;
     bool HasAnnPeFilename;
     bool HasAnnSeFilename;
     bool HasFastqFilename1;
     bool HasFastqFilename2;
     bool HasJumpDbStub;
+    bool HasManifestFilename;
     bool HasMosaikPath;
     bool HasOutputFilename;
+    bool HasPriorFilename;
     bool HasReferenceFilename;
     bool HasScratchPath;
+    bool HasServeSocketFilename;
+    bool HasSpoolPath;
+    bool HasSpoolTimeout;
+    bool HasSubmitSocketFilename;
+    bool HasTraceFilename;
+    bool HasUnalignedBamFilename;
+    bool HasWorkerSpoolPath;
     bool IsKeepGeneratedFiles;
     bool IsVerbose;
     bool IsVersionRequested;
@@ -69,7 +88,10 @@ struct PremoSettings {
     bool HasBatchSize;
     bool HasDeltaReadLength;
     bool HasDeltaFragmentLength;
+    bool HasNumThreads;
+    bool IsExactReadLengthScan;
     bool IsSingleEndMode;
+    bool IsTuningParameters;
 
     // mosaik flags
     bool HasActIntercept;
@@ -82,20 +104,32 @@ struct PremoSettings {
     bool HasSeqTech;
 
     // I/O parameters
+    std::string AlignedBamFilename;
     std::string AnnPeFilename;
     std::string AnnSeFilename;
     std::string FastqFilename1;
     std::string FastqFilename2;
     std::string JumpDbStub;
+    std::string ManifestFilename;
     std::string MosaikPath;
     std::string OutputFilename;
+    std::string PriorFilename;
     std::string ReferenceFilename;
     std::string ScratchPath;
+    std::string ServeSocketFilename;
+    std::string SpoolPath;
+    std::string SubmitSocketFilename;
+    std::string TraceFilename;
+    std::string UnalignedBamFilename;
+    std::string WorkerSpoolPath;
+    std::string BatchFilePrefix;      // not a command-line option, keeps jobs sharing -tmp apart
+    unsigned int SpoolTimeout;
 
     // premo parameters
     unsigned int BatchSize;
     double DeltaReadLength;
     double DeltaFragmentLength;
+    unsigned int NumThreads;
 
     // mosaik parameters
     unsigned int ActIntercept;
@@ -109,22 +143,35 @@ struct PremoSettings {
 
     // ctors
     PremoSettings(void)
-        : HasAnnPeFilename(false)
+        : HasAlignedBamFilename(false)
+        , HasAnnPeFilename(false)
         , HasAnnSeFilename(false)
         , HasFastqFilename1(false)
         , HasFastqFilename2(false)
         , HasJumpDbStub(false)
+        , HasManifestFilename(false)
         , HasMosaikPath(false)
         , HasOutputFilename(false)
+        , HasPriorFilename(false)
         , HasReferenceFilename(false)
         , HasScratchPath(false)
+        , HasServeSocketFilename(false)
+        , HasSpoolPath(false)
+        , HasSpoolTimeout(false)
+        , HasSubmitSocketFilename(false)
+        , HasTraceFilename(false)
+        , HasUnalignedBamFilename(false)
+        , HasWorkerSpoolPath(false)
         , IsKeepGeneratedFiles(false)
         , IsVerbose(false)
         , IsVersionRequested(false)
         , HasBatchSize(false)
         , HasDeltaReadLength(false)
         , HasDeltaFragmentLength(false)
+        , HasNumThreads(false)
+        , IsExactReadLengthScan(false)
         , IsSingleEndMode(false)
+        , IsTuningParameters(false)
         , HasActIntercept(false)
         , HasActSlope(false)
         , HasBwMultiplier(false)
@@ -133,18 +180,30 @@ struct PremoSettings {
         , HasMmp(false)
         , HasNumProcessors(false)
         , HasSeqTech(false)
+        , AlignedBamFilename("")
         , AnnPeFilename("")
         , AnnSeFilename("")
         , FastqFilename1("")
         , FastqFilename2("")
         , JumpDbStub("")
+        , ManifestFilename("")
         , MosaikPath("")
         , OutputFilename("")
+        , PriorFilename("")
         , ReferenceFilename("")
         , ScratchPath(Defaults::ScratchPath)
+        , ServeSocketFilename("")
+        , SpoolPath("")
+        , SubmitSocketFilename("")
+        , TraceFilename("")
+        , UnalignedBamFilename("")
+        , WorkerSpoolPath("")
+        , BatchFilePrefix(Defaults::BatchFilePrefix)
+        , SpoolTimeout(Defaults::SpoolTimeout)
         , BatchSize(Defaults::BatchSize)
         , DeltaReadLength(Defaults::DeltaReadLength)
         , DeltaFragmentLength(Defaults::DeltaFragmentLength)
+        , NumThreads(Defaults::NumThreads)
         , ActIntercept(Defaults::ActIntercept)
         , ActSlope(Defaults::ActSlope)
         , BwMultiplier(Defaults::BwMultiplier)
@@ -156,22 +215,35 @@ struct PremoSettings {
     { }
 
     PremoSettings(const PremoSettings& other)
-        : HasAnnPeFilename(other.HasAnnPeFilename)
+        : HasAlignedBamFilename(other.HasAlignedBamFilename)
+        , HasAnnPeFilename(other.HasAnnPeFilename)
         , HasAnnSeFilename(other.HasAnnSeFilename)
         , HasFastqFilename1(other.HasFastqFilename1)
         , HasFastqFilename2(other.HasFastqFilename2)
         , HasJumpDbStub(other.HasJumpDbStub)
+        , HasManifestFilename(other.HasManifestFilename)
         , HasMosaikPath(other.HasMosaikPath)
         , HasOutputFilename(other.HasOutputFilename)
+        , HasPriorFilename(other.HasPriorFilename)
         , HasReferenceFilename(other.HasReferenceFilename)
         , HasScratchPath(other.HasScratchPath)
+        , HasServeSocketFilename(other.HasServeSocketFilename)
+        , HasSpoolPath(other.HasSpoolPath)
+        , HasSpoolTimeout(other.HasSpoolTimeout)
+        , HasSubmitSocketFilename(other.HasSubmitSocketFilename)
+        , HasTraceFilename(other.HasTraceFilename)
+        , HasUnalignedBamFilename(other.HasUnalignedBamFilename)
+        , HasWorkerSpoolPath(other.HasWorkerSpoolPath)
         , IsKeepGeneratedFiles(other.IsKeepGeneratedFiles)
         , IsVerbose(other.IsVerbose)
         , IsVersionRequested(other.IsVersionRequested)
         , HasBatchSize(other.HasBatchSize)
         , HasDeltaReadLength(other.HasDeltaReadLength)
         , HasDeltaFragmentLength(other.HasDeltaFragmentLength)
+        , HasNumThreads(other.HasNumThreads)
+        , IsExactReadLengthScan(other.IsExactReadLengthScan)
         , IsSingleEndMode(other.IsSingleEndMode)
+        , IsTuningParameters(other.IsTuningParameters)
         , HasActIntercept(other.HasActIntercept)
         , HasActSlope(other.HasActSlope)
         , HasBwMultiplier(other.HasBwMultiplier)
@@ -180,18 +252,30 @@ struct PremoSettings {
         , HasMmp(other.HasMmp)
         , HasNumProcessors(other.HasNumProcessors)
         , HasSeqTech(other.HasSeqTech)
+        , AlignedBamFilename(other.AlignedBamFilename)
         , AnnPeFilename(other.AnnPeFilename)
         , AnnSeFilename(other.AnnSeFilename)
         , FastqFilename1(other.FastqFilename1)
         , FastqFilename2(other.FastqFilename2)
         , JumpDbStub(other.JumpDbStub)
+        , ManifestFilename(other.ManifestFilename)
         , MosaikPath(other.MosaikPath)
         , OutputFilename(other.OutputFilename)
+        , PriorFilename(other.PriorFilename)
         , ReferenceFilename(other.ReferenceFilename)
         , ScratchPath(other.ScratchPath)
+        , ServeSocketFilename(other.ServeSocketFilename)
+        , SpoolPath(other.SpoolPath)
+        , SubmitSocketFilename(other.SubmitSocketFilename)
+        , TraceFilename(other.TraceFilename)
+        , UnalignedBamFilename(other.UnalignedBamFilename)
+        , WorkerSpoolPath(other.WorkerSpoolPath)
+        , BatchFilePrefix(other.BatchFilePrefix)
+        , SpoolTimeout(other.SpoolTimeout)
         , BatchSize(other.BatchSize)
         , DeltaReadLength(other.DeltaReadLength)
         , DeltaFragmentLength(other.DeltaFragmentLength)
+        , NumThreads(other.NumThreads)
         , ActIntercept(other.ActIntercept)
         , ActSlope(other.ActSlope)
         , BwMultiplier(other.BwMultiplier)
@@ -0,0 +1,130 @@
+// ***************************************************************************
+// premo_utils.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Filesystem & system utilities shared by Premo components
+// ***************************************************************************
+
+#include "premo_utils.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+string absolutePath(const string& path) {
+
+    if ( path.empty() || path[0] == '/' )
+        return path;
+
+    // grow buffer until current directory fits
+    vector<char> buffer(256);
+    while ( getcwd(&buffer[0], buffer.size()) == NULL ) {
+        if ( buffer.size() > 65536 )
+            return path;
+        buffer.resize( buffer.size() * 2 );
+    }
+
+    string result(&buffer[0]);
+    if ( result.empty() || result[result.length() - 1] != '/' )
+        result.append("/");
+    result.append(path);
+    return result;
+}
+
+bool dirExists(const char* directory) {
+
+    // Borrowed from Mosaik source (w/o Windows compatibility)
+    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+
+    bool foundDirectory = false;
+
+    struct stat st;
+    if ( stat(directory, &st) == 0 ) {
+        DIR* pDirectory = opendir(directory);
+        if ( pDirectory != NULL ) {
+            foundDirectory = true;
+            closedir( pDirectory );
+        }
+    }
+
+    return foundDirectory;
+}
+
+uint64_t fileSize(const string& filename) {
+    struct stat st;
+    if ( stat(filename.c_str(), &st) != 0 )
+        return 0;
+    return static_cast<uint64_t>(st.st_size);
+}
+
+bool createDirectory(const char* directory) {
+
+    // Borrowed from Mosaik source (** w/o Windows compatibility **)
+    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+
+    // return success if directory already exists
+    if ( dirExists(directory) )
+        return true;
+
+    // otherwise return success/failure of creatin directory
+    return ( mkdir(directory, S_IRWXU | S_IRGRP | S_IXGRP) == 0 );
+}
+
+bool prepareDirectory(string* directory, bool* createdDirectory) {
+
+    *createdDirectory = false;
+
+    // append dir separator if missing from path
+    if ( !directory->empty() && (*directory)[directory->length() - 1] != '/' )
+        directory->append("/");
+
+    if ( dirExists(directory->c_str()) )
+        return true;
+
+    *createdDirectory = createDirectory(directory->c_str());
+    return *createdDirectory;
+}
+
+void removeDirectory(string directory) {
+
+    // Borrowed from Mosaik source (** w/o Windows compatibility **)
+    // https://github.com/wanpinglee/MOSAIK/blob/master/src/CommonSource/Utilities/FileUtilities.cpp
+
+    // skip out if directory doesn't exist
+    if( !dirExists( directory.c_str() ) )
+        return;
+
+    // open directory
+    DIR* pdir = NULL;
+    pdir = opendir( directory.c_str() );
+    if ( pdir == NULL )
+        return;
+
+    string file;
+    struct dirent* pent = NULL;
+
+    // iterate over directory contents
+    while ( (pent = readdir(pdir)) != NULL ) {
+        if ( pent == NULL ) return;
+
+        // get full path to file & remove it
+        file = directory + pent->d_name;
+        remove(file.c_str());
+    }
+
+    // close the directory & remove it
+    closedir(pdir);
+    rmdir(directory.c_str());
+}
+
+unsigned int numAvailableProcessors(void) {
+    const long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    return ( numProcessors > 0 ? static_cast<unsigned int>(numProcessors) : 1 );
+}
@@ -0,0 +1,31 @@
+// ***************************************************************************
+// premo_utils.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Filesystem & system utilities shared by Premo components
+// ***************************************************************************
+
+#ifndef PREMO_UTILS_H
+#define PREMO_UTILS_H
+
+#include <stdint.h>
+#include <string>
+
+bool createDirectory(const char* directory);
+bool dirExists(const char* directory);
+uint64_t fileSize(const std::string& filename); // 0 if missing
+void removeDirectory(std::string directory); // N.B. - expects trailing '/' on directory
+
+// appends '/' to directory if missing, then creates it if needed
+// (createdDirectory is set to true only if directory did not already exist)
+bool prepareDirectory(std::string* directory, bool* createdDirectory);
+
+// returns path unchanged if absolute, otherwise prefixed with the current directory
+std::string absolutePath(const std::string& path);
+
+// returns # of online processors (at least 1)
+unsigned int numAvailableProcessors(void);
+
+#endif // PREMO_UTILS_H
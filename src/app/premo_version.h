@@ -0,0 +1,20 @@
+// ***************************************************************************
+// premo_version.h.in (c) 2012 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 6 June 2012 (DB)
+// ---------------------------------------------------------------------------
+// Provides version information for the Premo app.
+// ***************************************************************************
+
+#ifndef PREMO_VERSION_H
+#define PREMO_VERSION_H
+
+// CMake uses this file as a template to generate "premo_version.h".
+// These constants are defined to match the variables set in the build system. 
+#define PREMO_VERSION_MAJOR 0
+#define PREMO_VERSION_MINOR 2
+#define PREMO_VERSION_BUILD 1
+
+#endif // PREMO_VERSION_H
+
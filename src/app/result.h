@@ -2,7 +2,7 @@
 // result.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 24 June 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Aggregation struct for results
 // ***************************************************************************
@@ -17,12 +17,16 @@ struct Result {
     // data members
     std::vector<int> FragmentLengths;
     std::vector<int> ReadLengths;
+    unsigned int NumUnpairedMates;   // paired-end mates whose partner was not found in aligner output
 
     // ctors & dtor
-    Result(void) { }
+    Result(void)
+        : NumUnpairedMates(0)
+    { }
     Result(const Result& other)
         : FragmentLengths(other.FragmentLengths)
         , ReadLengths(other.ReadLengths)
+        , NumUnpairedMates(other.NumUnpairedMates)
     { }
     ~Result(void) { }
 };
@@ -0,0 +1,338 @@
+// ***************************************************************************
+// scheduler.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Runs many Premo jobs (from a manifest) on a shared pool of worker threads
+// ***************************************************************************
+
+#include "scheduler.h"
+#include "premo.h"
+#include "premo_utils.h"
+#include "spool.h"
+
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// scheduler job
+// ------------------------
+
+struct SchedulerJob {
+
+    // enums
+    enum State { Pending = 0  // not yet started
+               , Ready        // started, waiting for its next batch
+               , Running      // owned by a worker
+               , Done
+               , Failed
+               };
+
+    // data members
+    int Id;
+    int ManifestLine;
+    PremoSettings Settings;
+    Premo* Runner;
+    State JobState;
+    std::string ErrorString;
+
+    // ctor & dtor
+    SchedulerJob(const int id, const int manifestLine, const PremoSettings& settings)
+        : Id(id)
+        , ManifestLine(manifestLine)
+        , Settings(settings)
+        , Runner(0)
+        , JobState(Pending)
+    { }
+
+    ~SchedulerJob(void) {
+        delete Runner;
+    }
+};
+
+// ---------------------------
+// Scheduler implementation
+// ---------------------------
+
+Scheduler::Scheduler(const PremoSettings& settings)
+    : m_settings(settings)
+    , m_nextJobIndex(0)
+    , m_createdScratchDirectory(false)
+{
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_jobReleased, 0);
+}
+
+Scheduler::~Scheduler(void) {
+
+    // clean up jobs
+    for ( size_t i = 0; i < m_jobs.size(); ++i )
+        delete m_jobs.at(i);
+    m_jobs.clear();
+
+    // remove shared scratch directory, if we created it
+    if ( !m_settings.IsKeepGeneratedFiles && m_createdScratchDirectory )
+        removeDirectory(m_settings.ScratchPath);
+
+    pthread_cond_destroy(&m_jobReleased);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+string Scheduler::errorString(void) const {
+    return m_errorString;
+}
+
+bool Scheduler::loadManifest(void) {
+
+    ifstream manifest(m_settings.ManifestFilename.c_str());
+    if ( !manifest ) {
+        m_errorString = "could not open manifest file: ";
+        m_errorString.append(m_settings.ManifestFilename);
+        return false;
+    }
+
+    // expected columns: <fq1> <fq2> <out> (paired-end), or <fq1> <out> (single-end)
+    const size_t numColumns = ( m_settings.IsSingleEndMode ? 2 : 3 );
+
+    string line;
+    int lineNumber = 0;
+    while ( getline(manifest, line) ) {
+        ++lineNumber;
+
+        // skip comments & blank lines
+        const size_t commentPos = line.find('#');
+        if ( commentPos != string::npos )
+            line.erase(commentPos);
+
+        vector<string> columns;
+        stringstream s(line);
+        string column;
+        while ( s >> column )
+            columns.push_back(column);
+        if ( columns.empty() )
+            continue;
+
+        if ( columns.size() != numColumns ) {
+            stringstream e("");
+            e << "manifest line " << lineNumber << " has " << columns.size()
+              << " columns, expected " << numColumns
+              << ( m_settings.IsSingleEndMode ? " (<fq1> <out>)" : " (<fq1> <fq2> <out>)" );
+            m_errorString = e.str();
+            return false;
+        }
+
+        // set up job's settings
+        const int jobId = static_cast<int>(m_jobs.size());
+        PremoSettings jobSettings = m_settings;
+        jobSettings.HasManifestFilename = false;
+        jobSettings.HasFastqFilename1   = true;
+        jobSettings.FastqFilename1      = columns.at(0);
+        if ( !m_settings.IsSingleEndMode ) {
+            jobSettings.HasFastqFilename2 = true;
+            jobSettings.FastqFilename2    = columns.at(1);
+        }
+        jobSettings.HasOutputFilename = true;
+        jobSettings.OutputFilename    = columns.back();
+
+        stringstream prefix("");
+        prefix << "premo_job" << jobId << "_batch";
+        jobSettings.BatchFilePrefix = prefix.str();
+
+        m_jobs.push_back( new SchedulerJob(jobId, lineNumber, jobSettings) );
+    }
+
+    if ( m_jobs.empty() ) {
+        m_errorString = "no jobs found in manifest file: ";
+        m_errorString.append(m_settings.ManifestFilename);
+        return false;
+    }
+
+    return true;
+}
+
+bool Scheduler::prepareScratchDirectory(void) {
+
+    // only needed for Mosaik batch runs (missing -tmp is reported by each job)
+    if ( m_settings.IsSingleEndMode || !m_settings.HasScratchPath || m_settings.ScratchPath.empty() )
+        return true;
+
+    // create it here, so that it outlives every job (jobs only remove directories they created)
+    if ( !prepareDirectory(&m_settings.ScratchPath, &m_createdScratchDirectory) ) {
+        m_errorString = "could not create the directory specified by -tmp. Be sure you have mkdir permissions";
+        return false;
+    }
+    return true;
+}
+
+void Scheduler::releaseJob(SchedulerJob* job, const bool isFinished, const bool isOk) {
+
+    pthread_mutex_lock(&m_mutex);
+
+    if ( !isFinished )
+        job->JobState = SchedulerJob::Ready;
+    else
+        job->JobState = ( isOk ? SchedulerJob::Done : SchedulerJob::Failed );
+
+    pthread_cond_broadcast(&m_jobReleased);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+bool Scheduler::run(void) {
+
+    // check settings & load jobs
+    if ( !validateSettings() || !loadManifest() || !prepareScratchDirectory() )
+        return false;
+
+    // let interrupts stop waits for -spool workers, so that spool files are cleaned up
+    SpoolInterruptGuard interruptGuard(m_settings.HasSpoolPath);
+
+    // update job settings with validated scratch path
+    for ( size_t i = 0; i < m_jobs.size(); ++i )
+        m_jobs.at(i)->Settings.ScratchPath = m_settings.ScratchPath;
+
+    // determine worker count
+    unsigned int numWorkers = m_settings.NumThreads;
+    if ( numWorkers == 0 )
+        numWorkers = numAvailableProcessors();
+    if ( numWorkers > m_jobs.size() )
+        numWorkers = m_jobs.size();
+
+    if ( m_settings.IsVerbose )
+        cerr << "running " << m_jobs.size() << " job(s) on " << numWorkers << " worker(s)" << endl;
+
+    // start workers (calling thread acts as a worker too)
+    vector<pthread_t> threads(numWorkers);
+    vector<bool> isThreadStarted(numWorkers, false);
+    for ( size_t i = 1; i < numWorkers; ++i )
+        isThreadStarted[i] = ( pthread_create(&threads[i], 0, Scheduler::workerMain, this) == 0 );
+    runWorker();
+    for ( size_t i = 1; i < numWorkers; ++i ) {
+        if ( isThreadStarted[i] )
+            pthread_join(threads[i], 0);
+    }
+
+    // report any failures
+    stringstream s("");
+    bool isOk = true;
+    for ( size_t i = 0; i < m_jobs.size(); ++i ) {
+        const SchedulerJob* job = m_jobs.at(i);
+        assert( job->JobState == SchedulerJob::Done || job->JobState == SchedulerJob::Failed );
+        if ( job->JobState == SchedulerJob::Failed ) {
+            s << endl << "job " << job->Id << " (manifest line " << job->ManifestLine << ") failed: "
+              << job->ErrorString;
+            isOk = false;
+        }
+    }
+    if ( !isOk )
+        m_errorString = s.str();
+    return isOk;
+}
+
+void Scheduler::runWorker(void) {
+
+    SchedulerJob* job = 0;
+    while ( (job = takeNextJob()) != 0 ) {
+
+        bool isOk = true;
+
+        // start job if new, otherwise run its next batch
+        if ( job->Runner == 0 ) {
+            if ( m_settings.IsVerbose )
+                cerr << "starting job " << job->Id << ": " << job->Settings.OutputFilename << endl;
+            job->Runner = new Premo(job->Settings);
+            isOk = job->Runner->start();
+        } else
+            isOk = job->Runner->runBatch();
+
+        // write output once job has converged
+        bool isFinished = !isOk || job->Runner->isFinished();
+        if ( isOk && isFinished )
+            isOk = job->Runner->finish();
+
+        // clean up finished job (removes its generated files)
+        if ( isFinished ) {
+            if ( !isOk )
+                job->ErrorString = job->Runner->errorString();
+            else if ( m_settings.IsVerbose )
+                cerr << "finished job " << job->Id << ": " << job->Settings.OutputFilename << endl;
+            delete job->Runner;
+            job->Runner = 0;
+        }
+
+        releaseJob(job, isFinished, isOk);
+    }
+}
+
+SchedulerJob* Scheduler::takeNextJob(void) {
+
+    pthread_mutex_lock(&m_mutex);
+
+    SchedulerJob* job = 0;
+    const size_t numJobs = m_jobs.size();
+    while ( true ) {
+
+        // prefer the next started job, in round-robin order, so that batches from
+        // different libraries are interleaved & only a few inputs are open at once
+        for ( size_t i = 0; i < numJobs && job == 0; ++i ) {
+            SchedulerJob* candidate = m_jobs.at( (m_nextJobIndex + i) % numJobs );
+            if ( candidate->JobState == SchedulerJob::Ready ) {
+                job = candidate;
+                m_nextJobIndex = (m_nextJobIndex + i + 1) % numJobs;
+            }
+        }
+
+        // otherwise, start a new job (in manifest order)
+        bool isAnyRunning = false;
+        for ( size_t i = 0; i < numJobs && job == 0; ++i ) {
+            SchedulerJob* candidate = m_jobs.at(i);
+            if ( candidate->JobState == SchedulerJob::Pending )
+                job = candidate;
+            else if ( candidate->JobState == SchedulerJob::Running )
+                isAnyRunning = true;
+        }
+
+        // claim job, if found
+        if ( job ) {
+            job->JobState = SchedulerJob::Running;
+            break;
+        }
+
+        // all jobs complete
+        if ( !isAnyRunning )
+            break;
+
+        // otherwise, wait for a running job to be released
+        pthread_cond_wait(&m_jobReleased, &m_mutex);
+    }
+
+    pthread_mutex_unlock(&m_mutex);
+    return job;
+}
+
+bool Scheduler::validateSettings(void) {
+
+    if ( !m_settings.HasManifestFilename || m_settings.ManifestFilename.empty() ) {
+        m_errorString = "\nthe following parameters are missing:\n\t-manifest (job manifest filename)";
+        return false;
+    }
+
+    if ( m_settings.HasFastqFilename1       || m_settings.HasFastqFilename2     ||
+         m_settings.HasOutputFilename       || m_settings.HasAlignedBamFilename ||
+         m_settings.HasUnalignedBamFilename )
+    {
+        m_errorString = "\nthe following parameters are invalid:"
+                        "\n\t-manifest provides input & output files, it cannot be combined with -fq1/-fq2/-out/-ubam/-bam";
+        return false;
+    }
+
+    return true;
+}
+
+void* Scheduler::workerMain(void* scheduler) {
+    static_cast<Scheduler*>(scheduler)->runWorker();
+    return 0;
+}
@@ -0,0 +1,55 @@
+// ***************************************************************************
+// scheduler.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Runs many Premo jobs (from a manifest) on a shared pool of worker threads
+// ***************************************************************************
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "premo_settings.h"
+#include <pthread.h>
+#include <string>
+#include <vector>
+struct SchedulerJob;
+
+class Scheduler {
+
+    // ctor & dtor
+    public:
+        Scheduler(const PremoSettings& settings);
+        ~Scheduler(void);
+
+    // Scheduler interface
+    public:
+        std::string errorString(void) const;
+        bool run(void);   // returns false if manifest is invalid or any job failed
+
+    // internal methods
+    private:
+        bool loadManifest(void);
+        bool prepareScratchDirectory(void);
+        void releaseJob(SchedulerJob* job, const bool isFinished, const bool isOk);
+        void runWorker(void);
+        SchedulerJob* takeNextJob(void); // blocks until a job is available, returns 0 when all done
+        bool validateSettings(void);
+
+        static void* workerMain(void* scheduler);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        std::vector<SchedulerJob*> m_jobs;
+        size_t m_nextJobIndex;
+
+        pthread_mutex_t m_mutex;
+        pthread_cond_t  m_jobReleased;
+
+        bool m_createdScratchDirectory;
+        std::string m_errorString;
+};
+
+#endif // SCHEDULER_H
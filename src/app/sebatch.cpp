@@ -2,7 +2,7 @@
 // sebatch.cpp (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Single-end batch
 // ***************************************************************************
@@ -11,6 +11,7 @@
 #include "fastq.h"
 #include "fastqreader.h"
 #include "premo_settings.h"
+#include "ubamreader.h"
 
 #include <sstream>
 using namespace std;
@@ -22,6 +23,13 @@ using namespace std;
 SingleEndBatch::SingleEndBatch(FastqReader* reader, PremoSettings* settings)
     : Batch(settings)
     , m_reader(reader)
+    , m_bamReader(0)
+{ }
+
+SingleEndBatch::SingleEndBatch(UnalignedBamReader* reader, PremoSettings* settings)
+    : Batch(settings)
+    , m_reader(0)
+    , m_bamReader(reader)
 { }
 
 SingleEndBatch::~SingleEndBatch(void) { }
@@ -30,16 +38,45 @@ Batch::RunStatus SingleEndBatch::run(void) {
 
     // calculate read lengths
     m_result.ReadLengths.reserve(m_settings->BatchSize);
+    StageTimer timer(&m_timings, ( m_bamReader ? "BAM reading" : "FASTQ reading" ));
+    if ( !m_bamReader )
+        m_timings.BytesIn = 0;
 
     // iterate over requested number of entries
     Fastq fasta;
+    int readLength = 0;
     for ( size_t i = 0; i < m_settings->BatchSize; ++i ) {
 
+        // uBAM input - read length available from core data
+        if ( m_bamReader ) {
+
+            // attempt to read from BAM
+            if ( m_bamReader->readNextLength(&readLength) ) {
+                m_result.ReadLengths.push_back(readLength);
+                ++m_timings.NumReads;
+                continue;
+            }
+
+            // handle EOF or empty file
+            if ( m_bamReader->isEOF() )
+                return ( (i != 0) ? Batch::HitEOF : Batch::NoData );
+
+            // for any other error types, build error string & return error
+            stringstream s("");
+            s << "could not read from input BAM file: " << endl
+              << m_bamReader->filename() << endl
+              << "\tbecause: " << m_bamReader->errorString();
+            m_errorString = s.str();
+            return Batch::Error;
+        }
+
         // attempt to read from FASTQ
         if ( m_reader->readNext(&fasta) ) {
 
             // store read length
             m_result.ReadLengths.push_back( static_cast<int>(fasta.Bases.length()) );
+            ++m_timings.NumReads;
+            m_timings.BytesIn += fasta.textLength();
         }
 
         // if failed to read
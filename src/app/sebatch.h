@@ -2,7 +2,7 @@
 // sebatch.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 8 August 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Single-end batch
 // ***************************************************************************
@@ -12,12 +12,14 @@
 
 #include "batch.h"
 class FastqReader;
+class UnalignedBamReader;
 
 class SingleEndBatch : public Batch {
 
     // ctor & dtor
     public:
         SingleEndBatch(FastqReader* reader, PremoSettings* settings);
+        SingleEndBatch(UnalignedBamReader* reader, PremoSettings* settings);
         ~SingleEndBatch(void);
 
     // Batch interface
@@ -27,8 +29,9 @@ class SingleEndBatch : public Batch {
     // data members
     private:
 
-        // copied from main Premo app, not owned
+        // copied from main Premo app, not owned (only one is used)
         FastqReader* m_reader;
+        UnalignedBamReader* m_bamReader;
 };
 
 #endif // SEBATCH_H
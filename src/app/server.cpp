@@ -0,0 +1,539 @@
+// ***************************************************************************
+// server.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Long-lived Premo service, accepting jobs over a Unix domain socket
+// ***************************************************************************
+
+#include "server.h"
+#include "linesocket.h"
+#include "premo.h"
+#include "premo_utils.h"
+
+#include "jsoncpp/json_reader.h"
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+// how often (ms) the accept loop checks for an interrupt
+static const int POLL_INTERVAL = 250;
+
+static volatile sig_atomic_t isInterrupted = 0;
+
+static
+void onInterrupt(int) {
+    isInterrupted = 1;
+}
+
+static
+Json::Value errorResponse(const Json::Value& id, const string& errorString) {
+    Json::Value response(Json::objectValue);
+    response["id"]     = id;
+    response["event"]  = "result";
+    response["status"] = "error";
+    response["error"]  = errorString;
+    return response;
+}
+
+// streams per-batch progress back to the requesting client
+class ProgressWriter : public PremoObserver {
+
+    // ctor & dtor
+    public:
+        ProgressWriter(LineSocket* socket, const Json::Value& id, Premo* runner, const bool isSingleEndMode)
+            : m_socket(socket)
+            , m_id(id)
+            , m_runner(runner)
+            , m_isSingleEndMode(isSingleEndMode)
+        { }
+        ~ProgressWriter(void) { }
+
+    // PremoObserver interface
+    public:
+        void batchFinished(const PremoProgress& progress) {
+
+            Json::Value message(Json::objectValue);
+            message["id"]      = m_id;
+            message["event"]   = "progress";
+            message["batch"]   = progress.BatchNumber;
+            message["overall"] = summaryToJson(progress.Overall, m_isSingleEndMode);
+
+            // stop working on this job if client has gone away
+            Json::FastWriter writer;
+            if ( !m_socket->writeLine(writer.write(message)) )
+                m_runner->cancel();
+        }
+
+    // data members
+    private:
+        LineSocket* m_socket;
+        Json::Value m_id;
+        Premo* m_runner;
+        bool m_isSingleEndMode;
+};
+
+struct ConnectionTask {
+
+    // data members
+    Server* Owner;
+    LineSocket* Socket;
+
+    // ctor
+    ConnectionTask(Server* owner, LineSocket* socket)
+        : Owner(owner)
+        , Socket(socket)
+    { }
+};
+
+// ------------------------
+// Server implementation
+// ------------------------
+
+Server::Server(const PremoSettings& settings)
+    : m_settings(settings)
+    , m_listenDescriptor(-1)
+    , m_createdScratchDirectory(false)
+    , m_maxRunningJobs(1)
+    , m_nextJobId(0)
+    , m_isShuttingDown(false)
+{
+    pthread_mutex_init(&m_mutex, 0);
+    pthread_cond_init(&m_slotReleased, 0);
+}
+
+Server::~Server(void) {
+
+    // stop listening
+    if ( m_listenDescriptor >= 0 ) {
+        close(m_listenDescriptor);
+        unlink(m_settings.ServeSocketFilename.c_str());
+    }
+
+    // remove shared scratch directory, if we created it
+    if ( !m_settings.IsKeepGeneratedFiles && m_createdScratchDirectory )
+        removeDirectory(m_settings.ScratchPath);
+
+    pthread_cond_destroy(&m_slotReleased);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+bool Server::acquireJobSlot(Premo* runner) {
+
+    pthread_mutex_lock(&m_mutex);
+
+    while ( !m_isShuttingDown && m_runningJobs.size() >= m_maxRunningJobs )
+        pthread_cond_wait(&m_slotReleased, &m_mutex);
+
+    const bool isAcquired = !m_isShuttingDown;
+    if ( isAcquired )
+        m_runningJobs.insert(runner);
+
+    pthread_mutex_unlock(&m_mutex);
+    return isAcquired;
+}
+
+bool Server::buildJobSettings(const Json::Value& request,
+                              PremoSettings* settings,
+                              string* errorString)
+{
+    // start from server's settings
+    *settings = m_settings;
+    settings->HasServeSocketFilename = false;
+
+    // apply request's values
+    const Json::Value::Members keys = request.getMemberNames();
+    Json::Value::Members::const_iterator keyIter = keys.begin();
+    Json::Value::Members::const_iterator keyEnd  = keys.end();
+    for ( ; keyIter != keyEnd; ++keyIter ) {
+
+        const string& key = (*keyIter);
+        const Json::Value& value = request[key];
+
+        bool isValueOk = true;
+        if ( key == "id" )
+            continue;
+        else if ( key == "fq1" || key == "fq2" || key == "ubam" || key == "bam" || key == "st" ) {
+            isValueOk = value.isString() && !value.asString().empty();
+            if ( isValueOk ) {
+                if ( key == "fq1" ) {
+                    settings->HasFastqFilename1 = true;
+                    settings->FastqFilename1 = value.asString();
+                } else if ( key == "fq2" ) {
+                    settings->HasFastqFilename2 = true;
+                    settings->FastqFilename2 = value.asString();
+                } else if ( key == "ubam" ) {
+                    settings->HasUnalignedBamFilename = true;
+                    settings->UnalignedBamFilename = value.asString();
+                } else if ( key == "bam" ) {
+                    settings->HasAlignedBamFilename = true;
+                    settings->AlignedBamFilename = value.asString();
+                } else {
+                    settings->HasSeqTech = true;
+                    settings->SeqTech = value.asString();
+                }
+            }
+        }
+        else if ( key == "se" ) {
+            isValueOk = value.isBool();
+            if ( isValueOk )
+                settings->IsSingleEndMode = value.asBool();
+        }
+        else if ( key == "n" ) {
+            isValueOk = ( value.isUInt() || (value.isInt() && value.asInt() > 0) );
+            if ( isValueOk ) {
+                settings->HasBatchSize = true;
+                settings->BatchSize = value.asUInt();
+            }
+        }
+        else {
+            *errorString = "unknown request field: ";
+            errorString->append(key);
+            return false;
+        }
+
+        if ( !isValueOk ) {
+            *errorString = "invalid value for request field: ";
+            errorString->append(key);
+            return false;
+        }
+    }
+
+    // keep each job's generated files apart in the shared -tmp directory
+    pthread_mutex_lock(&m_mutex);
+    const int jobId = m_nextJobId++;
+    pthread_mutex_unlock(&m_mutex);
+
+    stringstream prefix("");
+    prefix << "premo_serve" << jobId << "_batch";
+    settings->BatchFilePrefix = prefix.str();
+    return true;
+}
+
+void* Server::connectionMain(void* data) {
+
+    ConnectionTask* task = static_cast<ConnectionTask*>(data);
+    assert(task);
+
+    task->Owner->handleConnection(task->Socket);
+
+    delete task;
+    return 0;
+}
+
+string Server::errorString(void) const {
+    return m_errorString;
+}
+
+void Server::handleConnection(LineSocket* socket) {
+
+    // run requests in order, until client disconnects
+    string line;
+    while ( socket->readLine(&line) ) {
+        if ( !line.empty() )
+            handleRequest(socket, line);
+    }
+
+    // N.B. - unregister before closing, so that shutdown() never touches a reused descriptor
+    pthread_mutex_lock(&m_mutex);
+    m_connectionDescriptors.erase(socket->descriptor());
+    m_finishedConnectionThreads.push_back(pthread_self());
+    pthread_mutex_unlock(&m_mutex);
+
+    delete socket;
+}
+
+void Server::handleRequest(LineSocket* socket, const string& line) {
+
+    Json::FastWriter writer;
+
+    // parse request
+    Json::Reader reader;
+    Json::Value request;
+    if ( !reader.parse(line, request) || !request.isObject() ) {
+        string error = "invalid request, expected a JSON object";
+        if ( !reader.getFormatedErrorMessages().empty() ) {
+            error.append(": ");
+            error.append(reader.getFormatedErrorMessages());
+        }
+        socket->writeLine(writer.write(errorResponse(Json::Value(), error)));
+        return;
+    }
+
+    const Json::Value id = request.get("id", Json::Value());
+
+    // set up job
+    PremoSettings jobSettings;
+    string error;
+    if ( !buildJobSettings(request, &jobSettings, &error) ) {
+        socket->writeLine(writer.write(errorResponse(id, error)));
+        return;
+    }
+
+    Premo runner(jobSettings);
+    ProgressWriter progress(socket, id, &runner, jobSettings.IsSingleEndMode);
+    runner.setObserver(&progress);
+
+    // run job, once there's room
+    if ( !acquireJobSlot(&runner) ) {
+        socket->writeLine(writer.write(errorResponse(id, "server is shutting down")));
+        return;
+    }
+
+    if ( m_settings.IsVerbose )
+        cerr << "starting job: " << writer.write(request);
+
+    PremoResult result;
+    const bool isOk = runner.estimate(&result);
+    releaseJobSlot(&runner);
+
+    if ( m_settings.IsVerbose )
+        cerr << "finished job: " << ( isOk ? "OK" : runner.errorString() ) << endl;
+
+    // send result
+    if ( !isOk ) {
+        socket->writeLine(writer.write(errorResponse(id, runner.errorString())));
+        return;
+    }
+
+    Json::Value response(Json::objectValue);
+    response["id"]     = id;
+    response["event"]  = "result";
+    response["status"] = "ok";
+    runner.toJson(&response["output"]);
+    socket->writeLine(writer.write(response));
+}
+
+// joins connection threads whose clients have disconnected, so that a long-running
+// server does not keep a thread (& its stack) for every connection it has served
+void Server::joinFinishedConnections(void) {
+
+    pthread_mutex_lock(&m_mutex);
+    vector<pthread_t> finishedThreads;
+    finishedThreads.swap(m_finishedConnectionThreads);
+    pthread_mutex_unlock(&m_mutex);
+
+    for ( size_t i = 0; i < finishedThreads.size(); ++i ) {
+        const pthread_t thread = finishedThreads.at(i);
+        pthread_join(thread, 0);
+
+        vector<pthread_t>::iterator threadIter = m_connectionThreads.begin();
+        vector<pthread_t>::iterator threadEnd  = m_connectionThreads.end();
+        for ( ; threadIter != threadEnd; ++threadIter ) {
+            if ( pthread_equal(*threadIter, thread) ) {
+                m_connectionThreads.erase(threadIter);
+                break;
+            }
+        }
+    }
+}
+
+bool Server::listen(void) {
+
+    const string& filename = m_settings.ServeSocketFilename;
+
+    struct sockaddr_un address;
+    if ( !makeSocketAddress(filename, &address) ) {
+        m_errorString = "socket filename is too long: ";
+        m_errorString.append(filename);
+        return false;
+    }
+
+    // remove a stale socket left by an earlier server (but never a live socket, or any other file)
+    struct stat st;
+    if ( stat(filename.c_str(), &st) == 0 ) {
+
+        if ( !S_ISSOCK(st.st_mode) ) {
+            m_errorString = "file exists & is not a socket: ";
+            m_errorString.append(filename);
+            return false;
+        }
+
+        LineSocket probe;
+        if ( probe.connect(filename) ) {
+            m_errorString = "another server is already listening on: ";
+            m_errorString.append(filename);
+            return false;
+        }
+
+        unlink(filename.c_str());
+    }
+
+    // create, bind & listen
+    const int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( descriptor < 0 ) {
+        m_errorString = "could not create socket: ";
+        m_errorString.append(strerror(errno));
+        return false;
+    }
+
+    if ( bind(descriptor, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+         ::listen(descriptor, SOMAXCONN) != 0 )
+    {
+        m_errorString = "could not listen on socket: ";
+        m_errorString.append(filename);
+        m_errorString.append(" - ");
+        m_errorString.append(strerror(errno));
+        close(descriptor);
+        return false;
+    }
+
+    m_listenDescriptor = descriptor;
+    return true;
+}
+
+bool Server::prepareScratchDirectory(void) {
+
+    // jobs report a missing -tmp themselves
+    if ( !m_settings.HasScratchPath || m_settings.ScratchPath.empty() )
+        return true;
+
+    // create it once, shared by all jobs for the lifetime of the server
+    if ( !prepareDirectory(&m_settings.ScratchPath, &m_createdScratchDirectory) ) {
+        m_errorString = "could not create the directory specified by -tmp. Be sure you have mkdir permissions";
+        return false;
+    }
+    return true;
+}
+
+void Server::releaseJobSlot(Premo* runner) {
+    pthread_mutex_lock(&m_mutex);
+    m_runningJobs.erase(runner);
+    pthread_cond_broadcast(&m_slotReleased);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+bool Server::run(void) {
+
+    // check settings & set up shared state
+    if ( !validateSettings() || !prepareScratchDirectory() || !listen() )
+        return false;
+
+    m_maxRunningJobs = m_settings.NumThreads;
+    if ( m_maxRunningJobs == 0 )
+        m_maxRunningJobs = numAvailableProcessors();
+
+    // catch interrupts, so that we can clean up
+    struct sigaction action;
+    struct sigaction oldIntAction;
+    struct sigaction oldTermAction;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onInterrupt;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT,  &action, &oldIntAction);
+    sigaction(SIGTERM, &action, &oldTermAction);
+
+    if ( m_settings.IsVerbose )
+        cerr << "serving on " << m_settings.ServeSocketFilename
+             << " (up to " << m_maxRunningJobs << " concurrent job(s))" << endl;
+
+    // accept connections until interrupted
+    while ( !isInterrupted ) {
+
+        // clean up after disconnected clients
+        joinFinishedConnections();
+
+        struct pollfd listener;
+        listener.fd      = m_listenDescriptor;
+        listener.events  = POLLIN;
+        listener.revents = 0;
+        if ( poll(&listener, 1, POLL_INTERVAL) <= 0 )
+            continue;
+
+        const int descriptor = accept(m_listenDescriptor, 0, 0);
+        if ( descriptor < 0 )
+            continue;
+
+        // hand off to a connection thread
+        LineSocket* socket = new LineSocket(descriptor);
+        ConnectionTask* task = new ConnectionTask(this, socket);
+
+        pthread_mutex_lock(&m_mutex);
+        m_connectionDescriptors.insert(descriptor);
+        pthread_t thread;
+        if ( pthread_create(&thread, 0, Server::connectionMain, task) == 0 )
+            m_connectionThreads.push_back(thread);
+        else {
+            m_connectionDescriptors.erase(descriptor);
+            delete socket;
+            delete task;
+        }
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    if ( m_settings.IsVerbose )
+        cerr << "shutting down" << endl;
+
+    shutdown();
+
+    sigaction(SIGINT,  &oldIntAction,  0);
+    sigaction(SIGTERM, &oldTermAction, 0);
+    return true;
+}
+
+void Server::shutdown(void) {
+
+    // cancel running jobs & disconnect clients
+    pthread_mutex_lock(&m_mutex);
+    m_isShuttingDown = true;
+
+    set<Premo*>::iterator jobIter = m_runningJobs.begin();
+    set<Premo*>::iterator jobEnd  = m_runningJobs.end();
+    for ( ; jobIter != jobEnd; ++jobIter )
+        (*jobIter)->cancel();
+
+    set<int>::iterator descriptorIter = m_connectionDescriptors.begin();
+    set<int>::iterator descriptorEnd  = m_connectionDescriptors.end();
+    for ( ; descriptorIter != descriptorEnd; ++descriptorIter )
+        ::shutdown(*descriptorIter, SHUT_RD);
+
+    pthread_cond_broadcast(&m_slotReleased);
+    pthread_mutex_unlock(&m_mutex);
+
+    // wait for connection threads to finish
+    // (N.B. - a job already inside a batch finishes that batch first)
+    for ( size_t i = 0; i < m_connectionThreads.size(); ++i )
+        pthread_join(m_connectionThreads.at(i), 0);
+    m_connectionThreads.clear();
+    m_finishedConnectionThreads.clear();
+}
+
+bool Server::validateSettings(void) {
+
+    if ( !m_settings.HasServeSocketFilename || m_settings.ServeSocketFilename.empty() ) {
+        m_errorString = "\nthe following parameters are missing:\n\t-serve (socket filename)";
+        return false;
+    }
+
+    if ( m_settings.HasFastqFilename1       || m_settings.HasFastqFilename2     ||
+         m_settings.HasOutputFilename       || m_settings.HasAlignedBamFilename ||
+         m_settings.HasUnalignedBamFilename || m_settings.HasManifestFilename   ||
+         m_settings.HasSubmitSocketFilename )
+    {
+        m_errorString = "\nthe following parameters are invalid:"
+                        "\n\t-serve takes input files from each request, it cannot be combined with "
+                        "-fq1/-fq2/-out/-ubam/-bam/-manifest/-submit";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,86 @@
+// ***************************************************************************
+// server.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Long-lived Premo service, accepting jobs over a Unix domain socket
+// ***************************************************************************
+
+#ifndef SERVER_H
+#define SERVER_H
+
+// Protocol - one JSON object per line, in both directions
+//
+//   request:  { "id" : <any>, "fq1" : <file>, "fq2" : <file> }
+//             optional: "ubam" or "bam" (instead of "fq1"/"fq2"), "se", "st", "n"
+//
+//   response: { "id" : <any>, "event" : "progress", "batch" : <int>, "overall" : {...} }  (after each batch)
+//             { "id" : <any>, "event" : "result", "status" : "ok", "output" : {...} }   (output file contents)
+//             { "id" : <any>, "event" : "result", "status" : "error", "error" : <msg> }
+//
+// Requests on one connection are run in order, separate connections run concurrently
+// (up to -t jobs at once). Jobs share the server's other settings & -tmp directory.
+
+#include "premo_settings.h"
+#include <pthread.h>
+#include <set>
+#include <string>
+#include <vector>
+class LineSocket;
+class Premo;
+
+namespace Json {
+    class Value;
+} // namespace Json
+
+class Server {
+
+    // ctor & dtor
+    public:
+        Server(const PremoSettings& settings);
+        ~Server(void);
+
+    // Server interface
+    public:
+        std::string errorString(void) const;
+        bool run(void);   // serves jobs until interrupted (SIGINT/SIGTERM)
+
+    // internal methods
+    private:
+        bool acquireJobSlot(Premo* runner);
+        bool buildJobSettings(const Json::Value& request, PremoSettings* settings, std::string* errorString);
+        void handleConnection(LineSocket* socket);
+        void handleRequest(LineSocket* socket, const std::string& line);
+        void joinFinishedConnections(void);
+        bool listen(void);
+        bool prepareScratchDirectory(void);
+        void releaseJobSlot(Premo* runner);
+        void shutdown(void);
+        bool validateSettings(void);
+
+        static void* connectionMain(void* data);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        int m_listenDescriptor;
+        bool m_createdScratchDirectory;
+
+        // shared state, guarded by m_mutex
+        pthread_mutex_t m_mutex;
+        pthread_cond_t  m_slotReleased;
+        unsigned int m_maxRunningJobs;
+        std::set<Premo*> m_runningJobs;
+        std::set<int> m_connectionDescriptors;
+        std::vector<pthread_t> m_finishedConnectionThreads;  // not yet joined
+        int m_nextJobId;
+        bool m_isShuttingDown;
+
+        // connection threads not yet joined (only used by accepting thread)
+        std::vector<pthread_t> m_connectionThreads;
+
+        std::string m_errorString;
+};
+
+#endif // SERVER_H
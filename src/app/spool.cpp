@@ -0,0 +1,762 @@
+// ***************************************************************************
+// spool.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Spool directory batch distribution (-spool coordinator, -worker processes)
+// ***************************************************************************
+
+#include "spool.h"
+#include "pebatch.h"
+#include "premo.h"
+#include "premo_utils.h"
+#include "telemetry.h"
+
+#include "jsoncpp/json_reader.h"
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+static const string JOB_SUFFIX     = ".job";
+static const string CLAIMED_SUFFIX = ".claimed";
+static const string RESULT_SUFFIX  = ".result";
+static const string TEMP_SUFFIX    = ".tmp";
+static const string WORKER_SUFFIX  = ".worker";
+
+// how long (microseconds) an idle worker waits before checking the spool again
+static const useconds_t POLL_INTERVAL = 200000;
+
+// how long (microseconds) a coordinator waits between checks for its batch's result
+static const useconds_t RESULT_POLL_INTERVAL = 100000;
+
+// workers renew their leases this often (seconds)
+static const unsigned int LEASE_RENEWAL_INTERVAL = 5;
+
+// a lease not renewed for this long (seconds) belongs to a worker that has stopped
+static const double LEASE_TIMEOUT = 60.0;
+
+static volatile sig_atomic_t isInterrupted = 0;
+
+static
+void onInterrupt(int) {
+    isInterrupted = 1;
+}
+
+static inline
+bool endsWith(const string& str, const string& query) {
+    return ( str.length() >= query.length() ) &&
+           ( str.compare(str.length() - query.length(), query.length(), query) == 0 );
+}
+
+static inline
+bool fileExists(const string& filename) {
+    return ( access(filename.c_str(), F_OK) == 0 );
+}
+
+// returns file's last change time, by the file server's clock (0 if file is missing)
+// N.B. - renames & touches both update it
+static
+time_t changeTime(const string& filename) {
+    struct stat info;
+    if ( stat(filename.c_str(), &info) != 0 )
+        return 0;
+    return max(info.st_ctime, info.st_mtime);
+}
+
+static
+string hostName(void) {
+    char name[256];
+    if ( gethostname(name, sizeof(name)) != 0 )
+        strcpy(name, "localhost");
+    name[sizeof(name) - 1] = '\0';
+    return string(name);
+}
+
+// returns latest change time of any worker presence file in spool directory (0 if none)
+static
+time_t latestWorkerRenewal(const string& spoolPath) {
+
+    DIR* directory = opendir(spoolPath.c_str());
+    if ( directory == NULL )
+        return 0;
+
+    time_t latest = 0;
+    struct dirent* entry = NULL;
+    while ( (entry = readdir(directory)) != NULL ) {
+        const string filename = entry->d_name;
+        if ( endsWith(filename, WORKER_SUFFIX) )
+            latest = max(latest, changeTime(spoolPath + filename));
+    }
+    closedir(directory);
+    return latest;
+}
+
+// removes presence files left by this host's workers that were killed (no longer running)
+static
+void removeDeadWorkerFiles(const string& spoolPath) {
+
+    DIR* directory = opendir(spoolPath.c_str());
+    if ( directory == NULL )
+        return;
+
+    const string hostPrefix = hostName() + "_";
+    vector<string> deadFilenames;
+    struct dirent* entry = NULL;
+    while ( (entry = readdir(directory)) != NULL ) {
+        const string filename = entry->d_name;
+        if ( !endsWith(filename, WORKER_SUFFIX) || filename.compare(0, hostPrefix.length(), hostPrefix) != 0 )
+            continue;
+        const string pidString = filename.substr(hostPrefix.length(), filename.length() - hostPrefix.length() - WORKER_SUFFIX.length());
+        const pid_t pid = atoi(pidString.c_str());
+        if ( pid > 0 && kill(pid, 0) != 0 && errno == ESRCH )
+            deadFilenames.push_back(filename);
+    }
+    closedir(directory);
+
+    for ( size_t i = 0; i < deadFilenames.size(); ++i )
+        remove( (spoolPath + deadFilenames.at(i)).c_str() );
+}
+
+// removes results that no coordinator will collect (neither queued nor claimed, & older than LEASE_TIMEOUT)
+// N.B. - now is a recently touched file's change time, so that ages are measured by the file server's clock
+static
+void removeOrphanedResults(const string& spoolPath, const time_t now) {
+
+    DIR* directory = opendir(spoolPath.c_str());
+    if ( directory == NULL )
+        return;
+
+    vector<string> orphanedFilenames;
+    struct dirent* entry = NULL;
+    while ( (entry = readdir(directory)) != NULL ) {
+        const string filename = entry->d_name;
+        if ( !endsWith(filename, RESULT_SUFFIX) )
+            continue;
+        const string stem = spoolPath + filename.substr(0, filename.length() - RESULT_SUFFIX.length());
+        const time_t resultChange = changeTime(spoolPath + filename);
+        if ( resultChange != 0 &&
+             difftime(now, resultChange) > LEASE_TIMEOUT &&
+             !fileExists(stem + JOB_SUFFIX) &&
+             !fileExists(stem + CLAIMED_SUFFIX) )
+        {
+            orphanedFilenames.push_back(filename);
+        }
+    }
+    closedir(directory);
+
+    for ( size_t i = 0; i < orphanedFilenames.size(); ++i )
+        remove( (spoolPath + orphanedFilenames.at(i)).c_str() );
+}
+
+// tracks renewals of a lease file, timing them by our own clock
+// (so that the file server's clock may differ from ours)
+struct LeaseWatch {
+
+    // data members
+    time_t LastChange;    // file's change time, by file server's clock
+    double LastRenewal;   // when that change was first seen, by our clock
+
+    // ctor
+    LeaseWatch(void)
+        : LastChange(0)
+        , LastRenewal(wallTime())
+    { }
+
+    // returns true if lease has not been renewed within LEASE_TIMEOUT
+    bool isExpired(const time_t changeTime) {
+        const double now = wallTime();
+        if ( changeTime != LastChange ) {
+            LastChange  = changeTime;
+            LastRenewal = now;
+            return false;
+        }
+        return ( now - LastRenewal > LEASE_TIMEOUT );
+    }
+};
+
+static
+bool readJsonFile(const string& filename, Json::Value* root, string* errorString) {
+
+    ifstream file(filename.c_str());
+    if ( !file ) {
+        *errorString = "could not open spool file: ";
+        errorString->append(filename);
+        return false;
+    }
+
+    Json::Reader reader;
+    if ( !reader.parse(file, *root) || !root->isObject() ) {
+        *errorString = "could not parse spool file: ";
+        errorString->append(filename);
+        errorString->append("\n\t");
+        errorString->append(reader.getFormatedErrorMessages());
+        return false;
+    }
+
+    return true;
+}
+
+// writes to <filename>.tmp, then renames into place
+static
+bool writeJsonFile(const string& filename, const Json::Value& root, string* errorString) {
+
+    const string tempFilename = filename + TEMP_SUFFIX;
+
+    ofstream file(tempFilename.c_str());
+    if ( !file ) {
+        *errorString = "could not create spool file: ";
+        errorString->append(tempFilename);
+        return false;
+    }
+
+    Json::FastWriter writer;
+    file << writer.write(root);
+    file.close();
+
+    if ( !file || rename(tempFilename.c_str(), filename.c_str()) != 0 ) {
+        *errorString = "could not write spool file: ";
+        errorString->append(filename);
+        remove(tempFilename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+static
+Json::Value toJsonArray(const vector<int>& values) {
+    Json::Value array(Json::arrayValue);
+    for ( size_t i = 0; i < values.size(); ++i )
+        array.append(values.at(i));
+    return array;
+}
+
+static
+bool fromJsonArray(const Json::Value& array, vector<int>* values) {
+
+    if ( !array.isArray() )
+        return false;
+
+    values->clear();
+    values->reserve(array.size());
+    for ( Json::Value::UInt i = 0; i < array.size(); ++i ) {
+        if ( !array[i].isInt() && !array[i].isUInt() )
+            return false;
+        values->push_back( array[i].asInt() );
+    }
+    return true;
+}
+
+// -------------------------
+// spool file formats
+// -------------------------
+
+string spoolStem(const string& batchFilePrefix, const int batchNumber) {
+    stringstream s("");
+    s << hostName() << "_" << getpid() << "_" << batchFilePrefix << batchNumber;
+    return s.str();
+}
+
+bool readSpoolJob(const string& filename, SpoolJob* job, string* errorString) {
+
+    Json::Value root;
+    if ( !readJsonFile(filename, &root, errorString) )
+        return false;
+
+    if ( !root["fq1"].isString() || !root["fq2"].isString() || !root["st"].isString() ||
+         !root["hs"].isIntegral() || !root["mhp"].isIntegral() || !root["mmp"].isNumeric() )
+    {
+        *errorString = "invalid spool job file: ";
+        errorString->append(filename);
+        return false;
+    }
+
+    job->Fastq1   = root["fq1"].asString();
+    job->Fastq2   = root["fq2"].asString();
+    job->NumPairs = root.get("n", 0).asUInt();
+    job->SeqTech  = root["st"].asString();
+    job->HashSize = root["hs"].asUInt();
+    job->Mhp      = root["mhp"].asUInt();
+    job->Mmp      = root["mmp"].asDouble();
+    return true;
+}
+
+bool writeSpoolJob(const string& filename, const SpoolJob& job, string* errorString) {
+
+    Json::Value root(Json::objectValue);
+    root["fq1"] = job.Fastq1;
+    root["fq2"] = job.Fastq2;
+    root["n"]   = job.NumPairs;
+    root["st"]  = job.SeqTech;
+    root["hs"]  = job.HashSize;
+    root["mhp"] = job.Mhp;
+    root["mmp"] = job.Mmp;
+    return writeJsonFile(filename, root, errorString);
+}
+
+bool readSpoolResult(const string& filename, Result* result, string* errorString) {
+
+    Json::Value root;
+    if ( !readJsonFile(filename, &root, errorString) )
+        return false;
+
+    // worker failed
+    if ( root.get("status", "").asString() != "ok" ) {
+        *errorString = "spool worker failed: ";
+        errorString->append(root.get("error", "unknown error").asString());
+        return false;
+    }
+
+    if ( !fromJsonArray(root["fragment lengths"], &result->FragmentLengths) ||
+         !fromJsonArray(root["read lengths"],     &result->ReadLengths) )
+    {
+        *errorString = "invalid spool result file: ";
+        errorString->append(filename);
+        return false;
+    }
+    result->NumUnpairedMates = root.get("unpaired mates", 0).asUInt();
+
+    return true;
+}
+
+bool writeSpoolResult(const string& filename, const Result& result, string* errorString) {
+    Json::Value root(Json::objectValue);
+    root["status"]           = "ok";
+    root["fragment lengths"] = toJsonArray(result.FragmentLengths);
+    root["read lengths"]     = toJsonArray(result.ReadLengths);
+    root["unpaired mates"]   = static_cast<Json::UInt>(result.NumUnpairedMates);
+    return writeJsonFile(filename, root, errorString);
+}
+
+bool writeSpoolError(const string& filename, const string& workerError, string* errorString) {
+    Json::Value root(Json::objectValue);
+    root["status"] = "error";
+    root["error"]  = workerError;
+    return writeJsonFile(filename, root, errorString);
+}
+
+// -----------------------------
+// coordinator
+// -----------------------------
+
+void removeSpoolJob(const string& stem) {
+    remove( (stem + JOB_SUFFIX).c_str() );
+    remove( (stem + JOB_SUFFIX + TEMP_SUFFIX).c_str() );
+    remove( (stem + CLAIMED_SUFFIX).c_str() );
+    remove( (stem + RESULT_SUFFIX).c_str() );
+    remove( (stem + RESULT_SUFFIX + TEMP_SUFFIX).c_str() );
+}
+
+bool runSpoolJob(const string& stem,
+                 const SpoolJob& job,
+                 const unsigned int timeout,
+                 const Premo* runner,
+                 Result* result,
+                 string* errorString)
+{
+    const string jobFilename     = stem + JOB_SUFFIX;
+    const string claimedFilename = stem + CLAIMED_SUFFIX;
+    const string resultFilename  = stem + RESULT_SUFFIX;
+    const string spoolPath       = stem.substr(0, stem.rfind('/') + 1);
+
+    // publish job
+    if ( !writeSpoolJob(jobFilename, job, errorString) )
+        return false;
+
+    const double startTime = wallTime();
+    double lastWorkerCheck = 0.0;
+    LeaseWatch claimLease;
+    LeaseWatch workerLease;
+
+    // wait for a worker to publish its result
+    while ( !fileExists(resultFilename) ) {
+
+        // stop waiting if cancelled or out of time
+        if ( isInterrupted || (runner && runner->isCancelled()) ) {
+            *errorString = "cancelled while waiting for a spool worker";
+            removeSpoolJob(stem);
+            return false;
+        }
+
+        if ( timeout > 0 && wallTime() - startTime > timeout ) {
+            stringstream s("");
+            s << "no spool worker result after " << timeout << " seconds (see -spool-timeout) for: " << jobFilename;
+            *errorString = s.str();
+            removeSpoolJob(stem);
+            return false;
+        }
+
+        // if claimed, requeue job if its worker stopped renewing the claim
+        // (should it have just finished after all, its result still wins)
+        const time_t claimChange = changeTime(claimedFilename);
+        if ( claimChange != 0 ) {
+            if ( claimLease.isExpired(claimChange) ) {
+                rename(claimedFilename.c_str(), jobFilename.c_str());
+                claimLease = LeaseWatch();
+            }
+        }
+
+        // if queued, make sure some worker is alive to claim it
+        else if ( fileExists(jobFilename) ) {
+            if ( wallTime() - lastWorkerCheck >= LEASE_RENEWAL_INTERVAL ) {
+                lastWorkerCheck = wallTime();
+                if ( workerLease.isExpired(latestWorkerRenewal(spoolPath)) ) {
+                    *errorString = "no spool workers are running in: ";
+                    errorString->append(spoolPath);
+                    removeSpoolJob(stem);
+                    return false;
+                }
+            }
+        }
+
+        // neither queued nor claimed (nor finished, re-checked to skip a worker publishing
+        // its result right now) - a requeued job's original worker removed the new claim
+        else if ( !fileExists(resultFilename) ) {
+            if ( !writeSpoolJob(jobFilename, job, errorString) ) {
+                removeSpoolJob(stem);
+                return false;
+            }
+        }
+
+        usleep(RESULT_POLL_INTERVAL);
+    }
+
+    // load result
+    const bool isOk = readSpoolResult(resultFilename, result, errorString);
+    removeSpoolJob(stem);
+    return isOk;
+}
+
+// -----------------------------
+// SpoolInterruptGuard
+// -----------------------------
+
+SpoolInterruptGuard::SpoolInterruptGuard(const bool isEnabled)
+    : m_isEnabled(isEnabled)
+{
+    if ( !m_isEnabled )
+        return;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onInterrupt;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT,  &action, &m_oldIntAction);
+    sigaction(SIGTERM, &action, &m_oldTermAction);
+}
+
+SpoolInterruptGuard::~SpoolInterruptGuard(void) {
+    if ( m_isEnabled ) {
+        sigaction(SIGINT,  &m_oldIntAction,  0);
+        sigaction(SIGTERM, &m_oldTermAction, 0);
+    }
+}
+
+// -----------------------------
+// SpoolWorker implementation
+// -----------------------------
+
+SpoolWorker::SpoolWorker(const PremoSettings& settings)
+    : m_settings(settings)
+    , m_createdScratchDirectory(false)
+    , m_isStopping(false)
+{
+    pthread_mutex_init(&m_leaseMutex, 0);
+}
+
+SpoolWorker::~SpoolWorker(void) {
+
+    // remove scratch directory, if we created it
+    if ( !m_settings.IsKeepGeneratedFiles && m_createdScratchDirectory )
+        removeDirectory(m_settings.ScratchPath);
+
+    pthread_mutex_destroy(&m_leaseMutex);
+}
+
+bool SpoolWorker::claimNextJob(string* stem) {
+
+    const string& spoolPath = m_settings.WorkerSpoolPath;
+
+    // list published jobs
+    DIR* directory = opendir(spoolPath.c_str());
+    if ( directory == NULL )
+        return false;
+
+    vector<string> jobFilenames;
+    struct dirent* entry = NULL;
+    while ( (entry = readdir(directory)) != NULL ) {
+        const string filename = entry->d_name;
+        if ( endsWith(filename, JOB_SUFFIX) )
+            jobFilenames.push_back(filename);
+    }
+    closedir(directory);
+
+    // claim the oldest-named job we can, another worker may beat us to any of them
+    sort(jobFilenames.begin(), jobFilenames.end());
+    for ( size_t i = 0; i < jobFilenames.size(); ++i ) {
+
+        const string& filename = jobFilenames.at(i);
+        const string jobStem = filename.substr(0, filename.length() - JOB_SUFFIX.length());
+        const string jobPath     = spoolPath + filename;
+        const string claimedPath = spoolPath + jobStem + CLAIMED_SUFFIX;
+
+        // N.B. - rename updates the claim's change time, so its lease starts now
+        if ( rename(jobPath.c_str(), claimedPath.c_str()) == 0 ) {
+            setClaimedFilename(claimedPath);
+            *stem = jobStem;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+string SpoolWorker::errorString(void) const {
+    return m_errorString;
+}
+
+void* SpoolWorker::heartbeatMain(void* worker) {
+    static_cast<SpoolWorker*>(worker)->renewLeases();
+    return 0;
+}
+
+void SpoolWorker::processJob(const string& stem) {
+
+    const string jobPath     = m_settings.WorkerSpoolPath + stem + JOB_SUFFIX;
+    const string claimedPath = m_settings.WorkerSpoolPath + stem + CLAIMED_SUFFIX;
+    const string resultPath  = m_settings.WorkerSpoolPath + stem + RESULT_SUFFIX;
+
+    if ( m_settings.IsVerbose )
+        cerr << "claimed job: " << stem << endl;
+
+    string jobError;
+    bool isOk = true;
+    Result result;
+
+    // load job
+    SpoolJob job;
+    if ( !readSpoolJob(claimedPath, &job, &jobError) )
+        isOk = false;
+
+    // align batch, using job's Mosaik settings & our own installation
+    else {
+        PremoSettings jobSettings = m_settings;
+        jobSettings.SeqTech  = job.SeqTech;
+        jobSettings.HashSize = job.HashSize;
+        jobSettings.Mhp      = job.Mhp;
+        jobSettings.Mmp      = job.Mmp;
+        if ( job.NumPairs != 0 )
+            jobSettings.BatchSize = job.NumPairs;
+        jobSettings.BatchFilePrefix = stem + "_";
+
+        PairedEndBatch batch(job.Fastq1, job.Fastq2, &jobSettings);
+        const Batch::RunStatus status = batch.run();
+        if ( status == Batch::Error ) {
+            jobError = batch.errorString();
+            if ( jobError.empty() )
+                jobError = "Mosaik pipeline failed";
+            isOk = false;
+        } else
+            result = batch.result();
+    }
+
+    setClaimedFilename("");
+
+    // skip result if coordinator gave up on job (no longer queued or claimed by anyone)
+    if ( !fileExists(claimedPath) && !fileExists(jobPath) ) {
+        if ( m_settings.IsVerbose )
+            cerr << "dropped job: " << stem << " (abandoned by coordinator)" << endl;
+        return;
+    }
+
+    // publish result
+    string error;
+    const bool isWritten = ( isOk ? writeSpoolResult(resultPath, result, &error)
+                                  : writeSpoolError(resultPath, jobError, &error) );
+    if ( !isWritten )
+        cerr << "premo ERROR: " << error << endl;
+
+    // coordinator may have given up while we were publishing (its clean-up removes our claim too)
+    else if ( !fileExists(claimedPath) && !fileExists(jobPath) ) {
+        remove(resultPath.c_str());
+        if ( m_settings.IsVerbose )
+            cerr << "dropped job: " << stem << " (abandoned by coordinator)" << endl;
+    }
+
+    else if ( m_settings.IsVerbose )
+        cerr << "finished job: " << stem << ( isOk ? "" : " (failed)" ) << endl;
+
+    remove(claimedPath.c_str());
+}
+
+// touches worker & claim files every LEASE_RENEWAL_INTERVAL, until worker stops
+void SpoolWorker::renewLeases(void) {
+
+    const unsigned int pollsPerRenewal = LEASE_RENEWAL_INTERVAL * 1000000 / POLL_INTERVAL;
+    for ( unsigned int i = 0; ; ++i ) {
+
+        pthread_mutex_lock(&m_leaseMutex);
+        const bool isStopping = m_isStopping;
+        if ( !isStopping && (i % pollsPerRenewal == 0) ) {
+            utime(m_workerFilename.c_str(), 0);
+            if ( !m_claimedFilename.empty() )
+                utime(m_claimedFilename.c_str(), 0);
+        }
+        pthread_mutex_unlock(&m_leaseMutex);
+
+        if ( isStopping )
+            return;
+        usleep(POLL_INTERVAL);
+    }
+}
+
+bool SpoolWorker::run(void) {
+
+    // check settings & set up scratch directory
+    if ( !validateSettings() )
+        return false;
+
+    if ( !prepareDirectory(&m_settings.ScratchPath, &m_createdScratchDirectory) ) {
+        m_errorString = "could not create the directory specified by -tmp. Be sure you have mkdir permissions";
+        return false;
+    }
+
+    // catch interrupts, so that we can clean up
+    SpoolInterruptGuard interruptGuard(true);
+
+    // announce ourselves to coordinators & start renewing leases
+    removeDeadWorkerFiles(m_settings.WorkerSpoolPath);
+    stringstream s("");
+    s << m_settings.WorkerSpoolPath << hostName() << "_" << getpid() << WORKER_SUFFIX;
+    m_workerFilename = s.str();
+    ofstream workerFile(m_workerFilename.c_str());
+    if ( !workerFile ) {
+        m_errorString = "could not create worker file in spool directory: ";
+        m_errorString.append(m_workerFilename);
+        return false;
+    }
+    workerFile.close();
+
+    pthread_t heartbeatThread;
+    if ( pthread_create(&heartbeatThread, 0, SpoolWorker::heartbeatMain, this) != 0 ) {
+        m_errorString = "could not start lease renewal thread";
+        remove(m_workerFilename.c_str());
+        return false;
+    }
+
+    if ( m_settings.IsVerbose )
+        cerr << "watching spool directory: " << m_settings.WorkerSpoolPath << endl;
+
+    // process jobs until interrupted, sweeping up uncollected results while idle
+    // (N.B. - a claimed job is always finished first)
+    const unsigned int pollsPerSweep = LEASE_RENEWAL_INTERVAL * 1000000 / POLL_INTERVAL;
+    string stem;
+    for ( unsigned int i = 0; !isInterrupted; ++i ) {
+        if ( claimNextJob(&stem) )
+            processJob(stem);
+        else {
+            if ( i % pollsPerSweep == 0 )
+                removeOrphanedResults(m_settings.WorkerSpoolPath, changeTime(m_workerFilename));
+            usleep(POLL_INTERVAL);
+        }
+    }
+
+    // stop renewing leases
+    pthread_mutex_lock(&m_leaseMutex);
+    m_isStopping = true;
+    pthread_mutex_unlock(&m_leaseMutex);
+    pthread_join(heartbeatThread, 0);
+    remove(m_workerFilename.c_str());
+    return true;
+}
+
+void SpoolWorker::setClaimedFilename(const string& filename) {
+    pthread_mutex_lock(&m_leaseMutex);
+    m_claimedFilename = filename;
+    pthread_mutex_unlock(&m_leaseMutex);
+}
+
+bool SpoolWorker::validateSettings(void) {
+
+    stringstream missing("");
+    bool hasMissing = false;
+
+    if ( !m_settings.HasAnnPeFilename || m_settings.AnnPeFilename.empty() ) {
+        missing << endl << "\t-annpe (paired-end neural network filename)";
+        hasMissing = true;
+    }
+
+    if ( !m_settings.HasAnnSeFilename || m_settings.AnnSeFilename.empty() ) {
+        missing << endl << "\t-annse (single-end neural network filename)";
+        hasMissing = true;
+    }
+
+    if ( !m_settings.HasMosaikPath || m_settings.MosaikPath.empty() ) {
+        missing << endl << "\t-mosaik (path/to/Mosaik/bin)";
+        hasMissing = true;
+    } else if ( !endsWith(m_settings.MosaikPath, "/") )
+        m_settings.MosaikPath.append("/");
+
+    if ( !m_settings.HasReferenceFilename || m_settings.ReferenceFilename.empty() ) {
+        missing << endl << "\t-ref (Mosaik reference archive)";
+        hasMissing = true;
+    }
+
+    if ( !m_settings.HasScratchPath || m_settings.ScratchPath.empty() ) {
+        missing << endl << "\t-tmp (scratch directory for generated files)";
+        hasMissing = true;
+    }
+
+    if ( hasMissing ) {
+        m_errorString = "\nthe following parameters are missing:";
+        m_errorString.append(missing.str());
+        return false;
+    }
+
+    if ( m_settings.HasFastqFilename1       || m_settings.HasFastqFilename2     ||
+         m_settings.HasOutputFilename       || m_settings.HasAlignedBamFilename ||
+         m_settings.HasUnalignedBamFilename || m_settings.HasManifestFilename   ||
+         m_settings.HasServeSocketFilename  || m_settings.HasSubmitSocketFilename ||
+         m_settings.HasSpoolPath )
+    {
+        m_errorString = "\nthe following parameters are invalid:"
+                        "\n\t-worker takes its batches from the spool directory, it cannot be combined with "
+                        "-fq1/-fq2/-out/-ubam/-bam/-manifest/-serve/-submit/-spool";
+        return false;
+    }
+
+    if ( !dirExists(m_settings.WorkerSpoolPath.c_str()) ) {
+        m_errorString = "spool directory does not exist: ";
+        m_errorString.append(m_settings.WorkerSpoolPath);
+        return false;
+    }
+
+    if ( !endsWith(m_settings.WorkerSpoolPath, "/") )
+        m_settings.WorkerSpoolPath.append("/");
+
+    return true;
+}
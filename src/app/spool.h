@@ -0,0 +1,136 @@
+// ***************************************************************************
+// spool.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Spool directory batch distribution (-spool coordinator, -worker processes)
+// ***************************************************************************
+
+#ifndef SPOOL_H
+#define SPOOL_H
+
+#include "premo_settings.h"
+#include "result.h"
+#include <pthread.h>
+#include <signal.h>
+#include <string>
+class Premo;
+
+// Spool layout, for a batch named <stem>:
+//
+//   <stem>_mate1.fq, <stem>_mate2.fq    batch FASTQ pair, written by coordinator
+//   <stem>.job                          job description (JSON), published by coordinator
+//   <stem>.claimed                      job, once claimed by a worker (atomic rename of .job)
+//   <stem>.result                       batch result (JSON), published by worker
+//   <host>_<pid>.worker                 worker presence, for as long as the worker runs
+//
+// Files are published by writing <file>.tmp & then renaming, so readers never see partial contents.
+//
+// Claims are leased: workers renew (touch) their .claimed & .worker files every few seconds.
+// A coordinator requeues a claim that stops being renewed (its worker crashed), by renaming it
+// back to <stem>.job, & gives up if no .worker file is renewed at all. Renewal is detected by
+// watching the files' change times, so hosts' clocks do not need to agree.
+
+struct SpoolJob {
+
+    // data members
+    std::string Fastq1;
+    std::string Fastq2;
+    unsigned int NumPairs;      // 0 if unknown (older coordinators)
+
+    // Mosaik settings that affect the batch result (the rest are the worker's own)
+    std::string  SeqTech;
+    unsigned int HashSize;
+    unsigned int Mhp;
+    double       Mmp;
+
+    // ctors & dtor
+    SpoolJob(void)
+        : NumPairs(0)
+        , HashSize(0)
+        , Mhp(0)
+        , Mmp(0.0)
+    { }
+    SpoolJob(const SpoolJob& other)
+        : Fastq1(other.Fastq1)
+        , Fastq2(other.Fastq2)
+        , NumPairs(other.NumPairs)
+        , SeqTech(other.SeqTech)
+        , HashSize(other.HashSize)
+        , Mhp(other.Mhp)
+        , Mmp(other.Mmp)
+    { }
+    ~SpoolJob(void) { }
+};
+
+// unique (per host & process) name for a coordinator's batch
+std::string spoolStem(const std::string& batchFilePrefix, const int batchNumber);
+
+bool readSpoolJob(const std::string& filename, SpoolJob* job, std::string* errorString);
+bool writeSpoolJob(const std::string& filename, const SpoolJob& job, std::string* errorString);
+
+// a worker's failure is reported by readSpoolResult() as an error
+bool readSpoolResult(const std::string& filename, Result* result, std::string* errorString);
+bool writeSpoolResult(const std::string& filename, const Result& result, std::string* errorString);
+bool writeSpoolError(const std::string& filename, const std::string& workerError, std::string* errorString);
+
+// coordinator side of a batch: publishes job <stem>.job (stem includes the spool path), then waits
+// for its result. Fails if timeout (seconds, 0 for none) passes, no worker is alive, or the runner
+// (may be 0) is cancelled or the process interrupted (see SpoolInterruptGuard)
+bool runSpoolJob(const std::string& stem,
+                 const SpoolJob& job,
+                 const unsigned int timeout,
+                 const Premo* runner,
+                 Result* result,
+                 std::string* errorString);
+// removes all of job <stem>'s spool files (not its FASTQs)
+void removeSpoolJob(const std::string& stem);
+
+// records SIGINT/SIGTERM while in scope (instead of terminating the process),
+// so that coordinators waiting on workers can fail & clean up their spool files
+class SpoolInterruptGuard {
+    public:
+        SpoolInterruptGuard(const bool isEnabled);
+        ~SpoolInterruptGuard(void);
+    private:
+        bool m_isEnabled;
+        struct sigaction m_oldIntAction;
+        struct sigaction m_oldTermAction;
+};
+
+class SpoolWorker {
+
+    // ctor & dtor
+    public:
+        SpoolWorker(const PremoSettings& settings);
+        ~SpoolWorker(void);
+
+    // SpoolWorker interface
+    public:
+        std::string errorString(void) const;
+        bool run(void);   // claims & aligns batches until interrupted (SIGINT/SIGTERM)
+
+    // internal methods
+    private:
+        bool claimNextJob(std::string* stem);
+        void processJob(const std::string& stem);
+        void renewLeases(void);
+        void setClaimedFilename(const std::string& filename);
+        bool validateSettings(void);
+        static void* heartbeatMain(void* worker);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        bool m_createdScratchDirectory;
+        std::string m_errorString;
+
+        // lease renewal (heartbeat thread)
+        std::string m_workerFilename;
+        std::string m_claimedFilename;   // empty if no job claimed
+        bool m_isStopping;
+        pthread_mutex_t m_leaseMutex;
+};
+
+#endif // SPOOL_H
@@ -2,7 +2,7 @@
 // stats.h (c) 2012 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 12 Sept 2013 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Data structures & methods for statistics
 // ***************************************************************************
@@ -10,6 +10,7 @@
 #ifndef STATS_H
 #define STATS_H
 
+#include <stdint.h>
 #include <algorithm>
 #include <vector>
 
@@ -97,6 +98,88 @@ Quartiles calculateQuartiles(const std::vector<T>& container) {
     return result;
 }
 
+// --------------------------------------------------------------------------
+// histogram variants
+//
+// N.B. - histogram[value] holds the number of observations of value, so the
+//        histogram implicitly describes a sorted container
+// --------------------------------------------------------------------------
+
+template<typename T>
+uint64_t histogramCount(const std::vector<T>& histogram) {
+    uint64_t count = 0;
+    for ( size_t value = 0; value < histogram.size(); ++value )
+        count += histogram[value];
+    return count;
+}
+
+// returns the value found at index, in the sorted order of observations
+template<typename T>
+size_t histogramValueAt(const std::vector<T>& histogram, const uint64_t index) {
+    uint64_t seen = 0;
+    for ( size_t value = 0; value < histogram.size(); ++value ) {
+        seen += histogram[value];
+        if ( index < seen )
+            return value;
+    }
+    return 0;
+}
+
+// calculates the median of the observations at sorted indices [begin, end)
+template<typename T>
+double calculateHistogramMedian(const std::vector<T>& histogram,
+                                const uint64_t begin,
+                                const uint64_t end)
+{
+    if ( end <= begin )
+        return 0.0;
+
+    const uint64_t numElements = end - begin;
+    const uint64_t pivot       = begin + numElements / 2;
+
+    // even number of data points
+    // return average of middle values
+    if ( numElements % 2 == 0 )
+        return ( histogramValueAt(histogram, pivot-1) + histogramValueAt(histogram, pivot) ) / 2.0;
+
+    // otherwise, odd number of data points
+    // return middle value
+    else
+        return static_cast<double>(histogramValueAt(histogram, pivot));
+}
+
+template<typename T>
+double calculateHistogramMedian(const std::vector<T>& histogram) {
+    return calculateHistogramMedian(histogram, 0, histogramCount(histogram));
+}
+
+// same result as calculateQuartiles() on the equivalent sorted container
+template<typename T>
+Quartiles calculateHistogramQuartiles(const std::vector<T>& histogram) {
+
+    Quartiles result;
+
+    const uint64_t numElements = histogramCount(histogram);
+    const uint64_t pivot       = numElements / 2;
+
+    result.Q2 = calculateHistogramMedian(histogram, 0, numElements);
+
+    // even number of data points
+    if ( numElements % 2 == 0 ) {
+        result.Q1 = calculateHistogramMedian(histogram, 0, pivot);
+        result.Q3 = calculateHistogramMedian(histogram, pivot, numElements);
+    }
+
+    // otherwise, odd number of data points
+    // need to count center element in both low & high
+    else {
+        result.Q1 = calculateHistogramMedian(histogram, 0, pivot + 1);
+        result.Q3 = calculateHistogramMedian(histogram, pivot, numElements);
+    }
+
+    return result;
+}
+
 // N.B. - type T must be comparable to a double
 template<typename T>
 struct OutOfRange {
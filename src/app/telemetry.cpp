@@ -0,0 +1,215 @@
+// ***************************************************************************
+// telemetry.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Per-batch stage timings, resource usage & Chrome trace-format output
+// ***************************************************************************
+
+#include "telemetry.h"
+
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <fstream>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+static inline
+double toSeconds(const struct timeval& t) {
+    return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_usec) / 1000000.0;
+}
+
+double wallTime(void) {
+    struct timeval now;
+    gettimeofday(&now, 0);
+    return toSeconds(now);
+}
+
+// -----------------------------
+// ResourceUsage implementation
+// -----------------------------
+
+ResourceUsage ResourceUsage::current(void) {
+
+    ResourceUsage usage;
+
+    struct rusage self;
+    if ( getrusage(RUSAGE_SELF, &self) == 0 )
+        usage.PeakRssKb = self.ru_maxrss;
+
+    struct rusage children;
+    if ( getrusage(RUSAGE_CHILDREN, &children) == 0 ) {
+        usage.ChildUserSeconds   = toSeconds(children.ru_utime);
+        usage.ChildSystemSeconds = toSeconds(children.ru_stime);
+        usage.ChildPeakRssKb     = children.ru_maxrss;
+    }
+
+    return usage;
+}
+
+// ---------------------------
+// StageTimer implementation
+// ---------------------------
+
+StageTimer::StageTimer(BatchTimings* timings, const string& name)
+    : m_timings(timings)
+    , m_name(name)
+    , m_start(wallTime())
+    , m_isStopped(false)
+{
+    assert(m_timings);
+}
+
+StageTimer::~StageTimer(void) {
+    stop();
+}
+
+void StageTimer::stop(void) {
+
+    if ( m_isStopped )
+        return;
+    m_isStopped = true;
+
+    const double seconds = wallTime() - m_start;
+    m_timings->Stages.push_back( StageTiming(m_name, seconds) );
+    if ( Trace::isEnabled() )
+        Trace::record(*m_timings, m_name, m_start, seconds);
+}
+
+// ----------------------
+// Trace implementation
+// ----------------------
+
+struct TraceEvent {
+
+    // data members
+    std::string Name;
+    std::string JobName;
+    int BatchNumber;
+    int ThreadIndex;
+    double Start;
+    double Seconds;
+
+    // ctor
+    TraceEvent(const std::string& name,
+               const std::string& jobName,
+               const int batchNumber,
+               const int threadIndex,
+               const double start,
+               const double seconds)
+        : Name(name)
+        , JobName(jobName)
+        , BatchNumber(batchNumber)
+        , ThreadIndex(threadIndex)
+        , Start(start)
+        , Seconds(seconds)
+    { }
+};
+
+static pthread_mutex_t traceMutex = PTHREAD_MUTEX_INITIALIZER;
+static bool isTraceEnabled = false;
+static double traceOrigin = 0.0;
+static vector<TraceEvent> traceEvents;
+static vector<pthread_t> traceThreads;
+
+void Trace::enable(void) {
+    pthread_mutex_lock(&traceMutex);
+    if ( !isTraceEnabled ) {
+        isTraceEnabled = true;
+        traceOrigin = wallTime();
+    }
+    pthread_mutex_unlock(&traceMutex);
+}
+
+bool Trace::isEnabled(void) {
+    pthread_mutex_lock(&traceMutex);
+    const bool isEnabled = isTraceEnabled;
+    pthread_mutex_unlock(&traceMutex);
+    return isEnabled;
+}
+
+void Trace::record(const BatchTimings& timings,
+                   const string& stageName,
+                   const double start,
+                   const double seconds)
+{
+    pthread_mutex_lock(&traceMutex);
+
+    // look up calling thread's index (threads are few, linear search is fine)
+    const pthread_t self = pthread_self();
+    int threadIndex = -1;
+    for ( size_t i = 0; i < traceThreads.size() && threadIndex < 0; ++i ) {
+        if ( pthread_equal(traceThreads.at(i), self) )
+            threadIndex = static_cast<int>(i);
+    }
+    if ( threadIndex < 0 ) {
+        threadIndex = static_cast<int>(traceThreads.size());
+        traceThreads.push_back(self);
+    }
+
+    traceEvents.push_back( TraceEvent(stageName,
+                                      timings.JobName,
+                                      timings.BatchNumber,
+                                      threadIndex,
+                                      start - traceOrigin,
+                                      seconds) );
+
+    pthread_mutex_unlock(&traceMutex);
+}
+
+bool Trace::write(const string& filename, string* errorString) {
+
+    // build trace ('X' = complete event, times in microseconds)
+    Json::Value events(Json::arrayValue);
+    const int pid = static_cast<int>(getpid());
+
+    pthread_mutex_lock(&traceMutex);
+    for ( size_t i = 0; i < traceEvents.size(); ++i ) {
+
+        const TraceEvent& e = traceEvents.at(i);
+
+        Json::Value args(Json::objectValue);
+        args["job"]   = e.JobName;
+        args["batch"] = e.BatchNumber;
+
+        Json::Value event(Json::objectValue);
+        event["name"] = e.Name;
+        event["cat"]  = "premo";
+        event["ph"]   = "X";
+        event["ts"]   = e.Start   * 1000000.0;
+        event["dur"]  = e.Seconds * 1000000.0;
+        event["pid"]  = pid;
+        event["tid"]  = e.ThreadIndex;
+        event["args"] = args;
+        events.append(event);
+    }
+    pthread_mutex_unlock(&traceMutex);
+
+    Json::Value root(Json::objectValue);
+    root["traceEvents"]     = events;
+    root["displayTimeUnit"] = "ms";
+
+    // write to file
+    ofstream outFile(filename.c_str());
+    if ( !outFile ) {
+        *errorString = "could not open trace file: ";
+        errorString->append(filename);
+        return false;
+    }
+
+    Json::FastWriter writer;
+    outFile << writer.write(root);
+    outFile.close();
+    return true;
+}
@@ -0,0 +1,134 @@
+// ***************************************************************************
+// telemetry.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Per-batch stage timings, resource usage & Chrome trace-format output
+// ***************************************************************************
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// wall clock time, in seconds
+double wallTime(void);
+
+// snapshot of getrusage() values
+// N.B. - child values cover every child process so far (including other jobs' children, if running concurrently)
+struct ResourceUsage {
+
+    // data members
+    double ChildUserSeconds;
+    double ChildSystemSeconds;
+    long PeakRssKb;           // this process
+    long ChildPeakRssKb;      // largest child process
+
+    // ctors & dtor
+    ResourceUsage(void)
+        : ChildUserSeconds(0.0)
+        , ChildSystemSeconds(0.0)
+        , PeakRssKb(0)
+        , ChildPeakRssKb(0)
+    { }
+    ResourceUsage(const ResourceUsage& other)
+        : ChildUserSeconds(other.ChildUserSeconds)
+        , ChildSystemSeconds(other.ChildSystemSeconds)
+        , PeakRssKb(other.PeakRssKb)
+        , ChildPeakRssKb(other.ChildPeakRssKb)
+    { }
+    ~ResourceUsage(void) { }
+
+    static ResourceUsage current(void);
+};
+
+struct StageTiming {
+
+    // data members
+    std::string Name;
+    double Seconds;
+
+    // ctors & dtor
+    StageTiming(const std::string& name = std::string(), const double seconds = 0.0)
+        : Name(name)
+        , Seconds(seconds)
+    { }
+    StageTiming(const StageTiming& other)
+        : Name(other.Name)
+        , Seconds(other.Seconds)
+    { }
+    ~StageTiming(void) { }
+};
+
+struct BatchTimings {
+
+    // data members
+    std::string JobName;          // batch file prefix, tells concurrent jobs apart in traces
+    int BatchNumber;
+    std::vector<StageTiming> Stages;
+    double WallSeconds;
+    uint64_t NumReads;
+    int64_t BytesIn;              // FASTQ text read from input, -1 if not known (BAM input)
+    uint64_t BytesOut;            // generated files
+    ResourceUsage Usage;          // child CPU time used during batch, peak RSS at end of batch
+
+    // ctors & dtor
+    BatchTimings(void)
+        : BatchNumber(0)
+        , WallSeconds(0.0)
+        , NumReads(0)
+        , BytesIn(-1)
+        , BytesOut(0)
+    { }
+    BatchTimings(const BatchTimings& other)
+        : JobName(other.JobName)
+        , BatchNumber(other.BatchNumber)
+        , Stages(other.Stages)
+        , WallSeconds(other.WallSeconds)
+        , NumReads(other.NumReads)
+        , BytesIn(other.BytesIn)
+        , BytesOut(other.BytesOut)
+        , Usage(other.Usage)
+    { }
+    ~BatchTimings(void) { }
+};
+
+// times one stage, adding it to timings (& the trace, if enabled) when stopped or destroyed
+class StageTimer {
+
+    // ctor & dtor
+    public:
+        StageTimer(BatchTimings* timings, const std::string& name);
+        ~StageTimer(void);
+
+    // StageTimer interface
+    public:
+        void stop(void);
+
+    // data members
+    private:
+        BatchTimings* m_timings;
+        std::string m_name;
+        double m_start;
+        bool m_isStopped;
+};
+
+// process-wide Chrome trace-format recorder (-trace)
+// one trace 'thread' per OS thread, so concurrent jobs' stages show up side by side
+class Trace {
+
+    // Trace interface
+    public:
+        static void enable(void);
+        static bool isEnabled(void);
+        static void record(const BatchTimings& timings,
+                           const std::string& stageName,
+                           const double start,
+                           const double seconds);
+        static bool write(const std::string& filename, std::string* errorString);
+};
+
+#endif // TELEMETRY_H
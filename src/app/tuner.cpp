@@ -0,0 +1,380 @@
+// ***************************************************************************
+// tuner.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Benchmarks candidate MosaikAligner parameter sets on a batch's reads (-tune)
+// ***************************************************************************
+
+#include "tuner.h"
+
+#include "fastq.h"
+#include "fastqreader.h"
+#include "fastqwriter.h"
+#include "matepairer.h"
+#include "telemetry.h"
+
+#include "bamtools/api/BamReader.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+// Mosaik writes these alongside each alignment stub
+static const char* const ALIGNER_OUTPUT_SUFFIXES[] = { ".bam", ".mosaiklog", ".multiple.bam", ".special.bam", ".stat" };
+static const size_t NUM_ALIGNER_OUTPUT_SUFFIXES = sizeof(ALIGNER_OUTPUT_SUFFIXES) / sizeof(ALIGNER_OUTPUT_SUFFIXES[0]);
+
+// secondary & supplementary records would count a read more than once
+static const uint32_t NON_PRIMARY_FLAGS = 0x100 | 0x800;
+
+// calibration runs align this fraction (1/N) of the tuning reads
+static const uint64_t CALIBRATION_DIVISOR = 4;
+
+static
+vector<unsigned int> hashSizeCandidates(const PremoSettings& settings, const unsigned int hashSize) {
+
+    vector<unsigned int> values;
+    values.push_back(hashSize);
+
+    // jump database is built for a single hash size
+    if ( settings.HasJumpDbStub && !settings.JumpDbStub.empty() )
+        return values;
+
+    if ( hashSize >= 6 )
+        values.push_back(hashSize - 2);
+    if ( hashSize <= 30 )
+        values.push_back(hashSize + 2);
+    return values;
+}
+
+static
+vector<unsigned int> mhpCandidates(const unsigned int mhp) {
+    vector<unsigned int> values;
+    values.push_back(mhp);
+    if ( mhp > 1 )
+        values.push_back(mhp / 2);
+    values.push_back(mhp * 2);
+    return values;
+}
+
+static
+vector<double> actCandidates(const double act) {
+    vector<double> values;
+    values.push_back(act);
+    values.push_back(act + ceil(0.1 * act));
+    return values;
+}
+
+// candidate A dominates B if it is at least as fast & as sensitive, and better in one of them
+static
+bool dominates(const TuningCandidate& a, const TuningCandidate& b) {
+    const double aSpeed = a.pairsPerSecond();
+    const double bSpeed = b.pairsPerSecond();
+    const double aMapped = a.fractionMapped();
+    const double bMapped = b.fractionMapped();
+    return ( aSpeed >= bSpeed && aMapped >= bMapped ) &&
+           ( aSpeed >  bSpeed || aMapped >  bMapped );
+}
+
+// -------------------------------
+// ParameterTuner implementation
+// -------------------------------
+
+ParameterTuner::ParameterTuner(const PremoSettings& settings)
+    : m_settings(settings)
+    , m_numPairs(0)
+    , m_numCalibrationPairs(0)
+{ }
+
+ParameterTuner::~ParameterTuner(void) {
+
+    // auto-delete any generated files (unless requested otherwise)
+    if ( !m_settings.IsKeepGeneratedFiles ) {
+        if ( !m_readStub.empty() ) {
+            remove( (m_readStub + ".mkb").c_str() );
+            remove( (m_readStub + ".mosaiklog").c_str() );
+        }
+        if ( !m_calibrationFastq1.empty() ) {
+            remove(m_calibrationFastq1.c_str());
+            remove(m_calibrationFastq2.c_str());
+        }
+        if ( !m_calibrationStub.empty() ) {
+            remove( (m_calibrationStub + ".mkb").c_str() );
+            remove( (m_calibrationStub + ".mosaiklog").c_str() );
+        }
+        for ( size_t i = 0; i < m_candidates.size(); ++i ) {
+            const string stub = candidateStub(i);
+            for ( size_t j = 0; j < NUM_ALIGNER_OUTPUT_SUFFIXES; ++j )
+                remove( (stub + ALIGNER_OUTPUT_SUFFIXES[j]).c_str() );
+        }
+    }
+}
+
+bool ParameterTuner::alignCandidate(const size_t index) {
+
+    TuningCandidate& candidate = m_candidates.at(index);
+    const string stub = candidateStub(index);
+    const string bamFilename = stub + ".bam";
+
+    // time calibration reads first (its output is overwritten by the full run)
+    double calibrationSeconds = 0.0;
+    if ( m_numCalibrationPairs != 0 &&
+         !runAligner(candidate.Parameters, m_calibrationStub + ".mkb", stub, &calibrationSeconds) )
+    {
+        stringstream s("");
+        s << "MosaikAligner failed for tuning candidate " << index << " (calibration reads)";
+        m_errorString = s.str();
+        return false;
+    }
+
+    // time all tuning reads
+    if ( !runAligner(candidate.Parameters, m_readStub + ".mkb", stub, &candidate.AlignerSeconds) ) {
+        stringstream s("");
+        s << "MosaikAligner failed for tuning candidate " << index;
+        m_errorString = s.str();
+        return false;
+    }
+
+    // fit seconds = startup + pairs x perPair through both runs
+    // (if timing noise hides the extra reads' cost, keep the whole run time)
+    if ( m_numCalibrationPairs != 0 && candidate.AlignerSeconds > calibrationSeconds ) {
+        const double perPair = (candidate.AlignerSeconds - calibrationSeconds) /
+                               static_cast<double>(m_numPairs - m_numCalibrationPairs);
+        const double startup = candidate.AlignerSeconds - perPair * m_numPairs;
+        candidate.StartupSeconds = ( startup > 0.0 ? startup : 0.0 );
+    }
+
+    // count pairs & mapped pairs (mates paired by name, as in batch runs)
+    BamTools::BamReader reader;
+    if ( !reader.Open(bamFilename) ) {
+        m_errorString = "could not open generated BAM file: ";
+        m_errorString.append(bamFilename);
+        m_errorString.append(" to parse alignments");
+        return false;
+    }
+
+    MatePairer pairer(m_settings.BatchSize);   // tuning reads are a single batch
+    BamTools::BamAlignment alignment;
+    MateInfo mate;
+    while ( reader.GetNextAlignmentCore(alignment) ) {
+        if ( (alignment.AlignmentFlag & NON_PRIMARY_FLAGS) != 0 )
+            continue;
+        if ( !alignment.BuildName() ) {
+            m_errorString = "could not read alignment name from generated BAM file: ";
+            m_errorString.append(bamFilename);
+            m_errorString.append("\n");
+            m_errorString.append(alignment.GetErrorString());
+            return false;
+        }
+        if ( pairer.add(alignment, &mate) ) {
+            ++candidate.NumPairs;
+            if ( mate.IsMapped && alignment.IsMapped() )
+                ++candidate.NumPairsMapped;
+        }
+    }
+    reader.Close();
+    return true;
+}
+
+bool ParameterTuner::buildReadArchive(const string& fastq1,
+                                      const string& fastq2,
+                                      const MosaikParameters& generated,
+                                      const string& stub)
+{
+    // setup MosaikBuild command line (logging to its own file, as candidates log to theirs)
+    stringstream commandStream("");
+    commandStream << m_settings.MosaikPath << "MosaikBuild"
+                  << " -q "   << fastq1
+                  << " -q2 "  << fastq2
+                  << " -out " << stub << ".mkb"
+                  << " -st "  << generated.SeqTech
+                  << " -mfl " << generated.MedianFragmentLength;
+    if ( !m_settings.IsVerbose )
+        commandStream << " -quiet >> " << stub << ".mosaiklog";
+
+    // run MosaikBuild
+    const string command = commandStream.str();
+    if ( system(command.c_str()) != 0 ) {
+        m_errorString = "MosaikBuild failed for tuning reads";
+        return false;
+    }
+    return true;
+}
+
+string ParameterTuner::candidateStub(const size_t index) const {
+    stringstream s("");
+    s << m_settings.ScratchPath << m_settings.BatchFilePrefix << "tune" << index << "_aligned";
+    return s.str();
+}
+
+string ParameterTuner::errorString(void) const {
+    return m_errorString;
+}
+
+bool ParameterTuner::runAligner(const MosaikParameters& parameters,
+                                const string& readArchive,
+                                const string& stub,
+                                double* seconds)
+{
+    assert(seconds);
+    const MosaikParameters& p = parameters;
+
+    // setup MosaikAlign command line
+    stringstream commandStream("");
+    commandStream << m_settings.MosaikPath << "MosaikAligner"
+                  << " -ia "    << m_settings.ReferenceFilename
+                  << " -in "    << readArchive
+                  << " -out "   << stub
+                  << " -annpe " << m_settings.AnnPeFilename
+                  << " -annse " << m_settings.AnnSeFilename
+                  << " -act "   << p.Act
+                  << " -bw "    << p.Bandwidth
+                  << " -hs "    << p.HashSize
+                  << " -ls "    << p.LocalSearchRadius
+                  << " -mhp "   << p.Mhp
+                  << " -mmp "   << p.Mmp
+                  << " -p "     << m_settings.NumProcessors
+                  << " -kd -pd ";
+
+    if ( m_settings.HasJumpDbStub && !m_settings.JumpDbStub.empty() )
+        commandStream << " -j " << m_settings.JumpDbStub;
+    if ( !m_settings.IsVerbose )
+        commandStream << " -quiet >> " << stub << ".mosaiklog";
+
+    // run & time MosaikAlign
+    const string command = commandStream.str();
+    const double start = wallTime();
+    const int result = system(command.c_str());
+    *seconds = wallTime() - start;
+    return ( result == 0 );
+}
+
+bool ParameterTuner::tune(const string& fastq1,
+                          const string& fastq2,
+                          const MosaikParameters& generated,
+                          vector<TuningCandidate>* candidates)
+{
+    assert(candidates);
+
+    // ------------------------------
+    // set up candidate grid
+    // ------------------------------
+
+    // generated set goes first, as the baseline
+    const vector<unsigned int> hashSizes = hashSizeCandidates(m_settings, generated.HashSize);
+    const vector<unsigned int> mhps = mhpCandidates(generated.Mhp);
+    const vector<double> acts = actCandidates(generated.Act);
+
+    m_candidates.clear();
+    for ( size_t h = 0; h < hashSizes.size(); ++h ) {
+        for ( size_t m = 0; m < mhps.size(); ++m ) {
+            for ( size_t a = 0; a < acts.size(); ++a ) {
+                TuningCandidate candidate;
+                candidate.Parameters = generated;
+                candidate.Parameters.HashSize = hashSizes.at(h);
+                candidate.Parameters.Mhp      = mhps.at(m);
+                candidate.Parameters.Act      = acts.at(a);
+                m_candidates.push_back(candidate);
+            }
+        }
+    }
+
+    // ------------------------------
+    // build reads & run candidates
+    // ------------------------------
+
+    const string prefix = m_settings.ScratchPath + m_settings.BatchFilePrefix;
+    if ( !writeCalibrationReads(fastq1, fastq2) )
+        return false;
+    m_readStub = prefix + "tune_reads";
+    if ( !buildReadArchive(fastq1, fastq2, generated, m_readStub) )
+        return false;
+    if ( m_numCalibrationPairs != 0 ) {
+        m_calibrationStub = prefix + "tune_calibration_reads";
+        if ( !buildReadArchive(m_calibrationFastq1, m_calibrationFastq2, generated, m_calibrationStub) )
+            return false;
+    }
+
+    if ( m_settings.IsVerbose )
+        cerr << "tuning: aligning " << m_candidates.size() << " candidate parameter sets on "
+             << m_numPairs << " pairs (start-up cost fit from " << m_numCalibrationPairs << " pairs)" << endl;
+
+    // one at a time, so candidates don't compete for processors
+    for ( size_t i = 0; i < m_candidates.size(); ++i ) {
+        if ( !alignCandidate(i) )
+            return false;
+    }
+
+    // ------------------------------
+    // mark Pareto front
+    // ------------------------------
+
+    for ( size_t i = 0; i < m_candidates.size(); ++i ) {
+        bool isDominated = false;
+        for ( size_t j = 0; j < m_candidates.size() && !isDominated; ++j )
+            isDominated = ( j != i && dominates(m_candidates.at(j), m_candidates.at(i)) );
+        m_candidates.at(i).IsParetoOptimal = !isDominated;
+    }
+
+    *candidates = m_candidates;
+    return true;
+}
+
+bool ParameterTuner::writeCalibrationReads(const string& fastq1, const string& fastq2) {
+
+    // count tuning pairs
+    FastqReader reader1;
+    FastqReader reader2;
+    if ( !reader1.open(fastq1) ) {
+        m_errorString = "could not open tuning FASTQ file: ";
+        m_errorString.append(fastq1);
+        return false;
+    }
+    Fastq f1;
+    Fastq f2;
+    m_numPairs = 0;
+    while ( reader1.readNext(&f1) )
+        ++m_numPairs;
+    reader1.close();
+
+    // skip calibration if too few reads to split
+    m_numCalibrationPairs = m_numPairs / CALIBRATION_DIVISOR;
+    if ( m_numCalibrationPairs == 0 )
+        return true;
+
+    // copy leading pairs
+    m_calibrationFastq1 = m_settings.ScratchPath + m_settings.BatchFilePrefix + "tune_calibration_1.fq";
+    m_calibrationFastq2 = m_settings.ScratchPath + m_settings.BatchFilePrefix + "tune_calibration_2.fq";
+    FastqWriter writer1;
+    FastqWriter writer2;
+    if ( !reader1.open(fastq1) || !reader2.open(fastq2) ) {
+        m_errorString = "could not reopen tuning FASTQ files";
+        return false;
+    }
+    if ( !writer1.open(m_calibrationFastq1) || !writer2.open(m_calibrationFastq2) ) {
+        m_errorString = "could not create calibration FASTQ files in: ";
+        m_errorString.append(m_settings.ScratchPath);
+        return false;
+    }
+    for ( uint64_t i = 0; i < m_numCalibrationPairs; ++i ) {
+        if ( !reader1.readNext(&f1) || !reader2.readNext(&f2) ) {
+            m_errorString = "tuning FASTQ files have different numbers of reads";
+            return false;
+        }
+        if ( !writer1.write(&f1) || !writer2.write(&f2) ) {
+            m_errorString = "could not write calibration FASTQ files in: ";
+            m_errorString.append(m_settings.ScratchPath);
+            return false;
+        }
+    }
+    return true;
+}
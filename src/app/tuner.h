@@ -0,0 +1,71 @@
+// ***************************************************************************
+// tuner.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Benchmarks candidate MosaikAligner parameter sets on a batch's reads (-tune)
+// ***************************************************************************
+
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "premo_result.h"
+#include "premo_settings.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class ParameterTuner {
+
+    // ctor & dtor
+    public:
+        ParameterTuner(const PremoSettings& settings);
+        ~ParameterTuner(void);
+
+    // ParameterTuner interface
+    public:
+        std::string errorString(void) const;
+
+        // aligns FASTQ pair with a small grid of speed parameters around the generated set,
+        // (candidates run one at a time, so each gets all -p processors) & marks the Pareto-optimal ones
+        // N.B. - each candidate is also run on a fraction of the reads, to fit (& discount) MosaikAligner's
+        //        start-up cost
+        bool tune(const std::string& fastq1,
+                  const std::string& fastq2,
+                  const MosaikParameters& generated,
+                  std::vector<TuningCandidate>* candidates);
+
+    // internal methods
+    private:
+        bool alignCandidate(const size_t index);
+        bool buildReadArchive(const std::string& fastq1,
+                              const std::string& fastq2,
+                              const MosaikParameters& generated,
+                              const std::string& stub);
+        std::string candidateStub(const size_t index) const;
+        bool runAligner(const MosaikParameters& parameters,
+                        const std::string& readArchive,
+                        const std::string& stub,
+                        double* seconds);
+        bool writeCalibrationReads(const std::string& fastq1, const std::string& fastq2);
+
+    // data members
+    private:
+        PremoSettings m_settings;
+        std::vector<TuningCandidate> m_candidates;
+
+        // all tuning reads (archive & MosaikBuild log stub)
+        std::string m_readStub;
+        uint64_t m_numPairs;
+
+        // leading fraction of the tuning reads, for fitting start-up cost (none if too few reads)
+        std::string m_calibrationFastq1;
+        std::string m_calibrationFastq2;
+        std::string m_calibrationStub;
+        uint64_t m_numCalibrationPairs;
+
+        std::string m_errorString;
+};
+
+#endif // TUNER_H
@@ -0,0 +1,231 @@
+// ***************************************************************************
+// ubamreader.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Unaligned BAM (uBAM) reader, provides FASTQ entries & read lengths
+// ***************************************************************************
+
+#include "ubamreader.h"
+#include "fastq.h"
+
+#include "bamtools/api/BamReader.h"
+
+#include <cassert>
+#include <algorithm>
+using namespace std;
+
+// ------------------------
+// static utility methods
+// ------------------------
+
+// secondary & supplementary records would duplicate a read's sequence
+static const uint32_t NON_PRIMARY_FLAGS = 0x100 | 0x800;
+
+static
+char complement(const char base) {
+    switch ( base ) {
+        case 'A' : return 'T';
+        case 'C' : return 'G';
+        case 'G' : return 'C';
+        case 'T' : return 'A';
+        case 'a' : return 't';
+        case 'c' : return 'g';
+        case 'g' : return 'c';
+        case 't' : return 'a';
+        default  : return base;
+    }
+}
+
+// stores alignment as FASTQ entry, in its original sequencing orientation
+static
+bool toFastq(const BamTools::BamAlignment& alignment, Fastq* entry, string* errorString) {
+
+    // BAM stores a run of 0xFF when qualities are missing
+    if ( !alignment.Qualities.empty() && alignment.Qualities[0] == (char)0xFF ) {
+        *errorString = "BAM record has no base qualities: ";
+        errorString->append(alignment.Name);
+        return false;
+    }
+
+    entry->Header    = Fastq::AT + alignment.Name;
+    entry->Bases     = alignment.QueryBases;
+    entry->Qualities = alignment.Qualities;
+
+    if ( alignment.IsReverseStrand() ) {
+        reverse(entry->Bases.begin(), entry->Bases.end());
+        transform(entry->Bases.begin(), entry->Bases.end(), entry->Bases.begin(), complement);
+        reverse(entry->Qualities.begin(), entry->Qualities.end());
+    }
+
+    return true;
+}
+
+// -----------------------------------
+// UnalignedBamReader implementation
+// -----------------------------------
+
+UnalignedBamReader::UnalignedBamReader(void)
+    : m_reader(0)
+    , m_isEOF(false)
+    , m_numThreads(1)
+{ }
+
+UnalignedBamReader::~UnalignedBamReader(void) {
+    close();
+}
+
+void UnalignedBamReader::close(void) {
+
+    // close BAM reader
+    if ( m_reader ) {
+        m_reader->Close();
+        delete m_reader;
+        m_reader = 0;
+    }
+
+    // clear any other file-dependent data
+    m_filename.clear();
+    m_isEOF = false;
+}
+
+string UnalignedBamReader::errorString(void) const {
+    return m_errorString;
+}
+
+string UnalignedBamReader::filename(void) const {
+    return m_filename;
+}
+
+bool UnalignedBamReader::isEOF(void) const {
+    return m_isEOF;
+}
+
+bool UnalignedBamReader::isOpen(void) const {
+    return ( m_reader != 0 && m_reader->IsOpen() );
+}
+
+bool UnalignedBamReader::open(const string& filename) {
+
+    // ensure clean slate
+    close();
+    assert(m_reader == 0);
+
+    // attempt to open file
+    m_reader = new BamTools::BamReader;
+    m_reader->SetNumThreads(m_numThreads);
+    if ( !m_reader->Open(filename) ) {
+
+        // if failed, set error & return failure
+        m_errorString = "could not open input BAM file: ";
+        m_errorString.append(filename);
+        m_errorString.append("\n\t");
+        m_errorString.append(m_reader->GetErrorString());
+        delete m_reader;
+        m_reader = 0;
+        return false;
+    }
+
+    // store filename & return success
+    m_filename = filename;
+    return true;
+}
+
+bool UnalignedBamReader::readNextLength(int* length) {
+
+    assert(length);
+
+    BamTools::BamAlignment alignment;
+    if ( !readNextPrimary(&alignment, true) )
+        return false;
+
+    *length = alignment.Length;
+    return true;
+}
+
+bool UnalignedBamReader::readNextPair(Fastq* mate1, Fastq* mate2) {
+
+    assert(mate1);
+    assert(mate2);
+
+    // read next 2 primary records
+    BamTools::BamAlignment first;
+    BamTools::BamAlignment second;
+    if ( !readNextPrimary(&first, false) )
+        return false;
+    if ( !readNextPrimary(&second, false) ) {
+        if ( m_isEOF ) {
+            m_isEOF = false;
+            m_errorString = "BAM file ended with an unpaired record: ";
+            m_errorString.append(first.Name);
+        }
+        return false;
+    }
+
+    // split by mate flags
+    const BamTools::BamAlignment* m1 = 0;
+    const BamTools::BamAlignment* m2 = 0;
+    if ( first.IsFirstMate() && second.IsSecondMate() ) {
+        m1 = &first;
+        m2 = &second;
+    } else if ( first.IsSecondMate() && second.IsFirstMate() ) {
+        m1 = &second;
+        m2 = &first;
+    } else {
+        m_errorString = "expected adjacent first & second mates in BAM file, instead found: ";
+        m_errorString.append(first.Name);
+        m_errorString.append(" & ");
+        m_errorString.append(second.Name);
+        return false;
+    }
+
+    if ( m1->Name != m2->Name ) {
+        m_errorString = "mate names do not match in BAM file: ";
+        m_errorString.append(m1->Name);
+        m_errorString.append(" & ");
+        m_errorString.append(m2->Name);
+        return false;
+    }
+
+    // store as FASTQ entries
+    return toFastq(*m1, mate1, &m_errorString) &&
+           toFastq(*m2, mate2, &m_errorString);
+}
+
+bool UnalignedBamReader::readNextPrimary(BamTools::BamAlignment* alignment, const bool isCoreOnly) {
+
+    // fail if unopened file
+    if ( !isOpen() ) {
+        m_errorString = "cannot read from unopened reader";
+        return false;
+    }
+
+    // read until next primary record
+    while ( true ) {
+
+        const bool readOk = ( isCoreOnly ? m_reader->GetNextAlignmentCore(*alignment)
+                                         : m_reader->GetNextAlignment(*alignment) );
+        if ( !readOk ) {
+
+            // distinguish EOF from read error
+            const string readerError = m_reader->GetErrorString();
+            if ( readerError.empty() )
+                m_isEOF = true;
+            else {
+                m_errorString = "could not read from input BAM file: ";
+                m_errorString.append(m_filename);
+                m_errorString.append("\n\t");
+                m_errorString.append(readerError);
+            }
+            return false;
+        }
+
+        if ( (alignment->AlignmentFlag & NON_PRIMARY_FLAGS) == 0 )
+            return true;
+    }
+}
+
+void UnalignedBamReader::setNumThreads(const unsigned int numThreads) {
+    m_numThreads = ( numThreads > 0 ? numThreads : 1 );
+}
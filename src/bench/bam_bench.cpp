@@ -0,0 +1,503 @@
+// ***************************************************************************
+// bam_bench.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// BgzfStream, BamReader & BamWriter benchmarks
+// ***************************************************************************
+
+#include "bench.h"
+
+#include "fastq.h"
+#include "premo_utils.h"
+
+#include "bamtools/api/BamAlignment.h"
+#include "bamtools/api/BamAlignmentBatch.h"
+#include "bamtools/api/BamReader.h"
+#include "bamtools/api/BamRecordView.h"
+#include "bamtools/api/BamWriter.h"
+#include "internal/io/BgzfStream_p.h"
+
+#include <cstdio>
+#include <exception>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+// ------------------------
+// benchmark data
+// ------------------------
+
+static const unsigned int READ_LENGTH       = 100;
+static const unsigned int FRAGMENT_LENGTH   = 300;
+static const size_t       NUM_POOLED        = 4096;    // distinct alignments, cycled through
+static const size_t       BGZF_CHUNK_SIZE   = 65536;   // bytes per BgzfStream Read()/Write() call
+static const uint64_t     BGZF_BYTES_PER_RECORD = 256;
+static const int          NUM_THREADS       = 4;       // for the multi-threaded benchmarks
+static const size_t       BATCH_SIZE        = 4096;    // alignments per GetNextAlignmentBatch() call
+
+// reading is expected to stop allocating once buffers have grown to fit the pooled records
+// (occasional BGZF block-level allocations are tolerated, per-record ones are not)
+static const uint64_t     NUM_WARMUP_RECORDS = NUM_POOLED;
+static const double       MAX_STEADY_STATE_ALLOCATIONS_PER_RECORD = 0.01;
+
+static
+string bamFilename(const BenchContext& context) {
+    return context.ScratchPath + "premo_bench.bam";
+}
+
+static
+string bgzfFilename(const BenchContext& context) {
+    return context.ScratchPath + "premo_bench.bgzf";
+}
+
+static
+uint64_t numBgzfChunks(const BenchContext& context) {
+    return (context.NumRecords * BGZF_BYTES_PER_RECORD + BGZF_CHUNK_SIZE - 1) / BGZF_CHUNK_SIZE;
+}
+
+static
+BamTools::RefVector benchReferences(void) {
+    BamTools::RefVector references;
+    references.push_back( BamTools::RefData("chr1", 250000000) );
+    return references;
+}
+
+// mate pairs, as Mosaik would write them
+static
+void makeAlignments(vector<BamTools::BamAlignment>* alignments) {
+
+    uint64_t state = 2;
+    Fastq read;
+    alignments->resize(NUM_POOLED);
+    for ( size_t i = 0; i < NUM_POOLED; ++i ) {
+
+        makeRead(i/2, READ_LENGTH, &state, &read);
+        const bool isFirstMate = ( i % 2 == 0 );
+        const int32_t insertSize = FRAGMENT_LENGTH - 2*READ_LENGTH;
+
+        BamTools::BamAlignment& a = alignments->at(i);
+        a.Name          = read.Header.substr(1);
+        a.QueryBases    = read.Bases;
+        a.Qualities     = read.Qualities;
+        a.Length        = READ_LENGTH;
+        a.RefID         = 0;
+        a.MateRefID     = 0;
+        a.MapQuality    = 60;
+        a.InsertSize    = ( isFirstMate ? insertSize : -insertSize );
+        a.AlignmentFlag = 0x1 | 0x2 | ( isFirstMate ? 0x40 | 0x20 : 0x80 | 0x10 );
+        a.CigarData.push_back( BamTools::CigarOp('M', READ_LENGTH) );
+        a.AddTag("RG", "Z", string("bench"));
+    }
+}
+
+// writes all records, positions increasing (so output is coordinate-sorted)
+static
+bool writeAlignments(const BenchContext& context,
+                     vector<BamTools::BamAlignment>& alignments,
+                     const int numThreads,
+                     string* errorString)
+{
+    BamTools::BamWriter writer;
+    writer.SetNumThreads(numThreads);
+    if ( !writer.Open(bamFilename(context), "@HD\tVN:1.0\tSO:coordinate\n", benchReferences()) ) {
+        *errorString = writer.GetErrorString();
+        return false;
+    }
+
+    for ( uint64_t i = 0; i < context.NumRecords; ++i ) {
+        BamTools::BamAlignment& a = alignments[i % NUM_POOLED];
+        a.Position     = static_cast<int32_t>(i / 2) * 10;
+        a.MatePosition = a.Position;
+        if ( !writer.SaveAlignment(a) ) {
+            *errorString = writer.GetErrorString();
+            return false;
+        }
+    }
+
+    writer.Close();
+    if ( !writer.GetErrorString().empty() ) {
+        *errorString = writer.GetErrorString();
+        return false;
+    }
+    return true;
+}
+
+// writes input file for the reader benchmarks (once per process)
+static
+bool prepareBamFile(const BenchContext& context, string* errorString) {
+
+    static bool isPrepared = false;
+    if ( isPrepared )
+        return true;
+
+    vector<BamTools::BamAlignment> alignments;
+    makeAlignments(&alignments);
+    isPrepared = writeAlignments(context, alignments, 1, errorString);
+    return isPrepared;
+}
+
+// FASTQ text, a typical payload for compression
+static
+void makeBgzfData(vector<char>* data) {
+    uint64_t state = 3;
+    Fastq read;
+    data->clear();
+    data->reserve(BGZF_CHUNK_SIZE + 1024);
+    for ( uint64_t i = 0; data->size() < BGZF_CHUNK_SIZE; ++i ) {
+        makeRead(i, READ_LENGTH, &state, &read);
+        const string text = read.Header + "\n" + read.Bases + "\n+\n" + read.Qualities + "\n";
+        data->insert(data->end(), text.begin(), text.end());
+    }
+    data->resize(BGZF_CHUNK_SIZE);
+}
+
+// ------------------------
+// benchmarks
+// ------------------------
+
+static
+bool benchBamRead(const BenchContext& context,
+                  const bool isCoreOnly,
+                  const int numThreads,
+                  BenchMeasure* measure,
+                  string* errorString)
+{
+    if ( !prepareBamFile(context, errorString) )
+        return false;
+
+    BamTools::BamReader reader;
+    reader.SetNumThreads(numThreads);
+    if ( !reader.Open(bamFilename(context)) ) {
+        *errorString = reader.GetErrorString();
+        return false;
+    }
+
+    BamTools::BamAlignment alignment;
+    uint64_t numAlignments = 0;
+    uint64_t warmAllocations = 0;
+
+    measure->start();
+    if ( isCoreOnly ) {
+        while ( reader.GetNextAlignmentCore(alignment) ) {
+            if ( ++numAlignments == NUM_WARMUP_RECORDS )
+                warmAllocations = allocationCount();
+        }
+    } else {
+        while ( reader.GetNextAlignment(alignment) ) {
+            if ( ++numAlignments == NUM_WARMUP_RECORDS )
+                warmAllocations = allocationCount();
+        }
+    }
+    measure->stop(numAlignments, fileSize(bamFilename(context)));
+
+    // fail if records read after warm-up still allocate
+    if ( numAlignments > NUM_WARMUP_RECORDS ) {
+        const uint64_t numSteadyRecords = numAlignments - NUM_WARMUP_RECORDS;
+        const uint64_t numSteadyAllocations = allocationCount() - warmAllocations;
+        const double allocationsPerRecord = static_cast<double>(numSteadyAllocations) / numSteadyRecords;
+        if ( allocationsPerRecord > MAX_STEADY_STATE_ALLOCATIONS_PER_RECORD ) {
+            stringstream s("");
+            s << numSteadyAllocations << " allocations in " << numSteadyRecords
+              << " records read after warm-up (at most " << MAX_STEADY_STATE_ALLOCATIONS_PER_RECORD
+              << " per record expected)";
+            *errorString = s.str();
+            return false;
+        }
+    }
+
+    reader.Close();
+    return true;
+}
+
+static
+bool benchBamReadBatch(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    if ( !prepareBamFile(context, errorString) )
+        return false;
+
+    BamTools::BamReader reader;
+    if ( !reader.Open(bamFilename(context)) ) {
+        *errorString = reader.GetErrorString();
+        return false;
+    }
+
+    BamTools::BamAlignmentBatch batch;
+    uint64_t numAlignments = 0;
+
+    measure->start();
+    while ( reader.GetNextAlignmentBatch(batch, BATCH_SIZE) )
+        numAlignments += batch.Size();
+    measure->stop(numAlignments, fileSize(bamFilename(context)));
+
+    reader.Close();
+    return true;
+}
+
+static
+bool benchBamReadCoreOnly(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    if ( !prepareBamFile(context, errorString) )
+        return false;
+
+    BamTools::BamReader reader;
+    if ( !reader.Open(bamFilename(context)) ) {
+        *errorString = reader.GetErrorString();
+        return false;
+    }
+
+    BamTools::BamAlignment alignment;
+    uint64_t numAlignments = 0;
+
+    measure->start();
+    while ( reader.GetNextAlignmentCoreOnly(alignment) )
+        ++numAlignments;
+    measure->stop(numAlignments, fileSize(bamFilename(context)));
+
+    reader.Close();
+    return true;
+}
+
+static
+bool benchBamReadView(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    if ( !prepareBamFile(context, errorString) )
+        return false;
+
+    BamTools::BamReader reader;
+    if ( !reader.Open(bamFilename(context)) ) {
+        *errorString = reader.GetErrorString();
+        return false;
+    }
+
+    BamTools::BamRecordView record;
+    uint64_t numAlignments = 0;
+
+    measure->start();
+    while ( reader.GetNextRecordView(record) )
+        ++numAlignments;
+    measure->stop(numAlignments, fileSize(bamFilename(context)));
+
+    reader.Close();
+    return true;
+}
+
+static
+bool benchBamReadFiltered(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    if ( !prepareBamFile(context, errorString) )
+        return false;
+
+    // keep first mates only (rejects half of the generated pairs)
+    BamTools::BamCoreFilter filter;
+    filter.RequiredFlags = 0x40;
+
+    BamTools::BamReader reader;
+    reader.SetFilter(filter);
+    if ( !reader.Open(bamFilename(context)) ) {
+        *errorString = reader.GetErrorString();
+        return false;
+    }
+
+    BamTools::BamAlignment alignment;
+    uint64_t numAlignments = 0;
+
+    measure->start();
+    while ( reader.GetNextAlignment(alignment) )
+        ++numAlignments;
+    measure->stop(context.NumRecords, fileSize(bamFilename(context))); // per alignment scanned
+
+    reader.Close();
+    if ( numAlignments != (context.NumRecords+1)/2 ) {
+        *errorString = "filtered read returned unexpected number of alignments";
+        return false;
+    }
+    return true;
+}
+
+static
+bool benchBamReadFull(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBamRead(context, false, 1, measure, errorString);
+}
+
+static
+bool benchBamReadCore(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBamRead(context, true, 1, measure, errorString);
+}
+
+static
+bool benchBamReadThreaded(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBamRead(context, false, NUM_THREADS, measure, errorString);
+}
+
+static
+bool benchBamWrite(const BenchContext& context,
+                   const int numThreads,
+                   BenchMeasure* measure,
+                   string* errorString)
+{
+
+    vector<BamTools::BamAlignment> alignments;
+    makeAlignments(&alignments);
+
+    BenchContext writeContext(context);
+    writeContext.ScratchPath += "write_";
+
+    measure->start();
+    const bool isOk = writeAlignments(writeContext, alignments, numThreads, errorString);
+    measure->stop(context.NumRecords, fileSize(bamFilename(writeContext)));
+
+    remove(bamFilename(writeContext).c_str());
+    return isOk;
+}
+
+static
+bool benchBamWriteSingle(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBamWrite(context, 1, measure, errorString);
+}
+
+static
+bool benchBamWriteThreaded(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBamWrite(context, NUM_THREADS, measure, errorString);
+}
+
+// writes numChunks copies of data (timed, if measure given)
+static
+bool writeBgzf(const string& filename,
+               const vector<char>& data,
+               const uint64_t numChunks,
+               const int numThreads,
+               BenchMeasure* measure,
+               string* errorString)
+{
+    try {
+        BamTools::Internal::BgzfStream stream;
+        stream.SetNumThreads(numThreads);
+        stream.Open(filename, BamTools::IBamIODevice::WriteOnly);
+
+        if ( measure )
+            measure->start();
+        for ( uint64_t i = 0; i < numChunks; ++i )
+            stream.Write(&data[0], data.size());
+        stream.Close();
+        if ( measure )
+            measure->stop(numChunks, numChunks * data.size());
+    }
+    catch ( exception& e ) {
+        *errorString = e.what();
+        return false;
+    }
+    return true;
+}
+
+// writes input file for the BGZF reader benchmark (once per process)
+static
+bool prepareBgzfFile(const BenchContext& context, string* errorString) {
+
+    static bool isPrepared = false;
+    if ( isPrepared )
+        return true;
+
+    vector<char> data;
+    makeBgzfData(&data);
+    isPrepared = writeBgzf(bgzfFilename(context), data, numBgzfChunks(context), 1, 0, errorString);
+    return isPrepared;
+}
+
+static
+bool benchBgzfWrite(const BenchContext& context,
+                    const int numThreads,
+                    BenchMeasure* measure,
+                    string* errorString)
+{
+
+    vector<char> data;
+    makeBgzfData(&data);
+
+    const string filename = context.ScratchPath + "write_premo_bench.bgzf";
+    const bool isOk = writeBgzf(filename, data, numBgzfChunks(context), numThreads, measure, errorString);
+    remove(filename.c_str());
+    return isOk;
+}
+
+static
+bool benchBgzfWriteSingle(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBgzfWrite(context, 1, measure, errorString);
+}
+
+static
+bool benchBgzfWriteThreaded(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBgzfWrite(context, NUM_THREADS, measure, errorString);
+}
+
+static
+bool benchBgzfRead(const BenchContext& context,
+                   const int numThreads,
+                   BenchMeasure* measure,
+                   string* errorString)
+{
+    if ( !prepareBgzfFile(context, errorString) )
+        return false;
+
+    vector<char> data(BGZF_CHUNK_SIZE);
+    uint64_t numChunks = 0;
+    uint64_t numBytes = 0;
+
+    try {
+        BamTools::Internal::BgzfStream stream;
+        stream.SetNumThreads(numThreads);
+        stream.Open(bgzfFilename(context), BamTools::IBamIODevice::ReadOnly);
+
+        measure->start();
+        size_t numRead = 0;
+        while ( (numRead = stream.Read(&data[0], data.size())) > 0 ) {
+            ++numChunks;
+            numBytes += numRead;
+        }
+        measure->stop(numChunks, numBytes);
+        stream.Close();
+    }
+    catch ( exception& e ) {
+        *errorString = e.what();
+        return false;
+    }
+    return true;
+}
+
+static
+bool benchBgzfReadSingle(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBgzfRead(context, 1, measure, errorString);
+}
+
+static
+bool benchBgzfReadThreaded(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchBgzfRead(context, NUM_THREADS, measure, errorString);
+}
+
+// ------------------------
+// benchmark group
+// ------------------------
+
+bool runBamBenchmarks(BenchRunner* runner) {
+
+    const bool isOk = runner->run("bgzf_write",         "chunk",     benchBgzfWriteSingle)   &&
+                      runner->run("bgzf_write_mt",      "chunk",     benchBgzfWriteThreaded) &&
+                      runner->run("bgzf_read",          "chunk",     benchBgzfReadSingle)    &&
+                      runner->run("bgzf_read_mt",       "chunk",     benchBgzfReadThreaded)  &&
+                      runner->run("bam_write",          "alignment", benchBamWriteSingle)    &&
+                      runner->run("bam_write_mt",       "alignment", benchBamWriteThreaded)  &&
+                      runner->run("bam_read",           "alignment", benchBamReadFull)       &&
+                      runner->run("bam_read_mt",        "alignment", benchBamReadThreaded)   &&
+                      runner->run("bam_read_core",      "alignment", benchBamReadCore)       &&
+                      runner->run("bam_read_core_only", "alignment", benchBamReadCoreOnly)   &&
+                      runner->run("bam_read_view",      "alignment", benchBamReadView)       &&
+                      runner->run("bam_read_filtered",  "alignment", benchBamReadFiltered)   &&
+                      runner->run("bam_read_batch",     "alignment", benchBamReadBatch);
+
+    // clean up any generated input
+    const BenchContext& context = runner->context();
+    remove(bamFilename(context).c_str());
+    remove(bgzfFilename(context).c_str());
+    return isOk;
+}
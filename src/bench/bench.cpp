@@ -0,0 +1,176 @@
+// ***************************************************************************
+// bench.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Minimal benchmark runner: timing, allocation counts & JSON report
+// ***************************************************************************
+
+#include "bench.h"
+
+#include "telemetry.h"
+
+#include "internal/io/BgzfCodec_p.h"
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// ------------------------------------------------------------
+// allocation counting
+// (replaces global operator new/delete for the whole process,
+//  so allocations made inside libpremo & libbamtools count too)
+// ------------------------------------------------------------
+
+static volatile uint64_t numAllocations = 0;
+
+uint64_t allocationCount(void) {
+    return __sync_add_and_fetch(&numAllocations, 0);
+}
+
+static inline
+void* countedAllocate(size_t size) {
+    __sync_add_and_fetch(&numAllocations, 1);
+    void* p = malloc( size != 0 ? size : 1 );
+    if ( p == 0 )
+        throw bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size) throw(bad_alloc)   { return countedAllocate(size); }
+void* operator new[](size_t size) throw(bad_alloc) { return countedAllocate(size); }
+void operator delete(void* p) throw()              { free(p); }
+void operator delete[](void* p) throw()            { free(p); }
+
+// ----------------------------
+// BenchMeasure implementation
+// ----------------------------
+
+BenchMeasure::BenchMeasure(void)
+    : m_start(0.0)
+    , m_startAllocations(0)
+    , m_seconds(0.0)
+    , m_operations(0)
+    , m_bytes(0)
+    , m_allocations(0)
+{ }
+
+void BenchMeasure::start(void) {
+    m_startAllocations = allocationCount();
+    m_start = wallTime();
+}
+
+void BenchMeasure::stop(const uint64_t numOperations, const uint64_t numBytes) {
+    m_seconds = wallTime() - m_start;
+    m_allocations = allocationCount() - m_startAllocations;
+    m_operations = numOperations;
+    m_bytes = numBytes;
+}
+
+// ---------------------------
+// BenchRunner implementation
+// ---------------------------
+
+BenchRunner::BenchRunner(const BenchContext& context, const string& filter)
+    : m_context(context)
+    , m_filter(filter)
+{ }
+
+const BenchContext& BenchRunner::context(void) const {
+    return m_context;
+}
+
+string BenchRunner::errorString(void) const {
+    return m_errorString;
+}
+
+const vector<BenchResult>& BenchRunner::results(void) const {
+    return m_results;
+}
+
+bool BenchRunner::run(const string& name,
+                      const string& operation,
+                      BenchFunction function)
+{
+    if ( !m_filter.empty() && name.find(m_filter) == string::npos )
+        return true;
+
+    BenchResult result;
+    result.Name = name;
+    result.Operation = operation;
+
+    for ( unsigned int i = 0; i < m_context.NumRuns; ++i ) {
+
+        BenchMeasure measure;
+        if ( !function(m_context, &measure, &m_errorString) ) {
+            m_errorString = name + ": " + m_errorString;
+            return false;
+        }
+
+        // keep fastest run
+        if ( i == 0 || measure.seconds() < result.Seconds ) {
+            result.Operations  = measure.operations();
+            result.Bytes       = measure.bytes();
+            result.Seconds     = measure.seconds();
+            result.Allocations = measure.allocations();
+        }
+    }
+
+    cerr << name << ": "
+         << result.operationsPerSecond() << " " << operation << "s/s";
+    if ( result.Bytes != 0 )
+        cerr << ", " << result.megabytesPerSecond() << " MB/s";
+    cerr << ", " << result.allocationsPerOperation() << " allocations/" << operation << endl;
+
+    m_results.push_back(result);
+    return true;
+}
+
+bool BenchRunner::write(const string& filename) const {
+
+    Json::Value benchmarks(Json::arrayValue);
+    for ( size_t i = 0; i < m_results.size(); ++i ) {
+        const BenchResult& r = m_results.at(i);
+        Json::Value json(Json::objectValue);
+        json["name"]                      = r.Name;
+        json["operation"]                 = r.Operation;
+        json["operations"]                = static_cast<double>(r.Operations);
+        json["seconds"]                   = r.Seconds;
+        json["operations per second"]     = r.operationsPerSecond();
+        if ( r.Bytes != 0 ) {
+            json["bytes"]                 = static_cast<double>(r.Bytes);
+            json["MB per second"]         = r.megabytesPerSecond();
+        }
+        json["allocations"]               = static_cast<double>(r.Allocations);
+        json["allocations per operation"] = r.allocationsPerOperation();
+        benchmarks.append(json);
+    }
+
+    Json::Value settings(Json::objectValue);
+    settings["records"]    = static_cast<double>(m_context.NumRecords);
+    settings["runs"]       = m_context.NumRuns;
+    settings["bgzf codec"] = BamTools::Internal::BgzfCodec::Name();
+
+    Json::Value root(Json::objectValue);
+    root["settings"]   = settings;
+    root["benchmarks"] = benchmarks;
+
+    Json::StyledWriter writer;
+    if ( filename == "-" ) {
+        cout << writer.write(root);
+        return true;
+    }
+
+    ofstream outFile(filename.c_str());
+    if ( !outFile ) {
+        cerr << "premo_bench ERROR: could not open output file: " << filename << endl;
+        return false;
+    }
+    outFile << writer.write(root);
+    return true;
+}
@@ -0,0 +1,144 @@
+// ***************************************************************************
+// bench.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Minimal benchmark runner: timing, allocation counts & JSON report
+// ***************************************************************************
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "synthetic.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// heap allocations (operator new, all threads) since program start
+uint64_t allocationCount(void);
+
+// settings shared by all benchmarks
+struct BenchContext {
+
+    // data members
+    uint64_t NumRecords;      // records per run (reads, alignments or values)
+    unsigned int NumRuns;     // best run is reported
+    std::string ScratchPath;  // for generated files (ends in '/')
+
+    // ctors & dtor
+    BenchContext(void)
+        : NumRecords(200000)
+        , NumRuns(3)
+        , ScratchPath("./")
+    { }
+    BenchContext(const BenchContext& other)
+        : NumRecords(other.NumRecords)
+        , NumRuns(other.NumRuns)
+        , ScratchPath(other.ScratchPath)
+    { }
+    ~BenchContext(void) { }
+};
+
+// a single benchmark run measures one timed section
+// (set-up & tear-down outside of start() / stop() are not counted)
+class BenchMeasure {
+
+    // ctor & dtor
+    public:
+        BenchMeasure(void);
+        ~BenchMeasure(void) { }
+
+    // BenchMeasure interface
+    public:
+        void start(void);
+        void stop(const uint64_t numOperations, const uint64_t numBytes);
+
+        uint64_t allocations(void) const { return m_allocations; }
+        uint64_t bytes(void) const       { return m_bytes; }
+        uint64_t operations(void) const  { return m_operations; }
+        double seconds(void) const       { return m_seconds; }
+
+    // data members
+    private:
+        double m_start;
+        uint64_t m_startAllocations;
+        double m_seconds;
+        uint64_t m_operations;
+        uint64_t m_bytes;
+        uint64_t m_allocations;
+};
+
+// returns false (with error) if benchmark could not run
+typedef bool (*BenchFunction)(const BenchContext& context, BenchMeasure* measure, std::string* errorString);
+
+struct BenchResult {
+
+    // data members
+    std::string Name;
+    std::string Operation;    // what one operation is, e.g. "read", "alignment"
+    uint64_t Operations;
+    uint64_t Bytes;           // 0 if throughput in bytes does not apply
+    double Seconds;
+    uint64_t Allocations;
+
+    // ctors & dtor
+    BenchResult(void)
+        : Operations(0)
+        , Bytes(0)
+        , Seconds(0.0)
+        , Allocations(0)
+    { }
+    BenchResult(const BenchResult& other)
+        : Name(other.Name)
+        , Operation(other.Operation)
+        , Operations(other.Operations)
+        , Bytes(other.Bytes)
+        , Seconds(other.Seconds)
+        , Allocations(other.Allocations)
+    { }
+    ~BenchResult(void) { }
+
+    double operationsPerSecond(void) const { return ( Seconds > 0.0 ? Operations / Seconds : 0.0 ); }
+    double megabytesPerSecond(void) const  { return ( Seconds > 0.0 ? Bytes / Seconds / 1000000.0 : 0.0 ); }
+    double allocationsPerOperation(void) const {
+        return ( Operations != 0 ? static_cast<double>(Allocations) / Operations : 0.0 );
+    }
+};
+
+class BenchRunner {
+
+    // ctor & dtor
+    public:
+        BenchRunner(const BenchContext& context, const std::string& filter);
+        ~BenchRunner(void) { }
+
+    // BenchRunner interface
+    public:
+        // runs benchmark (if its name matches filter), keeping its fastest run
+        bool run(const std::string& name,
+                 const std::string& operation,
+                 BenchFunction function);
+
+        const BenchContext& context(void) const;
+        std::string errorString(void) const;
+        const std::vector<BenchResult>& results(void) const;
+
+        // JSON report, one entry per benchmark
+        bool write(const std::string& filename) const;   // "-" for stdout
+
+    // data members
+    private:
+        BenchContext m_context;
+        std::string m_filter;
+        std::vector<BenchResult> m_results;
+        std::string m_errorString;
+};
+
+// benchmark groups, one per source file (return false on first failure)
+bool runBamBenchmarks(BenchRunner* runner);
+bool runFastqBenchmarks(BenchRunner* runner);
+bool runStatsBenchmarks(BenchRunner* runner);
+
+#endif // BENCH_H
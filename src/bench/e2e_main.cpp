@@ -0,0 +1,248 @@
+// ***************************************************************************
+// e2e_main.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Main entry point for premo_e2e, the end-to-end benchmark: generates
+// synthetic pairs, runs Premo against the stub Mosaik tools & reports stage
+// timings along with estimate accuracy against the generator's truth
+// ***************************************************************************
+
+#include "synthetic.h"
+
+#include "premo.h"
+#include "premo_utils.h"
+#include "telemetry.h"
+
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+using namespace std;
+
+static
+void printUsage(void) {
+    cerr << endl
+         << "usage: premo_e2e [-pairs n | -mb size] [options]" << endl
+         << endl
+         << "synthetic data:" << endl
+         << "\t-pairs  number of read pairs [100000]" << endl
+         << "\t-mb     generate pairs until each FASTQ holds this many MB of text (instead of -pairs)" << endl
+         << "\t-rlmin  minimum read length [100]" << endl
+         << "\t-rlmax  maximum read length [100]" << endl
+         << "\t-fl     mean fragment length [350]" << endl
+         << "\t-flsd   fragment length standard deviation [35]" << endl
+         << "\t-gz     gzip-compress generated FASTQ" << endl
+         << "\t-seed   random seed [1]" << endl
+         << endl
+         << "premo:" << endl
+         << "\t-n      batch size (pairs), Premo's default if not given" << endl
+         << "\t-t      concurrent batches, Premo's default if not given" << endl
+         << "\t-mosaik directory containing (stub) MosaikBuild & MosaikAligner [<premo_e2e dir>/mosaik_stub/]" << endl
+         << "\t-tmp    directory for generated data & Premo scratch files [./premo_e2e_tmp/]" << endl
+         << "\t-keep   keep generated data" << endl
+         << "\t-out    JSON report filename, '-' for stdout [-]" << endl
+         << endl;
+}
+
+static
+string executableDirectory(const char* argv0) {
+    const string path(argv0);
+    const size_t found = path.rfind('/');
+    return ( found == string::npos ? string("./") : path.substr(0, found + 1) );
+}
+
+static
+Json::Value errorToJson(const Quartiles& truth, const LengthSummary& estimate) {
+    Json::Value json(Json::objectValue);
+    json["median"] = estimate.Median - truth.Q2;
+    json["Q1"]     = estimate.Q1 - truth.Q1;
+    json["Q3"]     = estimate.Q3 - truth.Q3;
+    json["median relative"] = ( truth.Q2 != 0.0 ? fabs(estimate.Median - truth.Q2) / truth.Q2 : 0.0 );
+    return json;
+}
+
+// stage seconds, summed over all batches
+static
+Json::Value stagesToJson(const vector<BatchTimings>& timings) {
+
+    map<string, double> stageSeconds;
+    for ( size_t i = 0; i < timings.size(); ++i ) {
+        const vector<StageTiming>& stages = timings.at(i).Stages;
+        for ( size_t j = 0; j < stages.size(); ++j )
+            stageSeconds[ stages.at(j).Name ] += stages.at(j).Seconds;
+    }
+
+    Json::Value json(Json::objectValue);
+    map<string, double>::const_iterator stageIter = stageSeconds.begin();
+    map<string, double>::const_iterator stageEnd  = stageSeconds.end();
+    for ( ; stageIter != stageEnd; ++stageIter )
+        json[stageIter->first] = stageIter->second;
+    return json;
+}
+
+int main(int argc, char* argv[]) {
+
+    // -------------------------------------------------------
+    // command line parameters
+    // -------------------------------------------------------
+
+    SyntheticSettings synthetic;
+    PremoSettings settings;
+    string scratchPath("./premo_e2e_tmp/");
+    string outputFilename("-");
+    bool isKeepData = false;
+
+    settings.HasMosaikPath = true;
+    settings.MosaikPath = executableDirectory(argv[0]) + "mosaik_stub/";
+
+    for ( int i = 1; i < argc; ++i ) {
+        const string arg(argv[i]);
+        if ( arg == "-h" || arg == "-help" ) {
+            printUsage();
+            return 0;
+        }
+        if ( arg == "-gz" ) {
+            synthetic.IsCompressed = true;
+            continue;
+        }
+        if ( arg == "-keep" ) {
+            isKeepData = true;
+            continue;
+        }
+        if ( i + 1 == argc ) {
+            cerr << "premo_e2e ERROR: missing value for " << arg << endl;
+            printUsage();
+            return 1;
+        }
+        const string value(argv[++i]);
+        if ( synthetic.parseOption(arg, value) )
+            continue;
+        else if ( arg == "-n" ) {
+            settings.HasBatchSize = true;
+            settings.BatchSize = atoi(value.c_str());
+        }
+        else if ( arg == "-t" ) {
+            settings.HasNumThreads = true;
+            settings.NumThreads = atoi(value.c_str());
+        }
+        else if ( arg == "-mosaik" )
+            settings.MosaikPath = value;
+        else if ( arg == "-tmp" )
+            scratchPath = value;
+        else if ( arg == "-out" )
+            outputFilename = value;
+        else {
+            cerr << "premo_e2e ERROR: unknown option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ( scratchPath.empty() || scratchPath[scratchPath.length()-1] != '/' )
+        scratchPath.append("/");
+    if ( !dirExists(scratchPath.c_str()) && !createDirectory(scratchPath.c_str()) ) {
+        cerr << "premo_e2e ERROR: could not create directory: " << scratchPath << endl;
+        return 1;
+    }
+
+    // -------------------------------------------------------
+    // generate data
+    // -------------------------------------------------------
+
+    const string extension = ( synthetic.IsCompressed ? ".fq.gz" : ".fq" );
+    const string fastq1 = scratchPath + "premo_e2e_1" + extension;
+    const string fastq2 = scratchPath + "premo_e2e_2" + extension;
+
+    SyntheticTruth truth;
+    string errorString;
+    const double generateStart = wallTime();
+    if ( !writeSyntheticPairs(synthetic, fastq1, fastq2, &truth, &errorString) ) {
+        cerr << "premo_e2e ERROR: " << errorString << endl;
+        return 1;
+    }
+    const double generateSeconds = wallTime() - generateStart;
+    const uint64_t bytesOnDisk = fileSize(fastq1) + fileSize(fastq2);
+
+    // -------------------------------------------------------
+    // run Premo (reference & annotations are never opened by the stubs)
+    // -------------------------------------------------------
+
+    settings.HasFastqFilename1    = true;
+    settings.FastqFilename1       = fastq1;
+    settings.HasFastqFilename2    = true;
+    settings.FastqFilename2       = fastq2;
+    settings.HasAnnPeFilename     = true;
+    settings.AnnPeFilename        = "stub.ann.pe";
+    settings.HasAnnSeFilename     = true;
+    settings.AnnSeFilename        = "stub.ann.se";
+    settings.HasReferenceFilename = true;
+    settings.ReferenceFilename    = "stub.dat";
+    settings.HasSeqTech           = true;
+    settings.SeqTech              = "illumina";
+    settings.HasScratchPath       = true;
+    settings.ScratchPath          = scratchPath + "premo/";
+    settings.HasOutputFilename    = true;
+    settings.OutputFilename       = scratchPath + "premo_e2e.json";
+
+    Premo premo(settings);
+    const bool isOk = premo.run();
+    const PremoResult result = premo.result();
+
+    if ( !isKeepData ) {
+        remove(fastq1.c_str());
+        remove(fastq2.c_str());
+        remove(settings.OutputFilename.c_str());
+    }
+
+    if ( !isOk ) {
+        cerr << "premo_e2e ERROR: " << premo.errorString() << endl;
+        return 1;
+    }
+
+    // -------------------------------------------------------
+    // report
+    // -------------------------------------------------------
+
+    Json::Value data(Json::objectValue);
+    data["compressed"] = synthetic.IsCompressed;
+    data["bytes on disk"] = static_cast<double>(bytesOnDisk);
+    data["seconds"] = generateSeconds;
+
+    Json::Value accuracy(Json::objectValue);
+    accuracy["fragment length"] = errorToJson(truth.FragmentLength, result.Overall.FragmentLength);
+    accuracy["read length"]     = errorToJson(truth.ReadLength, result.Overall.ReadLength);
+
+    Json::Value timing(Json::objectValue);
+    timing["batches"]       = static_cast<Json::UInt>(result.Batches.size());
+    timing["total seconds"] = result.TotalSeconds;
+    timing["stage seconds"] = stagesToJson(result.Timings);
+
+    Json::Value root(Json::objectValue);
+    root["data"]     = data;
+    root["truth"]    = truthToJson(truth);
+    root["estimate"] = summaryToJson(result.Overall, false);
+    root["error"]    = accuracy;
+    root["timing"]   = timing;
+
+    Json::StyledWriter writer;
+    if ( outputFilename == "-" ) {
+        cout << writer.write(root);
+        return 0;
+    }
+
+    ofstream outFile(outputFilename.c_str());
+    if ( !outFile ) {
+        cerr << "premo_e2e ERROR: could not open output file: " << outputFilename << endl;
+        return 1;
+    }
+    outFile << writer.write(root);
+    return 0;
+}
@@ -0,0 +1,157 @@
+// ***************************************************************************
+// fastq_bench.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// FastqReader & FastqWriter benchmarks
+// ***************************************************************************
+
+#include "bench.h"
+
+#include "fastq.h"
+#include "fastqreader.h"
+#include "fastqwriter.h"
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+// ------------------------
+// benchmark data
+// ------------------------
+
+static const unsigned int READ_LENGTH = 100;
+
+static
+string fastqFilename(const BenchContext& context, const bool isCompressed) {
+    return context.ScratchPath + ( isCompressed ? "premo_bench.fq.gz" : "premo_bench.fq" );
+}
+
+static
+void makeReads(const BenchContext& context, vector<Fastq>* reads) {
+    uint64_t state = 1;
+    reads->resize(context.NumRecords);
+    for ( uint64_t i = 0; i < context.NumRecords; ++i )
+        makeRead(i, READ_LENGTH, &state, &reads->at(i));
+}
+
+// writes input file for the reader benchmarks (once per process)
+static
+bool prepareFastqFile(const BenchContext& context, const bool isCompressed, string* errorString) {
+
+    static bool isPrepared[2] = { false, false };
+    if ( isPrepared[isCompressed] )
+        return true;
+
+    const string filename = fastqFilename(context, isCompressed);
+    gzFile file = gzopen(filename.c_str(), ( isCompressed ? "wb6" : "wbT" ));
+    if ( file == 0 ) {
+        *errorString = "could not create benchmark FASTQ file: ";
+        errorString->append(filename);
+        return false;
+    }
+
+    uint64_t state = 1;
+    Fastq read;
+    string text;
+    for ( uint64_t i = 0; i < context.NumRecords; ++i ) {
+        makeRead(i, READ_LENGTH, &state, &read);
+        text = read.Header + "\n" + read.Bases + "\n+\n" + read.Qualities + "\n";
+        gzwrite(file, text.data(), text.length());
+    }
+    gzclose(file);
+
+    isPrepared[isCompressed] = true;
+    return true;
+}
+
+// ------------------------
+// benchmarks
+// ------------------------
+
+static
+bool benchRead(const BenchContext& context, const bool isCompressed, BenchMeasure* measure, string* errorString) {
+
+    if ( !prepareFastqFile(context, isCompressed, errorString) )
+        return false;
+
+    FastqReader reader;
+    if ( !reader.open(fastqFilename(context, isCompressed)) ) {
+        *errorString = reader.errorString();
+        return false;
+    }
+
+    Fastq read;
+    uint64_t numReads = 0;
+    uint64_t numBytes = 0;
+
+    measure->start();
+    while ( reader.readNext(&read) ) {
+        ++numReads;
+        numBytes += read.textLength();
+    }
+    measure->stop(numReads, numBytes);
+
+    reader.close();
+    return true;
+}
+
+static
+bool benchReadPlain(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchRead(context, false, measure, errorString);
+}
+
+static
+bool benchReadGzip(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+    return benchRead(context, true, measure, errorString);
+}
+
+static
+bool benchWrite(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    vector<Fastq> reads;
+    makeReads(context, &reads);
+
+    const string filename = context.ScratchPath + "premo_bench_write.fq";
+    FastqWriter writer;
+    if ( !writer.open(filename) ) {
+        *errorString = writer.errorString();
+        return false;
+    }
+
+    uint64_t numBytes = 0;
+    bool isOk = true;
+
+    measure->start();
+    for ( size_t i = 0; i < reads.size() && isOk; ++i ) {
+        isOk = writer.write(&reads[i]);
+        numBytes += reads[i].textLength();
+    }
+    writer.close();
+    measure->stop(reads.size(), numBytes);
+
+    if ( !isOk )
+        *errorString = writer.errorString();
+    remove(filename.c_str());
+    return isOk;
+}
+
+// ------------------------
+// benchmark group
+// ------------------------
+
+bool runFastqBenchmarks(BenchRunner* runner) {
+
+    const bool isOk = runner->run("fastq_read_plain", "read", benchReadPlain) &&
+                      runner->run("fastq_read_gz",    "read", benchReadGzip)  &&
+                      runner->run("fastq_write",      "read", benchWrite);
+
+    // clean up any generated input
+    const BenchContext context = runner->context();
+    remove(fastqFilename(context, false).c_str());
+    remove(fastqFilename(context, true).c_str());
+    return isOk;
+}
@@ -0,0 +1,93 @@
+// ***************************************************************************
+// main.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Main entry point for premo_bench, Premo's benchmark suite
+// ***************************************************************************
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+static
+void printUsage(void) {
+    cerr << endl
+         << "usage: premo_bench [-n records] [-r runs] [-tmp dir] [-filter name] [-out file]" << endl
+         << endl
+         << "\t-n      records (reads, alignments or values) per benchmark run [200000]" << endl
+         << "\t-r      runs per benchmark, fastest is reported [3]" << endl
+         << "\t-tmp    directory for generated files [.]" << endl
+         << "\t-filter only run benchmarks whose name contains this string" << endl
+         << "\t-out    JSON report filename, '-' for stdout [-]" << endl
+         << endl
+         << "throughput is summarized on stderr, the JSON report goes to -out" << endl
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+
+    // -------------------------------------------------------
+    // command line parameters
+    // -------------------------------------------------------
+
+    BenchContext context;
+    string filter;
+    string outputFilename("-");
+
+    for ( int i = 1; i < argc; ++i ) {
+        const string arg(argv[i]);
+        if ( arg == "-h" || arg == "-help" ) {
+            printUsage();
+            return 0;
+        }
+        if ( i + 1 == argc ) {
+            cerr << "premo_bench ERROR: missing value for " << arg << endl;
+            printUsage();
+            return 1;
+        }
+        const string value(argv[++i]);
+        if ( arg == "-n" )
+            context.NumRecords = strtoull(value.c_str(), 0, 10);
+        else if ( arg == "-r" )
+            context.NumRuns = atoi(value.c_str());
+        else if ( arg == "-tmp" )
+            context.ScratchPath = value;
+        else if ( arg == "-filter" )
+            filter = value;
+        else if ( arg == "-out" )
+            outputFilename = value;
+        else {
+            cerr << "premo_bench ERROR: unknown option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ( context.NumRecords == 0 || context.NumRuns == 0 ) {
+        cerr << "premo_bench ERROR: -n & -r must be positive" << endl;
+        return 1;
+    }
+    if ( context.ScratchPath.empty() || context.ScratchPath[context.ScratchPath.length()-1] != '/' )
+        context.ScratchPath.append("/");
+
+    // -------------------------------------------------------
+    // run benchmarks & report
+    // -------------------------------------------------------
+
+    BenchRunner runner(context, filter);
+    const bool isOk = runFastqBenchmarks(&runner) &&
+                      runBamBenchmarks(&runner)   &&
+                      runStatsBenchmarks(&runner);
+    if ( !isOk ) {
+        cerr << "premo_bench ERROR: " << runner.errorString() << endl;
+        return 1;
+    }
+
+    return ( runner.write(outputFilename) ? 0 : 1 );
+}
@@ -0,0 +1,103 @@
+// ***************************************************************************
+// stats_bench.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Quartile & outlier benchmarks (stats.h)
+// ***************************************************************************
+
+#include "bench.h"
+
+#include "stats.h"
+
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+// ------------------------
+// benchmark data
+// ------------------------
+
+// roughly normal fragment lengths (sum of uniforms), with a few far outliers
+static
+void makeFragmentLengths(const BenchContext& context, vector<int>* lengths) {
+    uint64_t state = 4;
+    lengths->resize(context.NumRecords);
+    for ( uint64_t i = 0; i < context.NumRecords; ++i ) {
+        int length = 0;
+        for ( int j = 0; j < 4; ++j )
+            length += static_cast<int>( nextRandom(&state) % 101 );
+        (*lengths)[i] = ( i % 1000 == 0 ? 50000 : 100 + length );
+    }
+}
+
+static
+uint64_t maxValue(const vector<int>& values) {
+    return ( values.empty() ? 0 : *max_element(values.begin(), values.end()) );
+}
+
+static
+bool checkQuartiles(const Quartiles& q, string* errorString) {
+    if ( q.Q1 <= q.Q2 && q.Q2 <= q.Q3 )
+        return true;
+    *errorString = "quartiles out of order";
+    return false;
+}
+
+// ------------------------
+// benchmarks
+// ------------------------
+
+static
+bool benchQuartiles(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    vector<int> lengths;
+    makeFragmentLengths(context, &lengths);
+    sort(lengths.begin(), lengths.end());
+
+    measure->start();
+    const Quartiles q = calculateQuartiles(lengths);
+    measure->stop(lengths.size(), 0);
+
+    return checkQuartiles(q, errorString);
+}
+
+static
+bool benchHistogramQuartiles(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    vector<int> lengths;
+    makeFragmentLengths(context, &lengths);
+    vector<uint64_t> histogram(maxValue(lengths) + 1, 0);
+    for ( size_t i = 0; i < lengths.size(); ++i )
+        ++histogram[ lengths[i] ];
+
+    measure->start();
+    const Quartiles q = calculateHistogramQuartiles(histogram);
+    measure->stop(lengths.size(), 0);
+
+    return checkQuartiles(q, errorString);
+}
+
+static
+bool benchRemoveOutliers(const BenchContext& context, BenchMeasure* measure, string* errorString) {
+
+    vector<int> lengths;
+    makeFragmentLengths(context, &lengths);
+    const size_t numValues = lengths.size();
+
+    measure->start();
+    removeOutliers(lengths);
+    measure->stop(numValues, 0);
+    return true;
+}
+
+// ------------------------
+// benchmark group
+// ------------------------
+
+bool runStatsBenchmarks(BenchRunner* runner) {
+    return runner->run("stats_quartiles",           "value", benchQuartiles)          &&
+           runner->run("stats_histogram_quartiles", "value", benchHistogramQuartiles) &&
+           runner->run("stats_remove_outliers",     "value", benchRemoveOutliers);
+}
@@ -0,0 +1,121 @@
+// ***************************************************************************
+// stub_aligner.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Stand-in for MosaikAligner, for end-to-end benchmarks without Mosaik.
+// Reads the FASTQ pair named in the stub read archive & writes every pair
+// as properly-paired alignments, with insert sizes matching the fragment
+// lengths embedded in the synthetic read names.
+// ***************************************************************************
+
+#include "fastq.h"
+#include "fastqreader.h"
+#include "synthetic.h"
+
+#include "bamtools/api/BamAlignment.h"
+#include "bamtools/api/BamWriter.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+static
+void setAlignment(const Fastq& read,
+                  const bool isFirstMate,
+                  const int32_t position,
+                  const int32_t insertSize,
+                  BamTools::BamAlignment* alignment)
+{
+    alignment->Name          = read.Header.substr(1);
+    alignment->QueryBases    = read.Bases;
+    alignment->Qualities     = read.Qualities;
+    alignment->Length        = read.Bases.length();
+    alignment->RefID         = 0;
+    alignment->Position      = position;
+    alignment->MateRefID     = 0;
+    alignment->MatePosition  = position;
+    alignment->MapQuality    = 60;
+    alignment->InsertSize    = ( isFirstMate ? insertSize : -insertSize );
+    alignment->AlignmentFlag = 0x1 | 0x2 | ( isFirstMate ? 0x40 | 0x20 : 0x80 | 0x10 );
+    alignment->CigarData.clear();
+    alignment->CigarData.push_back( BamTools::CigarOp('M', read.Bases.length()) );
+}
+
+static
+int fail(const string& message) {
+    cerr << "MosaikAligner (stub) ERROR: " << message << endl;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+
+    // -in & -out are used, anything else Premo passes is ignored
+    string archiveFilename;
+    string bamStub;
+    for ( int i = 1; i + 1 < argc; ++i ) {
+        const string arg(argv[i]);
+        if ( arg == "-in" )
+            archiveFilename = argv[++i];
+        else if ( arg == "-out" )
+            bamStub = argv[++i];
+    }
+    if ( archiveFilename.empty() || bamStub.empty() )
+        return fail("-in & -out are required");
+
+    // read archive (from stub MosaikBuild) lists the FASTQ pair
+    string fastq1;
+    string fastq2;
+    ifstream archive(archiveFilename.c_str());
+    if ( !getline(archive, fastq1) || !getline(archive, fastq2) )
+        return fail("could not read archive: " + archiveFilename);
+
+    FastqReader reader1;
+    FastqReader reader2;
+    if ( !reader1.open(fastq1) )
+        return fail(reader1.errorString());
+    if ( !reader2.open(fastq2) )
+        return fail(reader2.errorString());
+
+    // MosaikAligner writes <out>.bam
+    BamTools::RefVector references;
+    references.push_back( BamTools::RefData("synthetic", 1000000000) );
+    BamTools::BamWriter writer;
+    if ( !writer.Open(bamStub + ".bam", "@HD\tVN:1.0\tSO:unsorted\n", references) )
+        return fail(writer.GetErrorString());
+
+    Fastq mate1;
+    Fastq mate2;
+    BamTools::BamAlignment alignment;
+    int32_t position = 0;
+
+    while ( reader1.readNext(&mate1) ) {
+        if ( !reader2.readNext(&mate2) )
+            return fail("FASTQ files have different numbers of reads");
+
+        int fragmentLength = 0;
+        if ( !syntheticFragmentLength(mate1.Header, &fragmentLength) )
+            return fail("not a synthetic read: " + mate1.Header);
+        const int32_t insertSize = fragmentLength - mate1.Bases.length() - mate2.Bases.length();
+
+        setAlignment(mate1, true, position, insertSize, &alignment);
+        if ( !writer.SaveAlignment(alignment) )
+            return fail(writer.GetErrorString());
+        setAlignment(mate2, false, position, insertSize, &alignment);
+        if ( !writer.SaveAlignment(alignment) )
+            return fail(writer.GetErrorString());
+
+        position += 10;
+    }
+
+    // N.B. - readNext() also fails at EOF, so only report an error if not finished
+    if ( !reader1.isEOF() )
+        return fail(reader1.errorString());
+    if ( reader2.readNext(&mate2) )
+        return fail("FASTQ files have different numbers of reads");
+
+    writer.Close();
+    return 0;
+}
@@ -0,0 +1,46 @@
+// ***************************************************************************
+// stub_build.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Stand-in for MosaikBuild, for end-to-end benchmarks without Mosaik.
+// The "read archive" is just the two FASTQ filenames, one per line, for
+// the stub MosaikAligner to pick up.
+// ***************************************************************************
+
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc, char* argv[]) {
+
+    // -q, -q2 & -out are used, anything else Premo passes is ignored
+    string fastq1;
+    string fastq2;
+    string archiveFilename;
+    for ( int i = 1; i + 1 < argc; ++i ) {
+        const string arg(argv[i]);
+        if ( arg == "-q" )
+            fastq1 = argv[++i];
+        else if ( arg == "-q2" )
+            fastq2 = argv[++i];
+        else if ( arg == "-out" )
+            archiveFilename = argv[++i];
+    }
+
+    if ( fastq1.empty() || fastq2.empty() || archiveFilename.empty() ) {
+        cerr << "MosaikBuild (stub) ERROR: -q, -q2 & -out are required" << endl;
+        return 1;
+    }
+
+    ofstream archive(archiveFilename.c_str());
+    if ( !archive ) {
+        cerr << "MosaikBuild (stub) ERROR: could not open read archive: " << archiveFilename << endl;
+        return 1;
+    }
+    archive << fastq1 << endl
+            << fastq2 << endl;
+    return ( archive ? 0 : 1 );
+}
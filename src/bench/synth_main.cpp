@@ -0,0 +1,89 @@
+// ***************************************************************************
+// synth_main.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Main entry point for premo_synth, the synthetic paired FASTQ generator
+// ***************************************************************************
+
+#include "synthetic.h"
+
+#include "jsoncpp/json_value.h"
+#include "jsoncpp/json_writer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+static
+void printUsage(void) {
+    cerr << endl
+         << "usage: premo_synth -fq1 file -fq2 file [-pairs n | -mb size] [options]" << endl
+         << endl
+         << "\t-fq1   mate 1 output FASTQ" << endl
+         << "\t-fq2   mate 2 output FASTQ" << endl
+         << "\t-pairs number of read pairs [100000]" << endl
+         << "\t-mb    generate pairs until each FASTQ holds this many MB of text (instead of -pairs)" << endl
+         << "\t-rlmin minimum read length [100]" << endl
+         << "\t-rlmax maximum read length [100]" << endl
+         << "\t-fl    mean fragment length [350]" << endl
+         << "\t-flsd  fragment length standard deviation [35]" << endl
+         << "\t-gz    gzip-compress output" << endl
+         << "\t-seed  random seed [1]" << endl
+         << endl
+         << "read & fragment length quartiles of the generated data are written to stdout as JSON" << endl
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+
+    SyntheticSettings settings;
+    string fastq1;
+    string fastq2;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const string arg(argv[i]);
+        if ( arg == "-h" || arg == "-help" ) {
+            printUsage();
+            return 0;
+        }
+        if ( arg == "-gz" ) {
+            settings.IsCompressed = true;
+            continue;
+        }
+        if ( i + 1 == argc ) {
+            cerr << "premo_synth ERROR: missing value for " << arg << endl;
+            printUsage();
+            return 1;
+        }
+        const string value(argv[++i]);
+        if ( arg == "-fq1" )
+            fastq1 = value;
+        else if ( arg == "-fq2" )
+            fastq2 = value;
+        else if ( !settings.parseOption(arg, value) ) {
+            cerr << "premo_synth ERROR: unknown option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ( fastq1.empty() || fastq2.empty() ) {
+        cerr << "premo_synth ERROR: -fq1 & -fq2 are required" << endl;
+        printUsage();
+        return 1;
+    }
+
+    SyntheticTruth truth;
+    string errorString;
+    if ( !writeSyntheticPairs(settings, fastq1, fastq2, &truth, &errorString) ) {
+        cerr << "premo_synth ERROR: " << errorString << endl;
+        return 1;
+    }
+
+    Json::StyledWriter writer;
+    cout << writer.write( truthToJson(truth) );
+    return 0;
+}
@@ -0,0 +1,235 @@
+// ***************************************************************************
+// synthetic.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Deterministic synthetic reads & paired FASTQ data with known lengths
+// ***************************************************************************
+
+#include "synthetic.h"
+
+#include "fastq.h"
+
+#include "jsoncpp/json_value.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+using namespace std;
+
+static const char* const SYNTHETIC_PREFIX = "synth_";
+
+// ----------------
+// random numbers
+// ----------------
+
+uint64_t nextRandom(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+double nextUniform(uint64_t* state) {
+    // top 53 bits, as a double in [0, 1)
+    return (nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double nextNormal(uint64_t* state) {
+    // Box-Muller (second value discarded, keeps state handling trivial)
+    double u1 = nextUniform(state);
+    while ( u1 <= 0.0 )
+        u1 = nextUniform(state);
+    const double u2 = nextUniform(state);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+void makeRead(const uint64_t index, const unsigned int length, uint64_t* state, Fastq* read) {
+
+    static const char BASES[] = "ACGT";
+
+    char header[64];
+    snprintf(header, sizeof(header), "@bench_read_%llu", static_cast<unsigned long long>(index));
+    read->Header.assign(header);
+
+    read->Bases.resize(length);
+    read->Qualities.resize(length);
+    for ( unsigned int i = 0; i < length; ++i ) {
+        const uint64_t r = nextRandom(state);
+        read->Bases[i]     = BASES[r & 3];
+        read->Qualities[i] = static_cast<char>( '#' + (r >> 8) % 40 );
+    }
+}
+
+// ------------------------------------
+// SyntheticSettings implementation
+// ------------------------------------
+
+bool SyntheticSettings::parseOption(const string& arg, const string& value) {
+
+    if ( arg == "-pairs" ) {
+        NumPairs    = strtoull(value.c_str(), 0, 10);
+        TargetBytes = 0;
+    }
+    else if ( arg == "-mb" ) {
+        NumPairs    = 0;
+        TargetBytes = static_cast<uint64_t>( atof(value.c_str()) * 1000000.0 );
+    }
+    else if ( arg == "-rlmin" )
+        ReadLengthMin = atoi(value.c_str());
+    else if ( arg == "-rlmax" )
+        ReadLengthMax = atoi(value.c_str());
+    else if ( arg == "-fl" )
+        FragmentLengthMean = atof(value.c_str());
+    else if ( arg == "-flsd" )
+        FragmentLengthStdDev = atof(value.c_str());
+    else if ( arg == "-seed" )
+        Seed = strtoull(value.c_str(), 0, 10);
+    else
+        return false;
+    return true;
+}
+
+// ------------------------
+// paired FASTQ generation
+// ------------------------
+
+static
+bool writeEntry(gzFile file, const Fastq& read, uint64_t* numBytes) {
+    const string text = read.Header + "\n" + read.Bases + "\n+\n" + read.Qualities + "\n";
+    *numBytes += text.length();
+    return ( gzwrite(file, text.data(), text.length()) == static_cast<int>(text.length()) );
+}
+
+static
+unsigned int randomReadLength(const SyntheticSettings& settings, uint64_t* state) {
+    const unsigned int range = settings.ReadLengthMax - settings.ReadLengthMin + 1;
+    return settings.ReadLengthMin + static_cast<unsigned int>( nextRandom(state) % range );
+}
+
+bool writeSyntheticPairs(const SyntheticSettings& settings,
+                         const string& fastq1,
+                         const string& fastq2,
+                         SyntheticTruth* truth,
+                         string* errorString)
+{
+    if ( settings.ReadLengthMin == 0 || settings.ReadLengthMin > settings.ReadLengthMax ) {
+        *errorString = "invalid read length range";
+        return false;
+    }
+    if ( settings.NumPairs == 0 && settings.TargetBytes == 0 ) {
+        *errorString = "no pairs requested";
+        return false;
+    }
+
+    // "wbT" writes plain text through the same interface
+    const char* mode = ( settings.IsCompressed ? "wb6" : "wbT" );
+    gzFile file1 = gzopen(fastq1.c_str(), mode);
+    gzFile file2 = gzopen(fastq2.c_str(), mode);
+    if ( file1 == 0 || file2 == 0 ) {
+        *errorString = "could not open synthetic FASTQ files for writing: " + fastq1 + ", " + fastq2;
+        if ( file1 ) gzclose(file1);
+        if ( file2 ) gzclose(file2);
+        return false;
+    }
+
+    uint64_t state = settings.Seed;
+    vector<int> fragmentLengths;
+    vector<int> readLengths;
+    uint64_t numBytes1 = 0;
+    uint64_t numBytes2 = 0;
+    bool isOk = true;
+
+    Fastq mate1;
+    Fastq mate2;
+    char header[64];
+
+    for ( uint64_t i = 0; isOk; ++i ) {
+
+        // stop at requested pair count, or once mate 1 file is large enough
+        if ( settings.NumPairs != 0 ? i >= settings.NumPairs : numBytes1 >= settings.TargetBytes )
+            break;
+
+        const unsigned int length1 = randomReadLength(settings, &state);
+        const unsigned int length2 = randomReadLength(settings, &state);
+
+        // fragment must at least contain both reads
+        const double sample = settings.FragmentLengthMean + settings.FragmentLengthStdDev * nextNormal(&state);
+        const int minFragment = static_cast<int>(length1 + length2);
+        const int fragmentLength = max(minFragment, static_cast<int>( floor(sample + 0.5) ));
+
+        makeRead(i, length1, &state, &mate1);
+        makeRead(i, length2, &state, &mate2);
+
+        snprintf(header, sizeof(header), "@%s%llu_f%d",
+                 SYNTHETIC_PREFIX, static_cast<unsigned long long>(i), fragmentLength);
+        mate1.Header.assign(header);
+        mate2.Header.assign(header);
+
+        isOk = writeEntry(file1, mate1, &numBytes1) &&
+               writeEntry(file2, mate2, &numBytes2);
+
+        fragmentLengths.push_back(fragmentLength);
+        readLengths.push_back(length1);
+        readLengths.push_back(length2);
+    }
+
+    isOk = ( gzclose(file1) == Z_OK ) && isOk;
+    isOk = ( gzclose(file2) == Z_OK ) && isOk;
+    if ( !isOk ) {
+        *errorString = "could not write synthetic FASTQ files: " + fastq1 + ", " + fastq2;
+        return false;
+    }
+
+    sort(fragmentLengths.begin(), fragmentLengths.end());
+    sort(readLengths.begin(), readLengths.end());
+    truth->NumPairs       = fragmentLengths.size();
+    truth->NumBytes       = numBytes1 + numBytes2;
+    truth->FragmentLength = calculateQuartiles(fragmentLengths);
+    truth->ReadLength     = calculateQuartiles(readLengths);
+    return true;
+}
+
+bool syntheticFragmentLength(const string& name, int* fragmentLength) {
+
+    const size_t start = ( !name.empty() && name[0] == '@' ? 1 : 0 );
+    if ( name.compare(start, strlen(SYNTHETIC_PREFIX), SYNTHETIC_PREFIX) != 0 )
+        return false;
+
+    const size_t found = name.rfind("_f");
+    if ( found == string::npos )
+        return false;
+
+    char* end = 0;
+    const char* value = name.c_str() + found + 2;
+    const long length = strtol(value, &end, 10);
+    if ( end == value || length <= 0 )
+        return false;
+
+    *fragmentLength = static_cast<int>(length);
+    return true;
+}
+
+static
+Json::Value quartilesToJson(const Quartiles& q) {
+    Json::Value json(Json::objectValue);
+    json["median"] = q.Q2;
+    json["Q1"]     = q.Q1;
+    json["Q3"]     = q.Q3;
+    return json;
+}
+
+Json::Value truthToJson(const SyntheticTruth& truth) {
+    Json::Value json(Json::objectValue);
+    json["pairs"]           = static_cast<double>(truth.NumPairs);
+    json["bytes"]           = static_cast<double>(truth.NumBytes);
+    json["fragment length"] = quartilesToJson(truth.FragmentLength);
+    json["read length"]     = quartilesToJson(truth.ReadLength);
+    return json;
+}
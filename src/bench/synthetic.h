@@ -0,0 +1,107 @@
+// ***************************************************************************
+// synthetic.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Deterministic synthetic reads & paired FASTQ data with known lengths
+// ***************************************************************************
+
+#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include "stats.h"
+#include <stdint.h>
+#include <string>
+struct Fastq;
+
+namespace Json {
+    class Value;
+} // namespace Json
+
+// random numbers (splitmix64)
+uint64_t nextRandom(uint64_t* state);
+double nextUniform(uint64_t* state);   // [0, 1)
+double nextNormal(uint64_t* state);    // mean 0, standard deviation 1
+
+// random bases & qualities, named after index
+void makeRead(const uint64_t index, const unsigned int length, uint64_t* state, Fastq* read);
+
+// size & length distributions of generated read pairs
+struct SyntheticSettings {
+
+    // data members
+    uint64_t NumPairs;                // if 0, generate TargetBytes instead
+    uint64_t TargetBytes;             // approximate FASTQ text per mate file
+    unsigned int ReadLengthMin;       // read lengths are uniform in [min, max]
+    unsigned int ReadLengthMax;
+    double FragmentLengthMean;        // fragment lengths are normal, but never shorter than both reads
+    double FragmentLengthStdDev;
+    bool IsCompressed;                // gzip output
+    uint64_t Seed;
+
+    // ctors & dtor
+    SyntheticSettings(void)
+        : NumPairs(100000)
+        , TargetBytes(0)
+        , ReadLengthMin(100)
+        , ReadLengthMax(100)
+        , FragmentLengthMean(350.0)
+        , FragmentLengthStdDev(35.0)
+        , IsCompressed(false)
+        , Seed(1)
+    { }
+    SyntheticSettings(const SyntheticSettings& other)
+        : NumPairs(other.NumPairs)
+        , TargetBytes(other.TargetBytes)
+        , ReadLengthMin(other.ReadLengthMin)
+        , ReadLengthMax(other.ReadLengthMax)
+        , FragmentLengthMean(other.FragmentLengthMean)
+        , FragmentLengthStdDev(other.FragmentLengthStdDev)
+        , IsCompressed(other.IsCompressed)
+        , Seed(other.Seed)
+    { }
+    ~SyntheticSettings(void) { }
+
+    // applies a generator command-line option (returns false if arg is not one)
+    // -pairs, -mb, -rlmin, -rlmax, -fl, -flsd, -seed
+    bool parseOption(const std::string& arg, const std::string& value);
+};
+
+// exact quartiles of what was generated
+struct SyntheticTruth {
+
+    // data members
+    uint64_t NumPairs;
+    uint64_t NumBytes;                // FASTQ text, both mates
+    Quartiles FragmentLength;
+    Quartiles ReadLength;
+
+    // ctors & dtor
+    SyntheticTruth(void)
+        : NumPairs(0)
+        , NumBytes(0)
+    { }
+    SyntheticTruth(const SyntheticTruth& other)
+        : NumPairs(other.NumPairs)
+        , NumBytes(other.NumBytes)
+        , FragmentLength(other.FragmentLength)
+        , ReadLength(other.ReadLength)
+    { }
+    ~SyntheticTruth(void) { }
+};
+
+// writes mates to fastq1 & fastq2, with each pair's fragment length embedded in its read name
+bool writeSyntheticPairs(const SyntheticSettings& settings,
+                         const std::string& fastq1,
+                         const std::string& fastq2,
+                         SyntheticTruth* truth,
+                         std::string* errorString);
+
+// JSON form of generated pairs & their quartiles
+Json::Value truthToJson(const SyntheticTruth& truth);
+
+// recovers fragment length from a generated read name (with or without leading '@')
+bool syntheticFragmentLength(const std::string& name, int* fragmentLength);
+
+#endif // SYNTHETIC_H
@@ -2,7 +2,7 @@
 // BamAlignment.cpp (c) 2009 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 4 April 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the BamAlignment data structure
 // ***************************************************************************
@@ -147,6 +147,12 @@ bool BamAlignment::BuildCharData(void) {
     const unsigned int tagDataOffset  = qualDataOffset + SupportData.QuerySequenceLength;
     const unsigned int tagDataLength  = dataLength - tagDataOffset;
 
+    // make sure character data was retained (it is skipped by BamReader::GetNextAlignmentCoreOnly())
+    if ( SupportData.AllCharData.size() != dataLength ) {
+        SetErrorString("BamAlignment::BuildCharData", "alignment character data is not available");
+        return false;
+    }
+
     // check offsets to see what char data exists
     const bool hasSeqData  = ( seqDataOffset  < qualDataOffset );
     const bool hasQualData = ( qualDataOffset < tagDataOffset );
@@ -156,13 +162,15 @@ bool BamAlignment::BuildCharData(void) {
     Name.assign(SupportData.AllCharData.data());
 
     // save query sequence
+    // N.B. - string fields are resized & overwritten (never reserve()-d, which may shrink),
+    //        so an alignment re-used for many records stops allocating once its capacities suffice
     QueryBases.clear();
     if ( hasSeqData ) {
         const char* seqData = SupportData.AllCharData.data() + seqDataOffset;
-        QueryBases.reserve(SupportData.QuerySequenceLength);
+        QueryBases.resize(SupportData.QuerySequenceLength);
         for ( size_t i = 0; i < SupportData.QuerySequenceLength; ++i ) {
             const char singleBase = Constants::BAM_DNA_LOOKUP[ ( (seqData[(i/2)] >> (4*(1-(i%2)))) & 0xf ) ];
-            QueryBases.append(1, singleBase);
+            QueryBases[i] = singleBase;
         }
     }
 
@@ -178,9 +186,9 @@ bool BamAlignment::BuildCharData(void) {
 
         // otherwise convert from numeric QV to 'FASTQ-style' ASCII character
         else {
-            Qualities.reserve(SupportData.QuerySequenceLength);
+            Qualities.resize(SupportData.QuerySequenceLength);
             for ( size_t i = 0; i < SupportData.QuerySequenceLength; ++i )
-                Qualities.append(1, qualData[i]+33);
+                Qualities[i] = qualData[i]+33;
         }
     }
 
@@ -191,8 +199,9 @@ bool BamAlignment::BuildCharData(void) {
     // otherwise, AlignedBases will remain empty (this case IS allowed)
     if ( !QueryBases.empty() && QueryBases != "*" ) {
 
-        // resize AlignedBases
-        AlignedBases.reserve(SupportData.QuerySequenceLength);
+        // resize AlignedBases (only if needed)
+        if ( AlignedBases.capacity() < SupportData.QuerySequenceLength )
+            AlignedBases.reserve(SupportData.QuerySequenceLength);
 
         // iterate over CigarOps
         int k = 0;
@@ -208,7 +217,7 @@ bool BamAlignment::BuildCharData(void) {
                 case (Constants::BAM_CIGAR_INS_CHAR)      :
                 case (Constants::BAM_CIGAR_SEQMATCH_CHAR) :
                 case (Constants::BAM_CIGAR_MISMATCH_CHAR) :
-                    AlignedBases.append(QueryBases.substr(k, op.Length));
+                    AlignedBases.append(QueryBases, k, op.Length);
                     // fall through
 
                 // for 'S' - soft clip, do not write bases
@@ -351,6 +360,37 @@ bool BamAlignment::BuildCharData(void) {
     return true;
 }
 
+/*! \fn bool BamAlignment::BuildName(void)
+    \brief Populates only the read name field.
+
+    Useful when alignments retrieved using BamReader::GetNextAlignmentCore() must be
+    matched by name (e.g. to pair up mates), without the cost of decoding bases,
+    qualities & tag data via BuildCharData().
+
+    \return \c true if read name populated successfully (or was already available to begin with),
+            \c false if it was skipped by BamReader::GetNextAlignmentCoreOnly()
+*/
+bool BamAlignment::BuildName(void) {
+
+    // skip if char data already parsed
+    if ( !SupportData.HasCoreOnly )
+        return true;
+
+    // make sure read name was retained (it is skipped by BamReader::GetNextAlignmentCoreOnly())
+    if ( SupportData.HasSkippedName ) {
+        SetErrorString("BamAlignment::BuildName", "alignment read name is not available");
+        return false;
+    }
+
+    // store alignment name (relies on null char in name as terminator)
+    // N.B. - GetNextAlignmentCoreOnly() stores the name directly, without AllCharData
+    if ( SupportData.QueryNameLength == 0 )
+        Name.clear();
+    else if ( !SupportData.AllCharData.empty() )
+        Name.assign(SupportData.AllCharData.data());
+    return true;
+}
+
 /*! \fn bool BamAlignment::FindTag(const std::string& tag, char*& pTagData, const unsigned int& tagDataLength, unsigned int& numBytesParsed) const
     \internal
 
@@ -407,10 +447,17 @@ bool BamAlignment::FindTag(const std::string& tag,
     \param[in] closedInterval Setting this to true will return a 0-based end coordinate. Default is
                               false, so that his value represents a standard, half-open interval.
 
-    \return alignment end position
+    \return alignment end position, or -1 if the alignment's CIGAR data was skipped by
+            BamReader::GetNextAlignmentCoreOnly() (see GetErrorString())
 */
 int BamAlignment::GetEndPosition(bool usePadded, bool closedInterval) const {
 
+    // make sure CIGAR data was decoded (it is skipped by BamReader::GetNextAlignmentCoreOnly())
+    if ( SupportData.HasSkippedCigar && CigarData.empty() ) {
+        SetErrorString("BamAlignment::GetEndPosition", "alignment CIGAR data is not available");
+        return -1;
+    }
+
     // initialize alignment end to starting position
     int alignEnd = Position;
 
@@ -2,7 +2,7 @@
 // BamAlignment.h (c) 2009 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 16 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the BamAlignment data structure
 // ***************************************************************************
@@ -94,6 +94,9 @@ struct API_EXPORT BamAlignment {
         // populates alignment string fields
         bool BuildCharData(void);
 
+        // populates read name only (much cheaper than BuildCharData(), for core-only alignments)
+        bool BuildName(void);
+
         // calculates alignment end position
         int GetEndPosition(bool usePadded = false, bool closedInterval = false) const;
 
@@ -150,6 +153,8 @@ struct API_EXPORT BamAlignment {
             uint32_t    QueryNameLength;
             uint32_t    QuerySequenceLength;
             bool        HasCoreOnly;
+            bool        HasSkippedName;   // set by BamReader::GetNextAlignmentCoreOnly()
+            bool        HasSkippedCigar;  // set by BamReader::GetNextAlignmentCoreOnly()
             
             // constructor
             BamAlignmentSupportData(void)
@@ -158,6 +163,8 @@ struct API_EXPORT BamAlignment {
                 , QueryNameLength(0)
                 , QuerySequenceLength(0)
                 , HasCoreOnly(false)
+                , HasSkippedName(false)
+                , HasSkippedCigar(false)
             { }
         };
         BamAlignmentSupportData SupportData;
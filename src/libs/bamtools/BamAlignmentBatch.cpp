@@ -0,0 +1,157 @@
+// ***************************************************************************
+// BamAlignmentBatch.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides a columnar (structure-of-arrays) batch of BAM alignment core fields
+// ***************************************************************************
+
+#include "BamAlignmentBatch.h"
+using namespace BamTools;
+using namespace std;
+
+/*! \class BamTools::BamAlignmentBatch
+    \brief The main BAM alignment batch data structure.
+
+    Holds the core fields of up to N alignments as parallel columns (one
+    std::vector per field), as filled by BamReader::GetNextAlignmentBatch().
+    Alignment i's fields are RefID[i], Position[i], etc.
+
+    Read names & CIGAR operations are only filled if requested via
+    OptionalColumns. Each is stored back-to-back in a single container, with
+    per-alignment offsets, so that a batch re-used for many reads stops
+    allocating once its capacities suffice.
+*/
+
+/*! \var BamAlignmentBatch::OptionalColumns
+    \brief bitwise OR of BamAlignmentBatch::Column values (name & CIGAR columns to fill)
+*/
+/*! \var BamAlignmentBatch::RefID
+    \brief ID numbers for reference sequences
+*/
+/*! \var BamAlignmentBatch::Position
+    \brief positions (0-based) where alignments start
+*/
+/*! \var BamAlignmentBatch::Bin
+    \brief BAM (standard) index bin numbers
+*/
+/*! \var BamAlignmentBatch::MapQuality
+    \brief mapping quality scores
+*/
+/*! \var BamAlignmentBatch::AlignmentFlag
+    \brief alignment bit-flags (see BamAlignment for flag meanings)
+*/
+/*! \var BamAlignmentBatch::Length
+    \brief lengths of query sequences
+*/
+/*! \var BamAlignmentBatch::MateRefID
+    \brief ID numbers for reference sequences where alignments' mates were aligned
+*/
+/*! \var BamAlignmentBatch::MatePosition
+    \brief positions (0-based) where alignments' mates start
+*/
+/*! \var BamAlignmentBatch::InsertSize
+    \brief mate-pair insert sizes
+*/
+/*! \var BamAlignmentBatch::NameData
+    \brief null-terminated read names, back-to-back (only if NameColumn requested)
+*/
+/*! \var BamAlignmentBatch::NameOffsets
+    \brief offset of each alignment's read name in NameData (only if NameColumn requested)
+*/
+/*! \var BamAlignmentBatch::CigarData
+    \brief CIGAR operations, back-to-back (only if CigarColumn requested)
+*/
+/*! \var BamAlignmentBatch::CigarOffsets
+    \brief offset of each alignment's first CIGAR operation in CigarData (only if CigarColumn requested)
+*/
+
+/*! \fn BamAlignmentBatch::BamAlignmentBatch(const int optionalColumns = NoColumns)
+    \brief constructor
+
+    \param[in] optionalColumns bitwise OR of BamAlignmentBatch::Column values
+*/
+BamAlignmentBatch::BamAlignmentBatch(const int optionalColumns)
+    : OptionalColumns(optionalColumns)
+{ }
+
+/*! \fn BamAlignmentBatch::~BamAlignmentBatch(void)
+    \brief destructor
+*/
+BamAlignmentBatch::~BamAlignmentBatch(void) { }
+
+/*! \fn void BamAlignmentBatch::Clear(void)
+    \brief Removes all alignments from batch.
+
+    Column capacities are kept, for re-use.
+*/
+void BamAlignmentBatch::Clear(void) {
+    RefID.clear();
+    Position.clear();
+    Bin.clear();
+    MapQuality.clear();
+    AlignmentFlag.clear();
+    Length.clear();
+    MateRefID.clear();
+    MatePosition.clear();
+    InsertSize.clear();
+    NameData.clear();
+    NameOffsets.clear();
+    CigarData.clear();
+    CigarOffsets.clear();
+}
+
+/*! \fn const CigarOp* BamAlignmentBatch::GetCigarData(const size_t index) const
+    \brief Returns CIGAR operations of alignment at \a index.
+
+    Requires CigarColumn to have been filled.
+
+    \param[in] index alignment index in batch
+    \return pointer to alignment's first CIGAR operation (0 if it has none)
+    \sa GetCigarLength()
+*/
+const CigarOp* BamAlignmentBatch::GetCigarData(const size_t index) const {
+    if ( GetCigarLength(index) == 0 )
+        return 0;
+    return &CigarData[ CigarOffsets[index] ];
+}
+
+/*! \fn uint32_t BamAlignmentBatch::GetCigarLength(const size_t index) const
+    \brief Returns number of CIGAR operations of alignment at \a index.
+
+    Requires CigarColumn to have been filled.
+
+    \param[in] index alignment index in batch
+    \sa GetCigarData()
+*/
+uint32_t BamAlignmentBatch::GetCigarLength(const size_t index) const {
+    const size_t end = ( index+1 < CigarOffsets.size() ? CigarOffsets[index+1] : CigarData.size() );
+    return end - CigarOffsets[index];
+}
+
+/*! \fn const char* BamAlignmentBatch::GetName(const size_t index) const
+    \brief Returns read name of alignment at \a index.
+
+    Requires NameColumn to have been filled.
+
+    \param[in] index alignment index in batch
+    \return null-terminated read name
+*/
+const char* BamAlignmentBatch::GetName(const size_t index) const {
+    return NameData.data() + NameOffsets[index];
+}
+
+/*! \fn bool BamAlignmentBatch::IsEmpty(void) const
+    \brief Returns \c true if batch holds no alignments.
+*/
+bool BamAlignmentBatch::IsEmpty(void) const {
+    return RefID.empty();
+}
+
+/*! \fn size_t BamAlignmentBatch::Size(void) const
+    \brief Returns number of alignments in batch.
+*/
+size_t BamAlignmentBatch::Size(void) const {
+    return RefID.size();
+}
@@ -0,0 +1,79 @@
+// ***************************************************************************
+// BamAlignmentBatch.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides a columnar (structure-of-arrays) batch of BAM alignment core fields
+// ***************************************************************************
+
+#ifndef BAMALIGNMENTBATCH_H
+#define BAMALIGNMENTBATCH_H
+
+#include "api_global.h"
+#include "BamAux.h"
+#include <string>
+#include <vector>
+
+namespace BamTools {
+
+// BamAlignmentBatch data structure
+struct API_EXPORT BamAlignmentBatch {
+
+    // optional columns
+    public:
+        enum Column { NoColumns   = 0x0
+                    , NameColumn  = 0x1
+                    , CigarColumn = 0x2
+                    };
+
+    // ctor & dtor
+    public:
+        BamAlignmentBatch(const int optionalColumns = NoColumns);
+        ~BamAlignmentBatch(void);
+
+    // BamAlignmentBatch interface
+    public:
+        // removes all alignments (keeping column capacities, for re-use)
+        void Clear(void);
+        // returns CIGAR operations of alignment at index (requires CigarColumn)
+        const CigarOp* GetCigarData(const size_t index) const;
+        // returns number of CIGAR operations of alignment at index (requires CigarColumn)
+        uint32_t GetCigarLength(const size_t index) const;
+        // returns read name of alignment at index (requires NameColumn)
+        const char* GetName(const size_t index) const;
+        // returns true if batch holds no alignments
+        bool IsEmpty(void) const;
+        // returns number of alignments in batch
+        size_t Size(void) const;
+
+    // public data fields
+    public:
+        int OptionalColumns;                  // bitwise OR of Column values, to be filled by BamReader
+
+        // core columns (one entry per alignment)
+        std::vector<int32_t>  RefID;          // ID number for reference sequence
+        std::vector<int32_t>  Position;       // position (0-based) where alignment starts
+        std::vector<uint16_t> Bin;            // BAM (standard) index bin number for this alignment
+        std::vector<uint16_t> MapQuality;     // mapping quality score
+        std::vector<uint32_t> AlignmentFlag;  // alignment bit-flag
+        std::vector<int32_t>  Length;         // length of query sequence
+        std::vector<int32_t>  MateRefID;      // ID number for reference sequence where alignment's mate was aligned
+        std::vector<int32_t>  MatePosition;   // position (0-based) where alignment's mate starts
+        std::vector<int32_t>  InsertSize;     // mate-pair insert size
+
+        // optional name column (null-terminated names, back-to-back)
+        // N.B. - name i starts at NameData[NameOffsets[i]]
+        std::string           NameData;
+        std::vector<uint32_t> NameOffsets;
+
+        // optional CIGAR column (all alignments' CIGAR operations, back-to-back)
+        // N.B. - alignment i's operations start at CigarData[CigarOffsets[i]]
+        //        (use GetCigarData() & GetCigarLength())
+        std::vector<CigarOp>  CigarData;
+        std::vector<uint32_t> CigarOffsets;
+};
+
+} // namespace BamTools
+
+#endif // BAMALIGNMENTBATCH_H
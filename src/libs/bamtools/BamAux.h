@@ -2,7 +2,7 @@
 // BamAux.h (c) 2009 Derek Barnett, Michael Str�mberg
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides data structures & utility methods that are used throughout the API.
 // ***************************************************************************
@@ -133,6 +133,63 @@ struct API_EXPORT BamRegion {
     }
 };
 
+// ----------------------------------------------------------------
+// BamCoreFilter
+
+/*! \struct BamTools::BamCoreFilter
+    \brief Represents a predicate over alignment core fields
+
+    An alignment passes if it meets all of the filter's criteria. A
+    default-constructed filter accepts all alignments.
+
+    \sa BamReader::SetFilter()
+*/
+struct API_EXPORT BamCoreFilter {
+
+    uint32_t RequiredFlags;     //!< alignment flag bits that must all be set
+    uint32_t ExcludedFlags;     //!< alignment flag bits that must all be unset
+    uint16_t MinMapQuality;     //!< minimum mapping quality
+    std::vector<int> RefIDs;    //!< accepted reference IDs (-1 for unmapped), empty to accept any
+    int32_t  MinInsertSize;     //!< minimum absolute insert size
+    int32_t  MaxInsertSize;     //!< maximum absolute insert size (negative for no limit)
+
+    //! constructor
+    BamCoreFilter(void)
+        : RequiredFlags(0)
+        , ExcludedFlags(0)
+        , MinMapQuality(0)
+        , MinInsertSize(0)
+        , MaxInsertSize(-1)
+    { }
+
+    //! Returns true if filter accepts all alignments
+    bool isNull(void) const {
+        return ( RequiredFlags == 0 && ExcludedFlags == 0 && MinMapQuality == 0 &&
+                 RefIDs.empty() && MinInsertSize <= 0 && MaxInsertSize < 0 );
+    }
+};
+
+// ----------------------------------------------------------------
+// BlockCacheStatistics
+
+/*! \struct BamTools::BlockCacheStatistics
+    \brief Represents hit/miss counts of a BamReader's decompressed-block cache
+
+    \sa BamReader::SetBlockCacheSize(), BamReader::GetBlockCacheStatistics()
+*/
+struct API_EXPORT BlockCacheStatistics {
+
+    uint64_t NumHits;    //!< number of blocks taken from cache
+    uint64_t NumMisses;  //!< number of blocks that had to be read & decompressed
+
+    //! constructor
+    BlockCacheStatistics(const uint64_t& numHits   = 0,
+                         const uint64_t& numMisses = 0)
+        : NumHits(numHits)
+        , NumMisses(numMisses)
+    { }
+};
+
 // ----------------------------------------------------------------
 // General utility methods
 
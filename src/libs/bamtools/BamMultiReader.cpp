@@ -2,7 +2,7 @@
 // BamMultiReader.cpp (c) 2010 Erik Garrison, Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Convenience class for reading multiple BAM files.
 //
@@ -321,6 +321,30 @@ bool BamMultiReader::Rewind(void) {
     return d->Rewind();
 }
 
+/*! \fn void BamMultiReader::SetBlockCacheSize(size_t numBytes)
+    \brief Sets memory used to cache each file's decompressed BAM data.
+
+    Applies to all current readers, and to any files opened later.
+
+    \param[in] numBytes cache size, in bytes, per file (0, the default, disables the cache)
+    \sa BamReader::SetBlockCacheSize()
+*/
+void BamMultiReader::SetBlockCacheSize(size_t numBytes) {
+    d->SetBlockCacheSize(numBytes);
+}
+
+/*! \fn void BamMultiReader::SetNumThreads(int numThreads)
+    \brief Sets number of threads used to decompress each file's BAM data.
+
+    Applies to all current readers, and to any files opened later.
+
+    \param[in] numThreads number of decompression threads, per file (1, the default, disables read-ahead)
+    \sa BamReader::SetNumThreads()
+*/
+void BamMultiReader::SetNumThreads(int numThreads) {
+    d->SetNumThreads(numThreads);
+}
+
 /*! \fn bool BamMultiReader::SetRegion(const BamRegion& region)
     \brief Sets a target region of interest
 
@@ -2,7 +2,7 @@
 // BamMultiReader.h (c) 2010 Erik Garrison, Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Convenience class for reading multiple BAM files.
 // ***************************************************************************
@@ -53,6 +53,10 @@ class API_EXPORT BamMultiReader {
         bool OpenFile(const std::string& filename);
         // returns file pointers to beginning of alignments
         bool Rewind(void);
+        // sets memory used to cache each file's decompressed blocks, for random access
+        void SetBlockCacheSize(size_t numBytes);
+        // sets number of threads used to decompress each file's BAM data
+        void SetNumThreads(int numThreads);
         // sets the target region of interest
         bool SetRegion(const BamRegion& region);
         // sets the target region of interest
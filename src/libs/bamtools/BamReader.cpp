@@ -2,7 +2,7 @@
 // BamReader.cpp (c) 2009 Derek Barnett, Michael Str�mberg
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides read access to BAM files.
 // ***************************************************************************
@@ -61,6 +61,19 @@ bool BamReader::CreateIndex(const BamIndex::IndexType& type) {
     return d->CreateIndex(type);
 }
 
+/*! \fn BlockCacheStatistics BamReader::GetBlockCacheStatistics(void) const
+    \brief Returns hit/miss counts of the decompressed-block cache.
+
+    Counts start from zero each time a file is opened. Both stay zero while
+    the cache is disabled.
+
+    \returns cache statistics for current BAM file
+    \sa SetBlockCacheSize()
+*/
+BlockCacheStatistics BamReader::GetBlockCacheStatistics(void) const {
+    return d->GetBlockCacheStatistics();
+}
+
 /*! \fn std::string BamReader::GetErrorString(void) const
     \brief Returns a human-readable description of the last error that occurred
 
@@ -147,6 +160,30 @@ bool BamReader::GetNextAlignment(BamAlignment& alignment) {
     return d->GetNextAlignment(alignment);
 }
 
+/*! \fn bool BamReader::GetNextAlignmentBatch(BamAlignmentBatch& batch, const size_t maxAlignments)
+    \brief Retrieves a batch of next available alignments, as columns of core fields.
+
+    Equivalent to calling GetNextAlignmentCore() up to \a maxAlignments times,
+    with respect to what is a valid overlapping alignment. However, only core
+    fields (plus read names and/or CIGAR operations, if requested via
+    BamAlignmentBatch::OptionalColumns) are stored, one column per field.
+    This avoids per-alignment object overhead when scanning many alignments
+    for a few fields.
+
+    \a batch is cleared first. Re-using one batch object for each call avoids
+    re-allocating its columns.
+
+    \param[out] batch         destination for alignment core data
+    \param[in]  maxAlignments maximum number of alignments to retrieve
+    \returns \c true if at least one valid alignment was found. If fewer than
+              \a maxAlignments were found, check GetErrorString() to distinguish
+              end of data from a read error.
+    \sa BamAlignmentBatch, SetRegion()
+*/
+bool BamReader::GetNextAlignmentBatch(BamAlignmentBatch& batch, const size_t maxAlignments) {
+    return d->GetNextAlignmentBatch(batch, maxAlignments);
+}
+
 /*! \fn bool BamReader::GetNextAlignmentCore(BamAlignment& alignment)
     \brief Retrieves next available alignment, without populating the alignment's string data fields.
 
@@ -165,6 +202,57 @@ bool BamReader::GetNextAlignmentCore(BamAlignment& alignment) {
     return d->GetNextAlignmentCore(alignment);
 }
 
+/*! \fn bool BamReader::GetNextAlignmentCoreOnly(BamAlignment& alignment, bool decodeCigar = false)
+    \brief Retrieves next available alignment's core fields, skipping over its variable-length data.
+
+    Equivalent to GetNextAlignmentCore() with respect to what is a valid overlapping alignment.
+
+    However, the alignment's variable-length data (read name, CIGAR, bases, qualities,
+    tags) is skipped in the decompressed stream rather than copied. Only the core fields
+    (RefID, Position, MapQuality, AlignmentFlag, Length, MateRefID, MatePosition,
+    InsertSize, etc.) are populated. This makes scans over those fields (e.g. collecting
+    insert sizes) bound by BGZF decompression alone.
+
+    CIGAR operations are only decoded if \a decodeCigar is \c true. Otherwise
+    \a alignment's CigarData is left empty, and BamAlignment::GetEndPosition() returns -1.
+    (While a region is set, CIGAR data of alignments starting before the region are still
+    decoded internally, to find their overlap.)
+
+    \note Because its character data is not retained, BamAlignment::BuildCharData()
+    and BamAlignment::BuildName() fail on an alignment retrieved this way, and
+    BamWriter::SaveAlignment() refuses it.
+
+    \param[out] alignment   destination for alignment core data
+    \param[in]  decodeCigar if \c true, also populate the alignment's CigarData
+    \returns \c true if a valid alignment was found
+    \sa GetNextAlignmentCore(), GetNextAlignmentBatch(), SetRegion()
+*/
+bool BamReader::GetNextAlignmentCoreOnly(BamAlignment& alignment, bool decodeCigar) {
+    return d->GetNextAlignmentCoreOnly(alignment, decodeCigar);
+}
+
+/*! \fn bool BamReader::GetNextRecordView(BamRecordView& record)
+    \brief Retrieves next available alignment as a zero-copy view.
+
+    Equivalent to GetNextAlignment() with respect to what is a valid overlapping alignment.
+
+    However, no record data is copied into a BamAlignment. Core fields are decoded
+    into \a record, while its variable-length data (read name, CIGAR, sequence,
+    qualities, tags) is accessed in BAM's packed form, directly within the
+    decompressed BGZF block. Records straddling BGZF blocks are copied into a
+    buffer owned by \a record, so steady-state reading does not allocate.
+
+    \warning Data pointers returned by \a record are only valid until the next
+    read from this BamReader (including GetNextAlignment() & Jump()/SetRegion()).
+
+    \param[out] record destination view for alignment record data
+    \returns \c true if a valid alignment was found
+    \sa BamRecordView, SetRegion()
+*/
+bool BamReader::GetNextRecordView(BamRecordView& record) {
+    return d->GetNextRecordView(record);
+}
+
 /*! \fn int BamReader::GetReferenceCount(void) const
     \brief Returns number of reference sequences.
 */
@@ -287,6 +375,54 @@ bool BamReader::Rewind(void) {
     return d->Rewind();
 }
 
+/*! \fn void BamReader::SetBlockCacheSize(size_t numBytes)
+    \brief Sets memory used to cache decompressed BAM data.
+
+    Recently decompressed blocks are kept, so that Jump() or SetRegion() calls
+    landing in the same blocks (e.g. overlapping region queries) do not have to
+    read & decompress them again. Least-recently used blocks are dropped once the
+    limit is reached. The cache is only used for random-access (e.g. local file)
+    input.
+
+    May be called before or after Open(). The setting is kept for subsequently
+    opened files.
+
+    \param[in] numBytes cache size, in bytes (0, the default, disables the cache)
+    \sa GetBlockCacheStatistics(), Jump(), SetRegion()
+*/
+void BamReader::SetBlockCacheSize(size_t numBytes) {
+    d->SetBlockCacheSize(numBytes);
+}
+
+/*! \fn void BamReader::SetFilter(const BamCoreFilter& filter)
+    \brief Sets a predicate over core fields that alignments must pass.
+
+    Alignments are checked as soon as their fixed-length core data is read.
+    Rejected alignments are skipped without copying (or parsing) their read
+    name, CIGAR, sequence, qualities or tag data.
+
+    Applies to GetNextAlignment(), GetNextAlignmentCore(),
+    GetNextAlignmentCoreOnly(), GetNextAlignmentBatch() & GetNextRecordView(),
+    and combines with any region set by SetRegion(). Index creation still
+    sees every alignment.
+
+    May be called before or after Open(). The setting is kept for subsequently
+    opened files.
+
+    Example:
+    \code
+        BamCoreFilter filter;
+        filter.ExcludedFlags = 0x4 | 0x400;  // skip unmapped reads & duplicates
+        filter.MinMapQuality = 20;
+        reader.SetFilter(filter);
+    \endcode
+
+    \param[in] filter core-field predicate (BamCoreFilter(), the default, accepts all alignments)
+*/
+void BamReader::SetFilter(const BamCoreFilter& filter) {
+    d->SetFilter(filter);
+}
+
 /*! \fn void BamReader::SetIndex(BamIndex* index)
     \brief Sets a custom BamIndex on this reader.
 
@@ -310,6 +446,22 @@ void BamReader::SetIndex(BamIndex* index) {
     d->SetIndex(index);
 }
 
+/*! \fn void BamReader::SetNumThreads(int numThreads)
+    \brief Sets number of threads used to decompress BAM data.
+
+    With more than one thread, compressed blocks are read ahead of the current
+    position & decompressed in parallel. Alignments are still returned in file order,
+    and Jump(), Rewind() & SetRegion() behave exactly as before.
+
+    May be called before or after Open(). The setting is kept for subsequently
+    opened files.
+
+    \param[in] numThreads number of decompression threads (1, the default, disables read-ahead)
+*/
+void BamReader::SetNumThreads(int numThreads) {
+    d->SetNumThreads(numThreads);
+}
+
 /*! \fn bool BamReader::SetRegion(const BamRegion& region)
     \brief Sets a target region of interest
 
@@ -2,7 +2,7 @@
 // BamReader.h (c) 2009 Derek Barnett, Michael Str�mberg
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 10 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides read access to BAM files.
 // ***************************************************************************
@@ -12,7 +12,9 @@
 
 #include "api_global.h"
 #include "BamAlignment.h"
+#include "BamAlignmentBatch.h"
 #include "BamIndex.h"
+#include "BamRecordView.h"
 #include "SamHeader.h"
 #include <string>
 
@@ -38,6 +40,8 @@ class API_EXPORT BamReader {
 
         // closes the current BAM file
         bool Close(void);
+        // returns hit/miss counts of decompressed-block cache
+        BlockCacheStatistics GetBlockCacheStatistics(void) const;
         // returns filename of current BAM file
         const std::string GetFilename(void) const;
         // returns true if a BAM file is open for reading
@@ -48,6 +52,12 @@ class API_EXPORT BamReader {
         bool Open(const std::string& filename);
         // returns internal file pointer to beginning of alignment data
         bool Rewind(void);
+        // sets memory used to cache decompressed blocks, for random access
+        void SetBlockCacheSize(size_t numBytes);
+        // sets core-field filter that alignments must pass (BamCoreFilter() to clear)
+        void SetFilter(const BamCoreFilter& filter);
+        // sets number of threads used to decompress BAM data
+        void SetNumThreads(int numThreads);
         // sets the target region of interest
         bool SetRegion(const BamRegion& region);
         // sets the target region of interest
@@ -62,8 +72,14 @@ class API_EXPORT BamReader {
 
         // retrieves next available alignment
         bool GetNextAlignment(BamAlignment& alignment);
+        // retrieves up to maxAlignments next available alignments, as columns of core fields
+        bool GetNextAlignmentBatch(BamAlignmentBatch& batch, const size_t maxAlignments);
         // retrieves next available alignmnet (without populating the alignment's string data fields)
         bool GetNextAlignmentCore(BamAlignment& alignment);
+        // retrieves next available alignment's core fields only (skipping its string & CIGAR data)
+        bool GetNextAlignmentCoreOnly(BamAlignment& alignment, bool decodeCigar = false);
+        // retrieves next available alignment as a zero-copy view (valid until next read)
+        bool GetNextRecordView(BamRecordView& record);
 
         // ----------------------
         // access header data
@@ -0,0 +1,240 @@
+// ***************************************************************************
+// BamRecordView.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides read-only, zero-copy access to a BAM record's fields
+// ***************************************************************************
+
+#include "BamConstants.h"
+#include "BamRecordView.h"
+using namespace BamTools;
+using namespace std;
+
+// reads little-endian 32-bit value from (possibly unaligned) record data
+static inline uint32_t unpackRecordValue(const char* buffer, const bool isBigEndian) {
+    uint32_t value = BamTools::UnpackUnsignedInt(buffer);
+    if ( isBigEndian ) BamTools::SwapEndian_32(value);
+    return value;
+}
+
+/*! \class BamTools::BamRecordView
+    \brief Provides read-only, zero-copy access to a BAM record's fields.
+
+    A BamRecordView is filled by BamReader::GetNextRecordView(). Core fields
+    are decoded when the record is read, but the read name, CIGAR, sequence,
+    qualities & tag data are left in BAM's packed binary form and returned as
+    pointers into the reader's decompressed block. Records that straddle BGZF
+    blocks are copied into a buffer owned by the view (whose capacity is
+    re-used for subsequent records).
+
+    \warning Pointers returned by a view are only valid until the next read from
+    the BamReader that filled it (or until the reader is closed). Use BamAlignment
+    & BamReader::GetNextAlignment() if record data must outlive that.
+*/
+
+/*! \fn BamRecordView::BamRecordView(void)
+    \brief constructor
+*/
+BamRecordView::BamRecordView(void)
+    : m_refID(-1)
+    , m_position(-1)
+    , m_bin(0)
+    , m_mapQuality(0)
+    , m_alignmentFlag(0)
+    , m_length(0)
+    , m_mateRefID(-1)
+    , m_matePosition(-1)
+    , m_insertSize(0)
+    , m_numCigarOperations(0)
+    , m_charData(0)
+    , m_charDataLength(0)
+    , m_queryNameLength(0)
+    , m_tagDataOffset(0)
+    , m_isBigEndian(BamTools::SystemIsBigEndian())
+{ }
+
+/*! \fn BamRecordView::~BamRecordView(void)
+    \brief destructor
+*/
+BamRecordView::~BamRecordView(void) { }
+
+/*! \fn char BamRecordView::GetBase(const int32_t index) const
+    \brief Decodes a single query base.
+
+    \param[in] index position in query sequence (0 <= index < Length())
+    \return base character (one of "=ACMGRSVTWYHKDBN")
+*/
+char BamRecordView::GetBase(const int32_t index) const {
+    const char packed = PackedSequence()[index/2];
+    return Constants::BAM_DNA_LOOKUP[ ( (packed >> (4*(1-(index%2)))) & 0xf ) ];
+}
+
+/*! \fn CigarOp BamRecordView::GetCigarOp(const uint32_t index) const
+    \brief Decodes a single CIGAR operation.
+
+    \param[in] index CIGAR operation index (0 <= index < NumCigarOperations())
+    \return CIGAR operation
+*/
+CigarOp BamRecordView::GetCigarOp(const uint32_t index) const {
+    const uint32_t packed = unpackRecordValue(PackedCigar() + index*sizeof(uint32_t), m_isBigEndian);
+    return CigarOp( Constants::BAM_CIGAR_LOOKUP[ (packed & Constants::BAM_CIGAR_MASK) ],
+                    (packed >> Constants::BAM_CIGAR_SHIFT) );
+}
+
+/*! \fn int BamRecordView::GetEndPosition(bool usePadded = false, bool closedInterval = false) const
+    \brief Calculates alignment end position, based on its starting position and CIGAR data.
+
+    Same semantics as BamAlignment::GetEndPosition(), but decodes the packed
+    CIGAR operations directly.
+
+    \param[in] usePadded      Allow inserted bases to affect the reported position.
+    \param[in] closedInterval Setting this to true will return a 0-based end coordinate.
+
+    \return alignment end position
+*/
+int BamRecordView::GetEndPosition(bool usePadded, bool closedInterval) const {
+
+    // initialize alignment end to starting position
+    int alignEnd = m_position;
+
+    // iterate over cigar operations
+    for ( uint32_t i = 0; i < m_numCigarOperations; ++i ) {
+        const CigarOp op = GetCigarOp(i);
+
+        switch ( op.Type ) {
+
+            // increase end position on CIGAR chars [DMXN=]
+            case Constants::BAM_CIGAR_DEL_CHAR      :
+            case Constants::BAM_CIGAR_MATCH_CHAR    :
+            case Constants::BAM_CIGAR_MISMATCH_CHAR :
+            case Constants::BAM_CIGAR_REFSKIP_CHAR  :
+            case Constants::BAM_CIGAR_SEQMATCH_CHAR :
+                alignEnd += op.Length;
+                break;
+
+            // increase end position on insertion, only if @usePadded is true
+            case Constants::BAM_CIGAR_INS_CHAR :
+                if ( usePadded )
+                    alignEnd += op.Length;
+                break;
+
+            // all other CIGAR chars do not affect end position
+            default :
+                break;
+        }
+    }
+
+    // adjust for closedInterval, if requested
+    if ( closedInterval )
+        alignEnd -= 1;
+
+    // return result
+    return alignEnd;
+}
+
+// points view at record data (block length bytes, starting at core data)
+// returns false if record's variable-length sections exceed its block length
+bool BamRecordView::Load(const char* record, const uint32_t blockLength) {
+
+    // make sure core data is present
+    if ( blockLength < Constants::BAM_CORE_SIZE )
+        return false;
+
+    // unpack core data
+    m_refID    = (int32_t)unpackRecordValue(&record[0], m_isBigEndian);
+    m_position = (int32_t)unpackRecordValue(&record[4], m_isBigEndian);
+
+    uint32_t tempValue = unpackRecordValue(&record[8], m_isBigEndian);
+    m_bin             = tempValue >> 16;
+    m_mapQuality      = tempValue >> 8 & 0xff;
+    m_queryNameLength = tempValue & 0xff;
+
+    tempValue = unpackRecordValue(&record[12], m_isBigEndian);
+    m_alignmentFlag      = tempValue >> 16;
+    m_numCigarOperations = tempValue & 0xffff;
+
+    m_length       = (int32_t)unpackRecordValue(&record[16], m_isBigEndian);
+    m_mateRefID    = (int32_t)unpackRecordValue(&record[20], m_isBigEndian);
+    m_matePosition = (int32_t)unpackRecordValue(&record[24], m_isBigEndian);
+    m_insertSize   = (int32_t)unpackRecordValue(&record[28], m_isBigEndian);
+
+    // point at variable-length data
+    m_charData       = record + Constants::BAM_CORE_SIZE;
+    m_charDataLength = blockLength - Constants::BAM_CORE_SIZE;
+
+    // make sure variable-length sections fit in record
+    if ( m_length < 0 )
+        return false;
+    const uint64_t sequenceLength = (uint64_t)m_length;
+    const uint64_t tagDataOffset  = m_queryNameLength +
+                                    m_numCigarOperations * sizeof(uint32_t) +
+                                    (sequenceLength+1)/2 +
+                                    sequenceLength;
+    if ( tagDataOffset > m_charDataLength )
+        return false;
+    m_tagDataOffset = (uint32_t)tagDataOffset;
+    return true;
+}
+
+/*! \fn const char* BamRecordView::Name(void) const
+    \brief Returns read name (null-terminated).
+*/
+const char* BamRecordView::Name(void) const {
+    return m_charData;
+}
+
+/*! \fn uint32_t BamRecordView::NameLength(void) const
+    \brief Returns read name length (not counting the terminating null).
+*/
+uint32_t BamRecordView::NameLength(void) const {
+    return ( m_queryNameLength > 0 ? m_queryNameLength - 1 : 0 );
+}
+
+/*! \fn const char* BamRecordView::PackedCigar(void) const
+    \brief Returns packed CIGAR operations.
+
+    Data holds NumCigarOperations() little-endian 32-bit values, each encoding
+    (length << 4 | type). Use GetCigarOp() to decode them.
+*/
+const char* BamRecordView::PackedCigar(void) const {
+    return m_charData + m_queryNameLength;
+}
+
+/*! \fn const char* BamRecordView::PackedSequence(void) const
+    \brief Returns packed query sequence.
+
+    Data holds (Length()+1)/2 bytes, each encoding two bases (high nybble first).
+    Use GetBase() to decode them.
+*/
+const char* BamRecordView::PackedSequence(void) const {
+    return PackedCigar() + m_numCigarOperations*sizeof(uint32_t);
+}
+
+/*! \fn const char* BamRecordView::Qualities(void) const
+    \brief Returns raw base qualities.
+
+    Data holds Length() Phred values (without the +33 offset used by
+    BamAlignment::Qualities), or 0xFF bytes if the record stores no qualities.
+*/
+const char* BamRecordView::Qualities(void) const {
+    return PackedSequence() + (m_length+1)/2;
+}
+
+/*! \fn const char* BamRecordView::TagData(void) const
+    \brief Returns raw tag data.
+
+    Data holds TagDataLength() bytes, in BAM's binary tag format. Multi-byte
+    values are stored little-endian.
+*/
+const char* BamRecordView::TagData(void) const {
+    return m_charData + m_tagDataOffset;
+}
+
+/*! \fn uint32_t BamRecordView::TagDataLength(void) const
+    \brief Returns tag data length (bytes).
+*/
+uint32_t BamRecordView::TagDataLength(void) const {
+    return m_charDataLength - m_tagDataOffset;
+}
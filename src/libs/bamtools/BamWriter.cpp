@@ -2,7 +2,7 @@
 // BamWriter.cpp (c) 2009 Michael Str�mberg, Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for producing BAM files
 // ***************************************************************************
@@ -150,3 +150,21 @@ bool BamWriter::SaveAlignment(const BamAlignment& alignment) {
 void BamWriter::SetCompressionMode(const BamWriter::CompressionMode& compressionMode) {
     d->SetWriteCompressed( compressionMode == BamWriter::Compressed );
 }
+
+/*! \fn void BamWriter::SetNumThreads(int numThreads)
+    \brief Sets number of threads used to compress BAM data.
+
+    With more than one thread, filled blocks are compressed in parallel & written,
+    in order, from a background thread. SaveAlignment() only blocks when all threads
+    are busy. Any write error is reported by a later call to SaveAlignment(), or by
+    GetErrorString() after Close().
+
+    May be called before or after Open(). The setting is kept for subsequently
+    opened files.
+
+    \param[in] numThreads number of compression threads (1, the default, compresses on the caller's thread)
+    \sa Close(), GetErrorString()
+*/
+void BamWriter::SetNumThreads(int numThreads) {
+    d->SetNumThreads(numThreads);
+}
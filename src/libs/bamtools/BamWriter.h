@@ -2,7 +2,7 @@
 // BamWriter.h (c) 2009 Michael Str�mberg, Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 10 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for producing BAM files
 // ***************************************************************************
@@ -58,6 +58,8 @@ class API_EXPORT BamWriter {
         bool SaveAlignment(const BamAlignment& alignment);
         // sets the output compression mode
         void SetCompressionMode(const BamWriter::CompressionMode& compressionMode);
+        // sets number of threads used to compress BAM data
+        void SetNumThreads(int numThreads);
 
     // private implementation
     private:
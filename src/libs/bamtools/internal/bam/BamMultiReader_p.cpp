@@ -2,7 +2,7 @@
 // BamMultiReader_p.cpp (c) 2010 Derek Barnett, Erik Garrison
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Functionality for simultaneously reading multiple BAM files
 // *************************************************************************
@@ -25,6 +25,8 @@ using namespace std;
 // ctor
 BamMultiReaderPrivate::BamMultiReaderPrivate(void)
     : m_alignmentCache(0)
+    , m_blockCacheSize(0)
+    , m_numThreads(1)
 { }
 
 // dtor
@@ -437,6 +439,8 @@ bool BamMultiReaderPrivate::Open(const vector<string>& filenames) {
 
         // attempt to open BamReader
         BamReader* reader = new BamReader;
+        reader->SetBlockCacheSize(m_blockCacheSize);
+        reader->SetNumThreads(m_numThreads);
         const bool readerOpened = reader->Open(filename);
 
         // if opened OK, store it
@@ -622,11 +626,37 @@ void BamMultiReaderPrivate::SaveNextAlignment(BamReader* reader, BamAlignment* a
         m_alignmentCache->Add( MergeItem(reader, alignment) );
 }
 
+void BamMultiReaderPrivate::SetBlockCacheSize(size_t numBytes) {
+
+    m_blockCacheSize = numBytes;
+
+    // apply to current readers
+    vector<MergeItem>::iterator readerIter = m_readers.begin();
+    vector<MergeItem>::iterator readerEnd  = m_readers.end();
+    for ( ; readerIter != readerEnd; ++readerIter ) {
+        BamReader* reader = (*readerIter).Reader;
+        if ( reader ) reader->SetBlockCacheSize(numBytes);
+    }
+}
+
 void BamMultiReaderPrivate::SetErrorString(const string& where, const string& what) const {
     static const string SEPARATOR = ": ";
     m_errorString = where + SEPARATOR + what;
 }
 
+void BamMultiReaderPrivate::SetNumThreads(int numThreads) {
+
+    m_numThreads = numThreads;
+
+    // apply to current readers
+    vector<MergeItem>::iterator readerIter = m_readers.begin();
+    vector<MergeItem>::iterator readerEnd  = m_readers.end();
+    for ( ; readerIter != readerEnd; ++readerIter ) {
+        BamReader* reader = (*readerIter).Reader;
+        if ( reader ) reader->SetNumThreads(numThreads);
+    }
+}
+
 bool BamMultiReaderPrivate::SetRegion(const BamRegion& region) {
 
     // NB: While it may make sense to track readers in which we can
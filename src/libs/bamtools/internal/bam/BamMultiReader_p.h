@@ -2,7 +2,7 @@
 // BamMultiReader_p.h (c) 2010 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Functionality for simultaneously reading multiple BAM files
 // *************************************************************************
@@ -51,6 +51,8 @@ class BamMultiReaderPrivate {
         bool Open(const std::vector<std::string>& filenames);
         bool OpenFile(const std::string& filename);
         bool Rewind(void);
+        void SetBlockCacheSize(size_t numBytes);
+        void SetNumThreads(int numThreads);
         bool SetRegion(const BamRegion& region);
 
         // access alignment data
@@ -90,6 +92,8 @@ class BamMultiReaderPrivate {
     public:
         std::vector<MergeItem> m_readers;
         IMultiMerger* m_alignmentCache;
+        size_t m_blockCacheSize;
+        int m_numThreads;
         mutable std::string m_errorString;
 };
 
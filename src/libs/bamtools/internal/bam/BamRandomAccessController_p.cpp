@@ -2,12 +2,14 @@
 // BamRandomAccessController_p.cpp (c) 2011 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011(DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Manages random access operations in a BAM file
 // **************************************************************************
 
+#include "BamAlignment.h"
 #include "BamIndex.h"
+#include "BamRecordView.h"
 #include "internal/bam/BamRandomAccessController_p.h"
 #include "internal/bam/BamReader_p.h"
 #include "internal/index/BamIndexFactory_p.h"
@@ -56,45 +58,55 @@ void BamRandomAccessController::AdjustRegion(const int& referenceCount) {
     }
 }
 
-// returns alignments' "RegionState": { Before|Overlaps|After } current region
-BamRandomAccessController::RegionState
-BamRandomAccessController::AlignmentState(const BamAlignment& alignment) const {
+namespace BamTools {
+namespace Internal {
+
+// returns record's "RegionState": { Before|Overlaps|After } region
+// N.B. - Record must provide GetEndPosition(), which is only called for records
+//        starting before the region's left bound
+template<typename Record>
+BamRandomAccessController::RegionState regionState(const BamRegion& region,
+                                                   const int refID,
+                                                   const int position,
+                                                   const Record& alignment)
+{
+    typedef BamRandomAccessController RAC;
 
     // if region has no left bound at all
-    if ( !m_region.isLeftBoundSpecified() )
-        return OverlapsRegion;
+    if ( !region.isLeftBoundSpecified() )
+        return RAC::OverlapsRegion;
 
     // handle unmapped reads - return AFTER region to halt processing
-    if ( alignment.RefID == -1 )
-        return AfterRegion;
+    if ( refID == -1 )
+        return RAC::AfterRegion;
 
     // if alignment is on any reference before left bound reference
-    if ( alignment.RefID < m_region.LeftRefID )
-        return BeforeRegion;
+    if ( refID < region.LeftRefID )
+        return RAC::BeforeRegion;
 
     // if alignment is on left bound reference
-    else if ( alignment.RefID == m_region.LeftRefID ) {
+    else if ( refID == region.LeftRefID ) {
 
         // if alignment starts at or after left bound position
-        if ( alignment.Position >= m_region.LeftPosition) {
+        if ( position >= region.LeftPosition) {
 
-            if ( m_region.isRightBoundSpecified() &&             // right bound is specified AND
-                 m_region.LeftRefID == m_region.RightRefID &&    // left & right bounds on same reference AND
-                 alignment.Position >= m_region.RightPosition )  // alignment starts on or after right bound position
-                return AfterRegion;
+            if ( region.isRightBoundSpecified() &&           // right bound is specified AND
+                 region.LeftRefID == region.RightRefID &&  // left & right bounds on same reference AND
+                 position >= region.RightPosition )        // alignment starts on or after right bound position
+                return RAC::AfterRegion;
 
             // otherwise, alignment overlaps region
-            else return OverlapsRegion;
+            else return RAC::OverlapsRegion;
         }
 
         // alignment starts before left bound position
         else {
 
             // if alignment overlaps left bound position
-            if ( alignment.GetEndPosition() > m_region.LeftPosition )
-                return OverlapsRegion;
+            if ( alignment.GetEndPosition() > region.LeftPosition )
+                return RAC::OverlapsRegion;
             else
-                return BeforeRegion;
+                return RAC::BeforeRegion;
         }
     }
 
@@ -102,32 +114,54 @@ BamRandomAccessController::AlignmentState(const BamAlignment& alignment) const {
     else {
 
         // if region has a right bound
-        if ( m_region.isRightBoundSpecified() ) {
+        if ( region.isRightBoundSpecified() ) {
 
             // alignment is on any reference between boundaries
-            if ( alignment.RefID < m_region.RightRefID )
-                return OverlapsRegion;
+            if ( refID < region.RightRefID )
+                return RAC::OverlapsRegion;
 
             // alignment is on any reference after right boundary
-            else if ( alignment.RefID > m_region.RightRefID )
-                return AfterRegion;
+            else if ( refID > region.RightRefID )
+                return RAC::AfterRegion;
 
             // alignment is on right bound reference
             else {
 
                 // if alignment starts before right bound position
-                if ( alignment.Position < m_region.RightPosition )
-                    return OverlapsRegion;
+                if ( position < region.RightPosition )
+                    return RAC::OverlapsRegion;
                 else
-                    return AfterRegion;
+                    return RAC::AfterRegion;
             }
         }
 
         // otherwise, alignment starts after left bound and there is no right bound given
-        else return OverlapsRegion;
+        else return RAC::OverlapsRegion;
     }
 }
 
+// record known only by its start position
+// N.B. - only valid for regionState() checks that don't need the record's end position
+struct StartOnlyRecord {
+    int Position;
+    int GetEndPosition(void) const { return Position; }
+};
+
+} // namespace Internal
+} // namespace BamTools
+
+// returns alignments' "RegionState": { Before|Overlaps|After } current region
+BamRandomAccessController::RegionState
+BamRandomAccessController::AlignmentState(const BamAlignment& alignment) const {
+    return regionState(m_region, alignment.RefID, alignment.Position, alignment);
+}
+
+// returns record view's "RegionState": { Before|Overlaps|After } current region
+BamRandomAccessController::RegionState
+BamRandomAccessController::AlignmentState(const BamRecordView& record) const {
+    return regionState(m_region, record.RefID(), record.Position(), record);
+}
+
 void BamRandomAccessController::Close(void) {
     ClearIndex();
     ClearRegion();
@@ -194,6 +228,27 @@ bool BamRandomAccessController::IndexHasAlignmentsForReference(const int& refId)
     return m_index->HasAlignments(refId);
 }
 
+// returns true if alignment at refID:position starts after current region
+// (used to stop reading, e.g. at alignments rejected before their CIGAR ops are decoded)
+bool BamRandomAccessController::IsAfterRegion(const int refID, const int position) const {
+
+    // alignments starting before region's left bound are never after it
+    if ( IsEndPositionNeeded(refID, position) )
+        return false;
+
+    StartOnlyRecord record;
+    record.Position = position;
+    return ( regionState(m_region, refID, position, record) == AfterRegion );
+}
+
+// returns true if alignment's end position is needed to determine its RegionState
+// (i.e. alignment starts before region's left bound, on the same reference)
+bool BamRandomAccessController::IsEndPositionNeeded(const int refID, const int position) const {
+    return ( m_region.isLeftBoundSpecified() &&
+             refID == m_region.LeftRefID &&
+             position < m_region.LeftPosition );
+}
+
 bool BamRandomAccessController::LocateIndex(BamReaderPrivate* reader,
                                             const BamIndex::IndexType& preferredType)
 {
@@ -2,7 +2,7 @@
 // BamRandomAccessController_p.h (c) 2011 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 10 October 2011(DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Manages random access operations in a BAM file
 // ***************************************************************************
@@ -26,6 +26,7 @@
 namespace BamTools {
 
 class BamAlignment;
+class BamRecordView;
 
 namespace Internal {
 
@@ -59,7 +60,10 @@ class BamRandomAccessController {
         // region methods
         void ClearRegion(void);
         bool HasRegion(void) const;
+        bool IsAfterRegion(const int refID, const int position) const;
+        bool IsEndPositionNeeded(const int refID, const int position) const;
         RegionState AlignmentState(const BamAlignment& alignment) const;
+        RegionState AlignmentState(const BamRecordView& record) const;
         bool RegionHasAlignments(void) const;
         bool SetRegion(const BamRegion& region, const int& referenceCount);
 
@@ -2,7 +2,7 @@
 // BamReader_p.cpp (c) 2009 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 28 November 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for reading BAM files
 // ***************************************************************************
@@ -31,6 +31,7 @@ using namespace std;
 BamReaderPrivate::BamReaderPrivate(BamReader* parent)
     : m_alignmentsBeginOffset(0)
     , m_parent(parent)
+    , m_hasFilter(false)
 {
     m_isBigEndian = BamTools::SystemIsBigEndian();
 }
@@ -89,11 +90,38 @@ bool BamReaderPrivate::CreateIndex(const BamIndex::IndexType& type) {
     }
 }
 
+// decodes alignment's packed CIGAR ops (little-endian, as stored in BAM) into CigarData
+void BamReaderPrivate::DecodeCigarData(BamAlignment& alignment, const char* cigarData) const {
+
+    // N.B. - values are swapped as they are unpacked, source data keeps BAM (little-endian) byte order
+    CigarOp op;
+    alignment.CigarData.clear();
+    alignment.CigarData.reserve(alignment.SupportData.NumCigarOperations);
+    for ( unsigned int i = 0; i < alignment.SupportData.NumCigarOperations; ++i ) {
+
+        // swap endian-ness if necessary
+        uint32_t cigarValue = BamTools::UnpackUnsignedInt(&cigarData[i*sizeof(uint32_t)]);
+        if ( m_isBigEndian ) BamTools::SwapEndian_32(cigarValue);
+
+        // build CigarOp structure
+        op.Length = (cigarValue >> Constants::BAM_CIGAR_SHIFT);
+        op.Type   = Constants::BAM_CIGAR_LOOKUP[ (cigarValue & Constants::BAM_CIGAR_MASK) ];
+
+        // save CigarOp
+        alignment.CigarData.push_back(op);
+    }
+}
+
 // return path & filename of current BAM file
 const string BamReaderPrivate::Filename(void) const {
     return m_filename;
 }
 
+BlockCacheStatistics BamReaderPrivate::GetBlockCacheStatistics(void) const {
+    const BgzfBlockCache& cache = m_stream.BlockCache();
+    return BlockCacheStatistics(cache.NumHits(), cache.NumMisses());
+}
+
 string BamReaderPrivate::GetErrorString(void) const {
     return m_errorString;
 }
@@ -132,6 +160,48 @@ bool BamReaderPrivate::GetNextAlignment(BamAlignment& alignment) {
     return false;
 }
 
+// retrieves up to maxAlignments next available alignments, as columns of core fields
+// (returns true if any were found)
+bool BamReaderPrivate::GetNextAlignmentBatch(BamAlignmentBatch& batch, const size_t maxAlignments) {
+
+    batch.Clear();
+
+    const bool isNameRequested  = ( (batch.OptionalColumns & BamAlignmentBatch::NameColumn)  != 0 );
+    const bool isCigarRequested = ( (batch.OptionalColumns & BamAlignmentBatch::CigarColumn) != 0 );
+
+    // append alignments' fields to batch columns
+    // (GetNextAlignmentCoreOnly() handles region-overlap checks & error reporting)
+    BamAlignment& alignment = m_batchAlignment;
+    while ( batch.Size() < maxAlignments &&
+            GetNextAlignmentCoreOnly(alignment, isCigarRequested, isNameRequested) )
+    {
+        batch.RefID.push_back(alignment.RefID);
+        batch.Position.push_back(alignment.Position);
+        batch.Bin.push_back(alignment.Bin);
+        batch.MapQuality.push_back(alignment.MapQuality);
+        batch.AlignmentFlag.push_back(alignment.AlignmentFlag);
+        batch.Length.push_back(alignment.Length);
+        batch.MateRefID.push_back(alignment.MateRefID);
+        batch.MatePosition.push_back(alignment.MatePosition);
+        batch.InsertSize.push_back(alignment.InsertSize);
+
+        // store name, with its null terminator
+        if ( isNameRequested ) {
+            batch.NameOffsets.push_back(batch.NameData.size());
+            batch.NameData.append(alignment.Name);
+            batch.NameData.push_back('\0');
+        }
+
+        // store CIGAR ops
+        if ( isCigarRequested ) {
+            batch.CigarOffsets.push_back(batch.CigarData.size());
+            batch.CigarData.insert(batch.CigarData.end(), alignment.CigarData.begin(), alignment.CigarData.end());
+        }
+    }
+
+    return !batch.IsEmpty();
+}
+
 // retrieves next available alignment core data (returns success/fail)
 // ** DOES NOT populate any character data fields (read name, bases, qualities, tag data, filename)
 //    these can be accessed, if necessary, from the supportData
@@ -152,7 +222,7 @@ bool BamReaderPrivate::GetNextAlignmentCore(BamAlignment& alignment) {
         }
 
         // if can't read next alignment
-        if ( !LoadNextAlignment(alignment) )
+        if ( !LoadNextAlignment(alignment, true) )
             return false;
 
         // check alignment's region-overlap state
@@ -166,7 +236,7 @@ bool BamReaderPrivate::GetNextAlignmentCore(BamAlignment& alignment) {
         while ( state != BamRandomAccessController::OverlapsRegion ) {
 
             // if can't read next alignment
-            if ( !LoadNextAlignment(alignment) )
+            if ( !LoadNextAlignment(alignment, true) )
                 return false;
 
             // check alignment's region-overlap state
@@ -190,6 +260,109 @@ bool BamReaderPrivate::GetNextAlignmentCore(BamAlignment& alignment) {
     }
 }
 
+// retrieves next available alignment core data, skipping (not copying) its variable-length data
+// ** DOES NOT populate any character data fields, and leaves supportData's AllCharData empty
+//    (so BuildCharData() is not available). CIGAR ops are only decoded if decodeCigar is true.
+bool BamReaderPrivate::GetNextAlignmentCoreOnly(BamAlignment& alignment,
+                                                const bool decodeCigar,
+                                                const bool readName)
+{
+    // skip if stream not opened
+    if ( !m_stream.IsOpen() )
+        return false;
+
+    try {
+
+        // skip if region is set but has no alignments
+        if ( m_randomAccessController.HasRegion() &&
+             !m_randomAccessController.RegionHasAlignments() )
+        {
+            return false;
+        }
+
+        // read until overlap is found
+        while ( true ) {
+
+            // if can't read next alignment
+            if ( !LoadNextAlignmentCoreOnly(alignment, decodeCigar, readName) )
+                return false;
+
+            // check alignment's region-overlap state
+            const BamRandomAccessController::RegionState state = m_randomAccessController.AlignmentState(alignment);
+
+            // if alignment starts after region, no need to keep reading
+            if ( state == BamRandomAccessController::AfterRegion )
+                return false;
+
+            // if we get here, we found the next 'valid' alignment
+            if ( state == BamRandomAccessController::OverlapsRegion ) {
+                alignment.SupportData.HasCoreOnly = true;
+                return true;
+            }
+        }
+
+    } catch ( BamException& e ) {
+        const string streamError = e.what();
+        const string message = string("encountered error reading BAM alignment: \n\t") + streamError;
+        SetErrorString("BamReader::GetNextAlignmentCoreOnly", message);
+        return false;
+    }
+}
+
+// retrieves next available alignment as a zero-copy view (returns success/fail)
+// ** record's variable-length data is only valid until the next read
+bool BamReaderPrivate::GetNextRecordView(BamRecordView& record) {
+
+    // skip if stream not opened
+    if ( !m_stream.IsOpen() )
+        return false;
+
+    try {
+
+        // skip if region is set but has no alignments
+        if ( m_randomAccessController.HasRegion() &&
+             !m_randomAccessController.RegionHasAlignments() )
+        {
+            return false;
+        }
+
+        // read until overlap is found
+        while ( true ) {
+
+            // if can't read next alignment
+            if ( !LoadNextRecordView(record) )
+                return false;
+
+            // skip alignment if rejected by filter
+            // (unless it starts after region, then no need to keep reading)
+            if ( m_hasFilter &&
+                 !IsFilterAccepted(record.RefID(), record.AlignmentFlag(), record.MapQuality(), record.InsertSize()) )
+            {
+                if ( m_randomAccessController.IsAfterRegion(record.RefID(), record.Position()) )
+                    return false;
+                continue;
+            }
+
+            // check alignment's region-overlap state
+            const BamRandomAccessController::RegionState state = m_randomAccessController.AlignmentState(record);
+
+            // if alignment starts after region, no need to keep reading
+            if ( state == BamRandomAccessController::AfterRegion )
+                return false;
+
+            // if we get here, we found the next 'valid' alignment
+            if ( state == BamRandomAccessController::OverlapsRegion )
+                return true;
+        }
+
+    } catch ( BamException& e ) {
+        const string streamError = e.what();
+        const string message = string("encountered error reading BAM alignment: \n\t") + streamError;
+        SetErrorString("BamReader::GetNextRecordView", message);
+        return false;
+    }
+}
+
 int BamReaderPrivate::GetReferenceCount(void) const {
     return m_references.size();
 }
@@ -218,17 +391,46 @@ bool BamReaderPrivate::HasIndex(void) const {
     return m_randomAccessController.HasIndex();
 }
 
-bool BamReaderPrivate::IsOpen(void) const {
-    return m_stream.IsOpen();
+// returns true if alignment core fields pass current filter
+bool BamReaderPrivate::IsFilterAccepted(const int32_t refID,
+                                        const uint32_t alignmentFlag,
+                                        const uint16_t mapQuality,
+                                        const int32_t insertSize) const
+{
+    // check flags & mapping quality
+    if ( (alignmentFlag & m_filter.RequiredFlags) != m_filter.RequiredFlags )
+        return false;
+    if ( (alignmentFlag & m_filter.ExcludedFlags) != 0 )
+        return false;
+    if ( mapQuality < m_filter.MinMapQuality )
+        return false;
+
+    // check reference (lookup table is empty if any reference is accepted)
+    if ( !m_isFilterRefIdAccepted.empty() ) {
+        if ( refID < -1 || (size_t)(refID+1) >= m_isFilterRefIdAccepted.size() )
+            return false;
+        if ( !m_isFilterRefIdAccepted[refID+1] )
+            return false;
+    }
+
+    // check absolute insert size (widened, so that INT32_MIN is handled)
+    const int64_t absInsertSize = ( insertSize < 0 ? -(int64_t)insertSize : (int64_t)insertSize );
+    if ( absInsertSize < m_filter.MinInsertSize )
+        return false;
+    if ( m_filter.MaxInsertSize >= 0 && absInsertSize > m_filter.MaxInsertSize )
+        return false;
+
+    // all criteria met
+    return true;
 }
 
-// load BAM header data
-void BamReaderPrivate::LoadHeaderData(void) {
-    m_header.Load(&m_stream);
+bool BamReaderPrivate::IsOpen(void) const {
+    return m_stream.IsOpen();
 }
 
-// populates BamAlignment with alignment data under file pointer, returns success/fail
-bool BamReaderPrivate::LoadNextAlignment(BamAlignment& alignment) {
+// populates BamAlignment 'core' & 'support' data with alignment under file pointer,
+// leaving file pointer at alignment's variable-length data (returns success/fail)
+bool BamReaderPrivate::LoadAlignmentCore(BamAlignment& alignment) {
 
     // read in the 'block length' value, make sure it's not zero
     char buffer[sizeof(uint32_t)];
@@ -271,43 +473,149 @@ bool BamReaderPrivate::LoadNextAlignment(BamAlignment& alignment) {
     // set BamAlignment length
     alignment.Length = alignment.SupportData.QuerySequenceLength;
 
+    // nothing skipped yet (see LoadNextAlignmentCoreOnly())
+    alignment.SupportData.HasSkippedName  = false;
+    alignment.SupportData.HasSkippedCigar = false;
+
+    return true;
+}
+
+// retrieves block length & core data of next alignment passing filter, returns success/fail
+// N.B. - rejected alignments' variable-length data is skipped, not copied
+bool BamReaderPrivate::LoadFilteredAlignmentCore(BamAlignment& alignment) {
+
+    while ( LoadAlignmentCore(alignment) ) {
+
+        // if alignment passes filter
+        if ( !m_hasFilter ||
+             IsFilterAccepted(alignment.RefID, alignment.AlignmentFlag, alignment.MapQuality, alignment.InsertSize) )
+        {
+            return true;
+        }
+
+        // if alignment starts after region, no need to keep reading
+        if ( m_randomAccessController.IsAfterRegion(alignment.RefID, alignment.Position) )
+            return false;
+
+        // skip rejected alignment's variable-length data
+        if ( alignment.SupportData.BlockLength < Constants::BAM_CORE_SIZE )
+            throw BamException("BamReader::LoadFilteredAlignmentCore", "invalid BAM record lengths");
+        const unsigned int dataLength = alignment.SupportData.BlockLength - Constants::BAM_CORE_SIZE;
+        if ( m_stream.Skip(dataLength) != dataLength )
+            return false;
+    }
+
+    // end of data
+    return false;
+}
+
+// load BAM header data
+void BamReaderPrivate::LoadHeaderData(void) {
+    m_header.Load(&m_stream);
+}
+
+// populates BamAlignment with alignment data under file pointer, returns success/fail
+bool BamReaderPrivate::LoadNextAlignment(BamAlignment& alignment, const bool isFiltered) {
+
+    // read in block length & core alignment data (of next alignment passing filter, if requested)
+    const bool isCoreLoaded = ( isFiltered ? LoadFilteredAlignmentCore(alignment)
+                                           : LoadAlignmentCore(alignment) );
+    if ( !isCoreLoaded )
+        return false;
+
     // read in character data - make sure proper data size was read
-    bool readCharDataOK = false;
+    // N.B. - reads directly into AllCharData, re-using its capacity from previous records
     const unsigned int dataLength = alignment.SupportData.BlockLength - Constants::BAM_CORE_SIZE;
-    RaiiBuffer allCharData(dataLength);
+    string& allCharData = alignment.SupportData.AllCharData;
+    allCharData.resize(dataLength);
+    if ( dataLength > 0 && m_stream.Read(&allCharData[0], dataLength) != dataLength )
+        return false;
+
+    // save CIGAR ops
+    // need to calculate this here so that  BamAlignment::GetEndPosition() performs correctly,
+    // even when GetNextAlignmentCore() is called
+    DecodeCigarData(alignment, allCharData.data() + alignment.SupportData.QueryNameLength);
+    return true;
+}
 
-    if ( m_stream.Read(allCharData.Buffer, dataLength) == dataLength ) {
+// populates BamAlignment core data with alignment under file pointer, skipping (not copying)
+// its variable-length data, returns success/fail
+// N.B. - the read name is only stored if readName is true. CIGAR ops are only decoded if decodeCigar
+//        is true, or if they're needed to check the alignment's region-overlap state.
+bool BamReaderPrivate::LoadNextAlignmentCoreOnly(BamAlignment& alignment,
+                                                 const bool decodeCigar,
+                                                 const bool readName)
+{
+    // read in block length & core data of next alignment passing filter
+    if ( !LoadFilteredAlignmentCore(alignment) )
+        return false;
 
-        // store 'allCharData' in supportData structure
-        alignment.SupportData.AllCharData.assign((const char*)allCharData.Buffer, dataLength);
+    // mark character data as skipped
+    alignment.SupportData.AllCharData.clear();
+    alignment.CigarData.clear();
+
+    // make sure name & CIGAR fit in record
+    const unsigned int dataLength  = alignment.SupportData.BlockLength - Constants::BAM_CORE_SIZE;
+    const unsigned int nameLength  = alignment.SupportData.QueryNameLength;
+    const unsigned int cigarLength = alignment.SupportData.NumCigarOperations * sizeof(uint32_t);
+    if ( alignment.SupportData.BlockLength < Constants::BAM_CORE_SIZE ||
+         nameLength + cigarLength > dataLength )
+    {
+        throw BamException("BamReader::LoadNextAlignmentCoreOnly", "invalid BAM record lengths");
+    }
+    unsigned int numBytesConsumed = 0;
+
+    // store read name, if requested (dropping its null terminator)
+    alignment.Name.clear();
+    alignment.SupportData.HasSkippedName = !readName;
+    if ( readName && nameLength > 0 ) {
+        const char* name = m_stream.ReadInPlace(nameLength, m_spillBuffer);
+        if ( name == 0 )
+            return false;
+        alignment.Name.assign(name, nameLength - 1);
+        numBytesConsumed = nameLength;
+    }
 
-        // set success flag
-        readCharDataOK = true;
+    // decode CIGAR ops, if requested or needed for region-overlap check (GetEndPosition())
+    const bool isCigarNeeded = ( decodeCigar ||
+                                 m_randomAccessController.IsEndPositionNeeded(alignment.RefID, alignment.Position) );
+    alignment.SupportData.HasSkippedCigar = ( !isCigarNeeded && cigarLength > 0 );
+    if ( isCigarNeeded && cigarLength > 0 ) {
+        if ( m_stream.Skip(nameLength - numBytesConsumed) != nameLength - numBytesConsumed )
+            return false;
+        const char* cigarData = m_stream.ReadInPlace(cigarLength, m_spillBuffer);
+        if ( cigarData == 0 )
+            return false;
+        DecodeCigarData(alignment, cigarData);
+        numBytesConsumed = nameLength + cigarLength;
+    }
 
-        // save CIGAR ops
-        // need to calculate this here so that  BamAlignment::GetEndPosition() performs correctly,
-        // even when GetNextAlignmentCore() is called
-        const unsigned int cigarDataOffset = alignment.SupportData.QueryNameLength;
-        uint32_t* cigarData = (uint32_t*)(allCharData.Buffer + cigarDataOffset);
-        CigarOp op;
-        alignment.CigarData.clear();
-        alignment.CigarData.reserve(alignment.SupportData.NumCigarOperations);
-        for ( unsigned int i = 0; i < alignment.SupportData.NumCigarOperations; ++i ) {
+    // skip remaining variable-length data
+    const unsigned int skipLength = dataLength - numBytesConsumed;
+    return ( m_stream.Skip(skipLength) == skipLength );
+}
 
-            // swap endian-ness if necessary
-            if ( m_isBigEndian ) BamTools::SwapEndian_32(cigarData[i]);
+// points record view at BAM alignment under file pointer
+bool BamReaderPrivate::LoadNextRecordView(BamRecordView& record) {
 
-            // build CigarOp structure
-            op.Length = (cigarData[i] >> Constants::BAM_CIGAR_SHIFT);
-            op.Type   = Constants::BAM_CIGAR_LOOKUP[ (cigarData[i] & Constants::BAM_CIGAR_MASK) ];
+    // read in the 'block length' value, make sure it's not zero
+    char buffer[sizeof(uint32_t)];
+    fill_n(buffer, sizeof(uint32_t), 0);
+    m_stream.Read(buffer, sizeof(uint32_t));
+    uint32_t blockLength = BamTools::UnpackUnsignedInt(buffer);
+    if ( m_isBigEndian ) BamTools::SwapEndian_32(blockLength);
+    if ( blockLength == 0 )
+        return false;
 
-            // save CigarOp
-            alignment.CigarData.push_back(op);
-        }
-    }
+    // read in core & character data, make sure the right size of data was read
+    const char* data = m_stream.ReadInPlace(blockLength, record.m_spillBuffer);
+    if ( data == 0 )
+        return false;
 
-    // return success/failure
-    return readCharDataOK;
+    // decode core data (checking that variable-length sections fit)
+    if ( !record.Load(data, blockLength) )
+        throw BamException("BamReader::LoadNextRecordView", "invalid BAM record lengths");
+    return true;
 }
 
 // loads reference data from BAM file
@@ -438,15 +746,46 @@ bool BamReaderPrivate::Seek(const int64_t& position) {
     }
 }
 
+void BamReaderPrivate::SetBlockCacheSize(size_t numBytes) {
+    m_stream.SetBlockCacheSize(numBytes);
+}
+
 void BamReaderPrivate::SetErrorString(const string& where, const string& what) {
     static const string SEPARATOR = ": ";
     m_errorString = where + SEPARATOR + what;
 }
 
+void BamReaderPrivate::SetFilter(const BamCoreFilter& filter) {
+
+    m_filter = filter;
+    m_hasFilter = !filter.isNull();
+
+    // compile accepted RefIDs into lookup table (indexed by RefID+1, so unmapped -1 is slot 0)
+    m_isFilterRefIdAccepted.clear();
+    if ( filter.RefIDs.empty() )
+        return;
+    m_isFilterRefIdAccepted.assign(1, false);
+    vector<int>::const_iterator refIter = filter.RefIDs.begin();
+    vector<int>::const_iterator refEnd  = filter.RefIDs.end();
+    for ( ; refIter != refEnd; ++refIter ) {
+        const int refID = (*refIter);
+        if ( refID < -1 )
+            continue;
+        if ( (size_t)(refID+1) >= m_isFilterRefIdAccepted.size() )
+            m_isFilterRefIdAccepted.resize(refID+2, false);
+        m_isFilterRefIdAccepted[refID+1] = true;
+    }
+}
+
 void BamReaderPrivate::SetIndex(BamIndex* index) {
     m_randomAccessController.SetIndex(index);
 }
 
+// sets number of threads used to decompress BAM data
+void BamReaderPrivate::SetNumThreads(int numThreads) {
+    m_stream.SetNumThreads(numThreads);
+}
+
 // sets current region & attempts to jump to it
 // returns success/failure
 bool BamReaderPrivate::SetRegion(const BamRegion& region) {
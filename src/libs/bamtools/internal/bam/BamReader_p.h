@@ -2,7 +2,7 @@
 // BamReader_p.h (c) 2010 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for reading BAM files
 // ***************************************************************************
@@ -21,13 +21,16 @@
 // We mean it.
 
 #include "BamAlignment.h"
+#include "BamAlignmentBatch.h"
 #include "BamIndex.h"
 #include "BamReader.h"
+#include "BamRecordView.h"
 #include "SamHeader.h"
 #include "internal/bam/BamHeader_p.h"
 #include "internal/bam/BamRandomAccessController_p.h"
 #include "internal/io/BgzfStream_p.h"
 #include <string>
+#include <vector>
 
 namespace BamTools {
 namespace Internal {
@@ -48,13 +51,22 @@ class BamReaderPrivate {
         bool IsOpen(void) const;
         bool Open(const std::string& filename);
         bool Rewind(void);
+        void SetBlockCacheSize(size_t numBytes);
+        void SetFilter(const BamCoreFilter& filter);
+        void SetNumThreads(int numThreads);
         bool SetRegion(const BamRegion& region);
 
         // access alignment data
         bool GetNextAlignment(BamAlignment& alignment);
+        bool GetNextAlignmentBatch(BamAlignmentBatch& batch, const size_t maxAlignments);
         bool GetNextAlignmentCore(BamAlignment& alignment);
+        bool GetNextAlignmentCoreOnly(BamAlignment& alignment,
+                                      const bool decodeCigar,
+                                      const bool readName = false);
+        bool GetNextRecordView(BamRecordView& record);
 
         // access auxiliary data
+        BlockCacheStatistics GetBlockCacheStatistics(void) const;
         std::string GetHeaderText(void) const;
         SamHeader GetSamHeader(void) const;
         int GetReferenceCount(void) const;
@@ -81,7 +93,17 @@ class BamReaderPrivate {
         void LoadHeaderData(void);
         // retrieves BAM alignment under file pointer
         // (does no overlap checking or character data parsing)
-        bool LoadNextAlignment(BamAlignment& alignment);
+        // N.B. - if isFiltered, alignments rejected by the current filter are skipped
+        //        (index builders must see every alignment, so this is off by default)
+        bool LoadNextAlignment(BamAlignment& alignment, const bool isFiltered = false);
+        // retrieves core data of next BAM alignment passing filter, skipping its variable-length data
+        // (does no overlap checking, reads name & decodes CIGAR ops only if requested)
+        bool LoadNextAlignmentCoreOnly(BamAlignment& alignment,
+                                       const bool decodeCigar,
+                                       const bool readName);
+        // points record view at BAM alignment under file pointer
+        // (does no overlap checking, variable-length data is not copied unless it straddles BGZF blocks)
+        bool LoadNextRecordView(BamRecordView& record);
         // builds reference data structure from BAM file
         bool LoadReferenceData(void);
         // seek reader to file position
@@ -89,6 +111,22 @@ class BamReaderPrivate {
         // return reader's file position
         int64_t Tell(void) const;
 
+    // internal methods
+    private:
+        // decodes alignment's packed CIGAR ops into CigarData
+        void DecodeCigarData(BamAlignment& alignment, const char* cigarData) const;
+        // returns true if alignment core fields pass current filter
+        bool IsFilterAccepted(const int32_t refID,
+                              const uint32_t alignmentFlag,
+                              const uint16_t mapQuality,
+                              const int32_t insertSize) const;
+        // retrieves block length & core data of BAM alignment under file pointer
+        bool LoadAlignmentCore(BamAlignment& alignment);
+        // retrieves block length & core data of next BAM alignment passing filter,
+        // skipping (not copying) the variable-length data of rejected alignments
+        // (returns false at end of data, or once alignments start after current region)
+        bool LoadFilteredAlignmentCore(BamAlignment& alignment);
+
     // data members
     public:
 
@@ -108,6 +146,17 @@ class BamReaderPrivate {
         BamRandomAccessController m_randomAccessController;
         BgzfStream m_stream;
 
+        // alignment used to fill alignment batches (keeps its capacities between batches)
+        BamAlignment m_batchAlignment;
+        // holds name/CIGAR data straddling BGZF blocks, for core-only reads
+        std::string m_spillBuffer;
+
+        // core-field filter
+        // N.B. - RefIDs are compiled into a lookup table, indexed by RefID+1
+        BamCoreFilter m_filter;
+        bool m_hasFilter;
+        std::vector<bool> m_isFilterRefIdAccepted;
+
         // error handling
         std::string m_errorString;
 };
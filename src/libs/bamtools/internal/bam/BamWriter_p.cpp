@@ -2,7 +2,7 @@
 // BamWriter_p.cpp (c) 2010 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 4 April 2012 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for producing BAM files
 // ***************************************************************************
@@ -199,6 +199,14 @@ bool BamWriterPrivate::SaveAlignment(const BamAlignment& al) {
     }
 }
 
+void BamWriterPrivate::SetNumThreads(int numThreads) {
+    try {
+        m_stream.SetNumThreads(numThreads);
+    } catch ( BamException& e ) {
+        m_errorString = e.what();
+    }
+}
+
 void BamWriterPrivate::SetWriteCompressed(bool ok) {
     // modifying compression is not allowed if BAM file is open
     if ( !IsOpen() )
@@ -395,6 +403,11 @@ void BamWriterPrivate::WriteAlignment(const BamAlignment& al) {
 
 void BamWriterPrivate::WriteCoreAlignment(const BamAlignment& al) {
 
+    // make sure raw char data is available (it is skipped by BamReader::GetNextAlignmentCoreOnly())
+    const unsigned int dataLength = al.SupportData.BlockLength - Constants::BAM_CORE_SIZE;
+    if ( al.SupportData.AllCharData.size() != dataLength )
+        throw BamException("BamWriter::SaveAlignment", "alignment character data is not available");
+
     // write the block size
     unsigned int blockSize = al.SupportData.BlockLength;
     if ( m_isBigEndian ) BamTools::SwapEndian_32(blockSize);
@@ -424,8 +437,7 @@ void BamWriterPrivate::WriteCoreAlignment(const BamAlignment& al) {
     m_stream.Write((char*)&buffer, Constants::BAM_CORE_SIZE);
 
     // write the raw char data
-    m_stream.Write((char*)al.SupportData.AllCharData.data(),
-                   al.SupportData.BlockLength-Constants::BAM_CORE_SIZE);
+    m_stream.Write((char*)al.SupportData.AllCharData.data(), dataLength);
 }
 
 void BamWriterPrivate::WriteMagicNumber(void) {
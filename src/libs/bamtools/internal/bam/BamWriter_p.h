@@ -2,7 +2,7 @@
 // BamWriter_p.h (c) 2010 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 25 October 2011 (DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Provides the basic functionality for producing BAM files
 // ***************************************************************************
@@ -47,6 +47,7 @@ class BamWriterPrivate {
                   const std::string& samHeaderText,
                   const BamTools::RefVector& referenceSequences);
         bool SaveAlignment(const BamAlignment& al);
+        void SetNumThreads(int numThreads);
         void SetWriteCompressed(bool ok);
 
     // 'internal' methods
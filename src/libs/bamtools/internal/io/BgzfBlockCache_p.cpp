@@ -0,0 +1,121 @@
+// ***************************************************************************
+// BgzfBlockCache_p.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides an LRU cache of decompressed BGZF blocks, keyed by block address
+// ***************************************************************************
+
+#include "BamConstants.h"
+#include "internal/io/BgzfBlockCache_p.h"
+using namespace BamTools;
+using namespace BamTools::Internal;
+
+#include <cstring>
+using namespace std;
+
+// ---------------------------------
+// BgzfBlockCache implementation
+// ---------------------------------
+
+BgzfBlockCache::BgzfBlockCache(void)
+    : m_maxEntries(0)
+    , m_numHits(0)
+    , m_numMisses(0)
+{ }
+
+BgzfBlockCache::~BgzfBlockCache(void) {
+    Clear();
+}
+
+void BgzfBlockCache::Clear(void) {
+    while ( !m_entries.empty() )
+        EvictOldest();
+}
+
+void BgzfBlockCache::EvictOldest(void) {
+    Entry& oldest = m_entries.back();
+    m_entriesByAddress.erase(oldest.BlockAddress);
+    delete[] oldest.Data;
+    m_entries.pop_back();
+}
+
+bool BgzfBlockCache::Get(const int64_t& blockAddress,
+                         char* uncompressedBlock,
+                         size_t* uncompressedLength,
+                         size_t* blockLength)
+{
+    EntryMap::iterator found = m_entriesByAddress.find(blockAddress);
+    if ( found == m_entriesByAddress.end() ) {
+        ++m_numMisses;
+        return false;
+    }
+    ++m_numHits;
+
+    // mark as most-recently used
+    EntryList::iterator entry = found->second;
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+
+    memcpy(uncompressedBlock, entry->Data, entry->UncompressedLength);
+    *uncompressedLength = entry->UncompressedLength;
+    *blockLength        = entry->BlockLength;
+    return true;
+}
+
+bool BgzfBlockCache::IsEnabled(void) const {
+    return ( m_maxEntries > 0 );
+}
+
+size_t BgzfBlockCache::MaxBytes(void) const {
+    return m_maxEntries * Constants::BGZF_DEFAULT_BLOCK_SIZE;
+}
+
+uint64_t BgzfBlockCache::NumHits(void) const {
+    return m_numHits;
+}
+
+uint64_t BgzfBlockCache::NumMisses(void) const {
+    return m_numMisses;
+}
+
+void BgzfBlockCache::Put(const int64_t& blockAddress,
+                         const char* uncompressedBlock,
+                         const size_t uncompressedLength,
+                         const size_t blockLength)
+{
+    // skip if disabled or already cached
+    if ( m_maxEntries == 0 || m_entriesByAddress.find(blockAddress) != m_entriesByAddress.end() )
+        return;
+
+    // re-use least-recently used entry's buffer, if full
+    char* data = 0;
+    if ( m_entries.size() == m_maxEntries ) {
+        Entry& oldest = m_entries.back();
+        m_entriesByAddress.erase(oldest.BlockAddress);
+        data = oldest.Data;
+        m_entries.pop_back();
+    } else
+        data = new char[Constants::BGZF_DEFAULT_BLOCK_SIZE];
+
+    memcpy(data, uncompressedBlock, uncompressedLength);
+
+    Entry entry;
+    entry.BlockAddress       = blockAddress;
+    entry.BlockLength        = blockLength;
+    entry.UncompressedLength = uncompressedLength;
+    entry.Data               = data;
+    m_entries.push_front(entry);
+    m_entriesByAddress[blockAddress] = m_entries.begin();
+}
+
+void BgzfBlockCache::ResetStatistics(void) {
+    m_numHits   = 0;
+    m_numMisses = 0;
+}
+
+void BgzfBlockCache::SetMaxBytes(const size_t maxBytes) {
+    m_maxEntries = maxBytes / Constants::BGZF_DEFAULT_BLOCK_SIZE;
+    while ( m_entries.size() > m_maxEntries )
+        EvictOldest();
+}
@@ -0,0 +1,91 @@
+// ***************************************************************************
+// BgzfBlockCache_p.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides an LRU cache of decompressed BGZF blocks, keyed by block address
+// ***************************************************************************
+
+#ifndef BGZFBLOCKCACHE_P_H
+#define BGZFBLOCKCACHE_P_H
+
+//  -------------
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the BamTools API.  It exists purely as an
+// implementation detail. This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+
+#include "api_global.h"
+#include <cstddef>
+#include <list>
+#include <map>
+
+namespace BamTools {
+namespace Internal {
+
+// N.B. - not thread-safe, only used from the reading thread
+class BgzfBlockCache {
+
+    // ctor & dtor
+    public:
+        BgzfBlockCache(void);
+        ~BgzfBlockCache(void);
+
+    // BgzfBlockCache interface
+    public:
+        // drops all cached blocks
+        void Clear(void);
+        // copies block data into uncompressedBlock & returns true, if block is cached
+        bool Get(const int64_t& blockAddress,
+                 char* uncompressedBlock,
+                 size_t* uncompressedLength,
+                 size_t* blockLength);
+        // returns true if cache is enabled
+        bool IsEnabled(void) const;
+        // returns memory limit (bytes)
+        size_t MaxBytes(void) const;
+        // returns number of Get() calls that found their block
+        uint64_t NumHits(void) const;
+        // returns number of Get() calls that did not find their block
+        uint64_t NumMisses(void) const;
+        // stores a copy of block data (evicting least-recently used block, if full)
+        void Put(const int64_t& blockAddress,
+                 const char* uncompressedBlock,
+                 const size_t uncompressedLength,
+                 const size_t blockLength);
+        // resets hit/miss counts
+        void ResetStatistics(void);
+        // sets memory limit (bytes, 0 disables cache)
+        void SetMaxBytes(const size_t maxBytes);
+
+    // internal methods
+    private:
+        void EvictOldest(void);
+
+    // data members
+    private:
+        struct Entry {
+            int64_t BlockAddress;
+            size_t BlockLength;         // compressed length (distance to next block)
+            size_t UncompressedLength;
+            char* Data;
+        };
+        typedef std::list<Entry> EntryList;                     // most-recently used first
+        typedef std::map<int64_t, EntryList::iterator> EntryMap;
+
+        EntryList m_entries;
+        EntryMap m_entriesByAddress;
+        size_t m_maxEntries;
+        uint64_t m_numHits;
+        uint64_t m_numMisses;
+};
+
+} // namespace Internal
+} // namespace BamTools
+
+#endif // BGZFBLOCKCACHE_P_H
@@ -0,0 +1,243 @@
+// ***************************************************************************
+// BgzfCodec_p.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides reusable deflate/inflate state & CRC32 for BGZF block payloads
+// (zlib by default, libdeflate if built with BAMTOOLS_HAVE_LIBDEFLATE)
+// ***************************************************************************
+
+#include "BamConstants.h"
+#include "internal/io/BgzfCodec_p.h"
+#include "internal/utils/BamException_p.h"
+using namespace BamTools;
+using namespace BamTools::Internal;
+
+#ifdef BAMTOOLS_HAVE_LIBDEFLATE
+#  include <libdeflate.h>
+#else
+#  include "zlib.h"
+#endif
+
+using namespace std;
+
+// N.B. - backend state is created on first Deflate()/Inflate()
+BgzfCodec::BgzfCodec(void)
+    : m_deflateState(0)
+    , m_inflateState(0)
+{ }
+
+// ---------------------------------------------------------------------------
+// libdeflate backend
+// (whole-block codec, with hardware-accelerated CRC32 where the CPU supports it)
+// ---------------------------------------------------------------------------
+
+#ifdef BAMTOOLS_HAVE_LIBDEFLATE
+
+struct BgzfCodec::DeflateState {
+    libdeflate_compressor* Compressor;
+    int CompressionLevel;
+};
+
+struct BgzfCodec::InflateState {
+    libdeflate_decompressor* Decompressor;
+};
+
+BgzfCodec::~BgzfCodec(void) {
+    if ( m_deflateState ) {
+        libdeflate_free_compressor(m_deflateState->Compressor);
+        delete m_deflateState;
+    }
+    if ( m_inflateState ) {
+        libdeflate_free_decompressor(m_inflateState->Decompressor);
+        delete m_inflateState;
+    }
+}
+
+uint32_t BgzfCodec::Crc32(const char* data, const size_t length) {
+    return libdeflate_crc32(0, data, length);
+}
+
+size_t BgzfCodec::Deflate(const char* input,
+                          const size_t inputLength,
+                          char* output,
+                          const size_t outputLength,
+                          const int compressionLevel)
+{
+    // libdeflate has no 'default' level, use zlib's
+    const int level = ( compressionLevel < 0 ? 6 : compressionLevel );
+
+    // (re-)create compressor as needed
+    if ( m_deflateState && m_deflateState->CompressionLevel != level ) {
+        libdeflate_free_compressor(m_deflateState->Compressor);
+        delete m_deflateState;
+        m_deflateState = 0;
+    }
+    if ( m_deflateState == 0 ) {
+        libdeflate_compressor* compressor = libdeflate_alloc_compressor(level);
+        if ( compressor == 0 )
+            throw BamException("BgzfCodec::Deflate", "libdeflate_alloc_compressor failed");
+        m_deflateState = new DeflateState;
+        m_deflateState->Compressor = compressor;
+        m_deflateState->CompressionLevel = level;
+    }
+
+    // N.B. - returns 0 if output buffer is too small
+    return libdeflate_deflate_compress(m_deflateState->Compressor,
+                                       input, inputLength,
+                                       output, outputLength);
+}
+
+size_t BgzfCodec::Inflate(const char* input,
+                          const size_t inputLength,
+                          char* output,
+                          const size_t outputLength)
+{
+    // create decompressor on first use
+    if ( m_inflateState == 0 ) {
+        libdeflate_decompressor* decompressor = libdeflate_alloc_decompressor();
+        if ( decompressor == 0 )
+            throw BamException("BgzfCodec::Inflate", "libdeflate_alloc_decompressor failed");
+        m_inflateState = new InflateState;
+        m_inflateState->Decompressor = decompressor;
+    }
+
+    size_t uncompressedLength = 0;
+    const libdeflate_result result = libdeflate_deflate_decompress(m_inflateState->Decompressor,
+                                                                   input, inputLength,
+                                                                   output, outputLength,
+                                                                   &uncompressedLength);
+    if ( result != LIBDEFLATE_SUCCESS )
+        throw BamException("BgzfCodec::Inflate", "libdeflate decompression failed");
+    return uncompressedLength;
+}
+
+const char* BgzfCodec::Name(void) {
+    return "libdeflate";
+}
+
+// ---------------------------------------------------------------------------
+// zlib backend (default)
+// (streams are initialized once, then reset for each block)
+// ---------------------------------------------------------------------------
+
+#else
+
+struct BgzfCodec::DeflateState {
+    z_stream Stream;
+    int CompressionLevel;
+};
+
+struct BgzfCodec::InflateState {
+    z_stream Stream;
+};
+
+BgzfCodec::~BgzfCodec(void) {
+    if ( m_deflateState ) {
+        deflateEnd(&m_deflateState->Stream);
+        delete m_deflateState;
+    }
+    if ( m_inflateState ) {
+        inflateEnd(&m_inflateState->Stream);
+        delete m_inflateState;
+    }
+}
+
+uint32_t BgzfCodec::Crc32(const char* data, const size_t length) {
+    const uLong crc = crc32(0, NULL, 0);
+    return crc32(crc, (const Bytef*)data, length);
+}
+
+size_t BgzfCodec::Deflate(const char* input,
+                          const size_t inputLength,
+                          char* output,
+                          const size_t outputLength,
+                          const int compressionLevel)
+{
+    // (re-)initialize stream as needed
+    if ( m_deflateState && m_deflateState->CompressionLevel != compressionLevel ) {
+        deflateEnd(&m_deflateState->Stream);
+        delete m_deflateState;
+        m_deflateState = 0;
+    }
+    if ( m_deflateState == 0 ) {
+        DeflateState* state = new DeflateState;
+        state->CompressionLevel = compressionLevel;
+        state->Stream.zalloc = NULL;
+        state->Stream.zfree  = NULL;
+        state->Stream.opaque = NULL;
+        const int status = deflateInit2(&state->Stream,
+                                        compressionLevel,
+                                        Z_DEFLATED,
+                                        Constants::GZIP_WINDOW_BITS,
+                                        Constants::Z_DEFAULT_MEM_LEVEL,
+                                        Z_DEFAULT_STRATEGY);
+        if ( status != Z_OK ) {
+            delete state;
+            throw BamException("BgzfCodec::Deflate", "zlib deflateInit2 failed");
+        }
+        m_deflateState = state;
+    }
+    z_stream& zs = m_deflateState->Stream;
+
+    // reset stream for new block
+    if ( deflateReset(&zs) != Z_OK )
+        throw BamException("BgzfCodec::Deflate", "zlib deflateReset failed");
+    zs.next_in   = (Bytef*)input;
+    zs.avail_in  = inputLength;
+    zs.next_out  = (Bytef*)output;
+    zs.avail_out = outputLength;
+
+    // compress the data
+    const int status = deflate(&zs, Z_FINISH);
+    if ( status == Z_STREAM_END )
+        return zs.total_out;
+
+    // there was not enough space available in output
+    if ( status == Z_OK || status == Z_BUF_ERROR )
+        return 0;
+
+    throw BamException("BgzfCodec::Deflate", "zlib deflate failed");
+}
+
+size_t BgzfCodec::Inflate(const char* input,
+                          const size_t inputLength,
+                          char* output,
+                          const size_t outputLength)
+{
+    // initialize stream on first use
+    if ( m_inflateState == 0 ) {
+        InflateState* state = new InflateState;
+        state->Stream.zalloc   = NULL;
+        state->Stream.zfree    = NULL;
+        state->Stream.opaque   = NULL;
+        state->Stream.next_in  = NULL;
+        state->Stream.avail_in = 0;
+        if ( inflateInit2(&state->Stream, Constants::GZIP_WINDOW_BITS) != Z_OK ) {
+            delete state;
+            throw BamException("BgzfCodec::Inflate", "zlib inflateInit failed");
+        }
+        m_inflateState = state;
+    }
+    z_stream& zs = m_inflateState->Stream;
+
+    // reset stream for new block
+    if ( inflateReset(&zs) != Z_OK )
+        throw BamException("BgzfCodec::Inflate", "zlib inflateReset failed");
+    zs.next_in   = (Bytef*)input;
+    zs.avail_in  = inputLength;
+    zs.next_out  = (Bytef*)output;
+    zs.avail_out = outputLength;
+
+    // decompress
+    if ( inflate(&zs, Z_FINISH) != Z_STREAM_END )
+        throw BamException("BgzfCodec::Inflate", "zlib inflate failed");
+    return zs.total_out;
+}
+
+const char* BgzfCodec::Name(void) {
+    return "zlib";
+}
+
+#endif // BAMTOOLS_HAVE_LIBDEFLATE
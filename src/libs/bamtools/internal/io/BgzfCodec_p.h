@@ -0,0 +1,76 @@
+// ***************************************************************************
+// BgzfCodec_p.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides reusable deflate/inflate state & CRC32 for BGZF block payloads
+// (zlib by default, libdeflate if built with BAMTOOLS_HAVE_LIBDEFLATE)
+// ***************************************************************************
+
+#ifndef BGZFCODEC_P_H
+#define BGZFCODEC_P_H
+
+//  -------------
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the BamTools API.  It exists purely as an
+// implementation detail. This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+
+#include "api_global.h"
+#include <cstddef>
+
+namespace BamTools {
+namespace Internal {
+
+// N.B. - not thread-safe, each thread (or queued task) keeps its own codec
+class BgzfCodec {
+
+    // ctor & dtor
+    public:
+        BgzfCodec(void);
+        ~BgzfCodec(void);
+
+    // BgzfCodec interface
+    public:
+        // compresses raw deflate data, returns compressed length (0 if it did not fit in output)
+        size_t Deflate(const char* input,
+                       const size_t inputLength,
+                       char* output,
+                       const size_t outputLength,
+                       const int compressionLevel);
+        // decompresses raw deflate data, returns uncompressed length
+        size_t Inflate(const char* input,
+                       const size_t inputLength,
+                       char* output,
+                       const size_t outputLength);
+
+    // static 'utility' methods
+    public:
+        // returns CRC32 checksum of data
+        static uint32_t Crc32(const char* data, const size_t length);
+        // returns name of backend library ("zlib" or "libdeflate")
+        static const char* Name(void);
+
+    // not copyable
+    private:
+        BgzfCodec(const BgzfCodec& other);
+        BgzfCodec& operator=(const BgzfCodec& other);
+
+    // data members
+    private:
+        // backend-specific stream state, created on first use (defined in BgzfCodec_p.cpp)
+        struct DeflateState;
+        struct InflateState;
+        DeflateState* m_deflateState;
+        InflateState* m_inflateState;
+};
+
+} // namespace Internal
+} // namespace BamTools
+
+#endif // BGZFCODEC_P_H
@@ -2,7 +2,7 @@
 // BgzfStream_p.cpp (c) 2011 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 17 January 2012(DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Based on BGZF routines developed at the Broad Institute.
 // Provides the basic functionality for reading & writing BGZF files
@@ -14,6 +14,7 @@
 #include "internal/io/BamDeviceFactory_p.h"
 #include "internal/io/BgzfStream_p.h"
 #include "internal/utils/BamException_p.h"
+#include "internal/utils/BamThreadPool_p.h"
 using namespace BamTools;
 using namespace BamTools::Internal;
 
@@ -25,6 +26,352 @@ using namespace BamTools::Internal;
 #include <sstream>
 using namespace std;
 
+namespace BamTools {
+namespace Internal {
+
+// blocks read ahead (or queued for writing), per (de)compression thread
+static const size_t READ_AHEAD_BLOCKS_PER_THREAD = 4;
+
+// --------------------------------
+// BgzfInflateTask implementation
+// --------------------------------
+
+// one read-ahead block: read from device on the reading thread, inflated on a worker
+class BgzfInflateTask : public BamThreadTask {
+
+    // ctor & dtor
+    public:
+        BgzfInflateTask(void)
+            : BlockAddress(0)
+            , BlockLength(0)
+            , UncompressedLength(0)
+            , Error(0)
+            , CompressedBlock(Constants::BGZF_MAX_BLOCK_SIZE)
+            , UncompressedBlock(Constants::BGZF_DEFAULT_BLOCK_SIZE)
+        { }
+        ~BgzfInflateTask(void) {
+            ClearError();
+        }
+
+    // BgzfInflateTask interface
+    public:
+        void ClearError(void) {
+            delete Error;
+            Error = 0;
+        }
+        void SetError(const BamException& e) {
+            ClearError();
+            Error = new BamException(e);
+        }
+
+    // BamThreadTask interface
+    public:
+        void Run(void) {
+            try {
+                UncompressedLength = BgzfStream::InflateBlock(CompressedBlock.Buffer,
+                                                              BlockLength,
+                                                              UncompressedBlock.Buffer,
+                                                              Codec);
+            } catch ( BamException& e ) {
+                SetError(e);
+            }
+        }
+
+    // data members
+    public:
+        int64_t BlockAddress;
+        size_t BlockLength;
+        size_t UncompressedLength;
+        BamException* Error;  // set if block could not be read or inflated, re-thrown when reached
+        RaiiBuffer CompressedBlock;
+        RaiiBuffer UncompressedBlock;
+        BgzfCodec Codec;      // N.B. - kept with the task, so inflate state is reused across blocks
+};
+
+// --------------------------------
+// BgzfDeflateTask implementation
+// --------------------------------
+
+// one filled block: compressed on a worker, written by the background writer
+class BgzfDeflateTask : public BamThreadTask {
+
+    // ctor & dtor
+    public:
+        BgzfDeflateTask(void)
+            : UncompressedLength(0)
+            , CompressionLevel(0)
+            , CompressedLength(0)
+            , Error(0)
+            , UncompressedBlock(Constants::BGZF_DEFAULT_BLOCK_SIZE)
+            , CompressedBlock(2 * Constants::BGZF_MAX_BLOCK_SIZE)
+        { }
+        ~BgzfDeflateTask(void) {
+            ClearError();
+        }
+
+    // BgzfDeflateTask interface
+    public:
+        void ClearError(void) {
+            delete Error;
+            Error = 0;
+        }
+        void SetError(const BamException& e) {
+            ClearError();
+            Error = new BamException(e);
+        }
+
+    // BamThreadTask interface
+    public:
+        void Run(void) {
+            try {
+                // N.B. - data that does not compress enough is carried over into a 2nd block,
+                //        rather than into the next block (as in single-threaded writing)
+                CompressedLength = 0;
+                int32_t inputOffset = 0;
+                int numBlocks = 0;
+                do {
+                    if ( numBlocks == 2 )
+                        throw BamException("BgzfStream::DeflateBlock", "after deflate, remainder too large");
+                    int32_t inputLength = UncompressedLength - inputOffset;
+                    CompressedLength += BgzfStream::DeflateBlock(UncompressedBlock.Buffer + inputOffset,
+                                                                 inputLength,
+                                                                 CompressedBlock.Buffer + CompressedLength,
+                                                                 CompressionLevel,
+                                                                 Codec);
+                    inputOffset += inputLength;
+                    ++numBlocks;
+                } while ( inputOffset < UncompressedLength );
+            } catch ( BamException& e ) {
+                SetError(e);
+            }
+        }
+
+    // data members
+    public:
+        int32_t UncompressedLength;
+        int CompressionLevel;
+        size_t CompressedLength;
+        BamException* Error;  // set if block could not be compressed, re-thrown by writer
+        RaiiBuffer UncompressedBlock;
+        RaiiBuffer CompressedBlock;
+        BgzfCodec Codec;      // N.B. - kept with the task, so deflate state is reused across blocks
+};
+
+// --------------------------------
+// BgzfBlockWriter implementation
+// --------------------------------
+
+// compresses blocks on a worker pool, & writes them (in order) from a background thread
+class BgzfBlockWriter {
+
+    // ctor & dtor
+    public:
+        BgzfBlockWriter(IBamIODevice* device, const int64_t& blockAddress, const int numThreads);
+        ~BgzfBlockWriter(void); // N.B. - any pending error is dropped, call Finish() first
+
+    // BgzfBlockWriter interface
+    public:
+        // waits for all queued blocks to be written, returns address of next block
+        int64_t BlockAddress(void);
+        // waits for all queued blocks to be written, throws on any write error
+        int64_t Finish(void);
+        // queues block for compression (block gets a free buffer in exchange), throws on any prior error
+        void Submit(RaiiBuffer& block, const int32_t blockLength, const int compressionLevel);
+
+    // internal methods
+    private:
+        static void* RunWriter(void* writer);
+        void WaitForQueue(void);
+        void Work(void);
+        void WriteNextBlock(void);
+
+    // data members
+    private:
+        IBamIODevice* m_device;
+        int64_t m_blockAddress;
+        BamThreadPool m_threadPool;
+
+        std::vector<BgzfDeflateTask*> m_queue;  // ring buffer, in file order
+        size_t m_queueBegin;
+        size_t m_queueCount;
+        BamException* m_error;
+
+        pthread_t m_writerThread;
+        bool m_hasWriterThread;                 // if false, Submit() writes blocks itself
+        bool m_isStopping;
+        pthread_mutex_t m_mutex;
+        pthread_cond_t m_blockQueued;
+        pthread_cond_t m_blockWritten;
+};
+
+BgzfBlockWriter::BgzfBlockWriter(IBamIODevice* device, const int64_t& blockAddress, const int numThreads)
+    : m_device(device)
+    , m_blockAddress(blockAddress)
+    , m_threadPool(numThreads)
+    , m_queueBegin(0)
+    , m_queueCount(0)
+    , m_error(0)
+    , m_hasWriterThread(false)
+    , m_isStopping(false)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_blockQueued, NULL);
+    pthread_cond_init(&m_blockWritten, NULL);
+
+    m_queue.resize( max(m_threadPool.NumThreads(), 1) * READ_AHEAD_BLOCKS_PER_THREAD );
+    for ( size_t i = 0; i < m_queue.size(); ++i )
+        m_queue[i] = new BgzfDeflateTask;
+
+    m_hasWriterThread = ( pthread_create(&m_writerThread, NULL, BgzfBlockWriter::RunWriter, this) == 0 );
+}
+
+BgzfBlockWriter::~BgzfBlockWriter(void) {
+
+    // let writer drain the queue, then exit
+    if ( m_hasWriterThread ) {
+        pthread_mutex_lock(&m_mutex);
+        m_isStopping = true;
+        pthread_cond_broadcast(&m_blockQueued);
+        pthread_mutex_unlock(&m_mutex);
+        pthread_join(m_writerThread, NULL);
+    }
+
+    for ( size_t i = 0; i < m_queue.size(); ++i )
+        delete m_queue[i];
+    delete m_error;
+
+    pthread_cond_destroy(&m_blockWritten);
+    pthread_cond_destroy(&m_blockQueued);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+int64_t BgzfBlockWriter::BlockAddress(void) {
+    WaitForQueue();
+    pthread_mutex_lock(&m_mutex);
+    const int64_t blockAddress = m_blockAddress;
+    pthread_mutex_unlock(&m_mutex);
+    return blockAddress;
+}
+
+int64_t BgzfBlockWriter::Finish(void) {
+    WaitForQueue();
+    if ( m_error )
+        throw BamException(*m_error);
+    return m_blockAddress;
+}
+
+void* BgzfBlockWriter::RunWriter(void* writer) {
+    static_cast<BgzfBlockWriter*>(writer)->Work();
+    return NULL;
+}
+
+void BgzfBlockWriter::Submit(RaiiBuffer& block, const int32_t blockLength, const int compressionLevel) {
+
+    // wait for free slot
+    pthread_mutex_lock(&m_mutex);
+    while ( m_queueCount == m_queue.size() )
+        pthread_cond_wait(&m_blockWritten, &m_mutex);
+    if ( m_error ) {
+        const BamException e(*m_error);
+        pthread_mutex_unlock(&m_mutex);
+        throw e;
+    }
+    BgzfDeflateTask* task = m_queue.at((m_queueBegin + m_queueCount) % m_queue.size());
+    pthread_mutex_unlock(&m_mutex);
+
+    // swap in block data (caller gets the slot's old buffer, for re-use)
+    std::swap(block.Buffer, task->UncompressedBlock.Buffer);
+    task->UncompressedLength = blockLength;
+    task->CompressionLevel   = compressionLevel;
+    task->ClearError();
+
+    // N.B. - task must be submitted before the writer can see it
+    m_threadPool.Submit(task);
+    pthread_mutex_lock(&m_mutex);
+    ++m_queueCount;
+    pthread_cond_signal(&m_blockQueued);
+    pthread_mutex_unlock(&m_mutex);
+
+    if ( !m_hasWriterThread )
+        WriteNextBlock();
+}
+
+void BgzfBlockWriter::WaitForQueue(void) {
+    pthread_mutex_lock(&m_mutex);
+    while ( m_queueCount > 0 )
+        pthread_cond_wait(&m_blockWritten, &m_mutex);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void BgzfBlockWriter::Work(void) {
+
+    pthread_mutex_lock(&m_mutex);
+    while ( true ) {
+
+        // wait for block (or shutdown, once queue is empty)
+        while ( m_queueCount == 0 && !m_isStopping )
+            pthread_cond_wait(&m_blockQueued, &m_mutex);
+        if ( m_queueCount == 0 )
+            break;
+
+        pthread_mutex_unlock(&m_mutex);
+        WriteNextBlock();
+        pthread_mutex_lock(&m_mutex);
+    }
+    pthread_mutex_unlock(&m_mutex);
+}
+
+// writes the block at front of queue, once compressed
+// N.B. - once an error has occurred, remaining blocks are dropped
+void BgzfBlockWriter::WriteNextBlock(void) {
+
+    pthread_mutex_lock(&m_mutex);
+    BgzfDeflateTask* task = m_queue.at(m_queueBegin);
+    const bool hasError = ( m_error != 0 );
+    pthread_mutex_unlock(&m_mutex);
+
+    // wait for compression
+    m_threadPool.Wait(task);
+
+    // write compressed data to device
+    BamException* error = 0;
+    size_t numBytesWritten = 0;
+    if ( task->Error && !hasError )
+        error = new BamException(*task->Error);
+    else if ( !hasError ) {
+        const int64_t result = m_device->Write(task->CompressedBlock.Buffer, task->CompressedLength);
+
+        // check for device error
+        if ( result < 0 ) {
+            const string message = string("device error: ") + m_device->GetErrorString();
+            error = new BamException("BgzfStream::FlushBlock", message);
+        }
+
+        // check that we wrote expected numBytes
+        else if ( result != static_cast<int64_t>(task->CompressedLength) ) {
+            stringstream s("");
+            s << "expected to write " << task->CompressedLength
+              << " bytes during flushing, but wrote " << result;
+            error = new BamException("BgzfStream::FlushBlock", s.str());
+        }
+
+        else numBytesWritten = task->CompressedLength;
+    }
+
+    // update queue
+    pthread_mutex_lock(&m_mutex);
+    if ( error )
+        m_error = error;
+    m_blockAddress += numBytesWritten;
+    m_queueBegin = (m_queueBegin + 1) % m_queue.size();
+    --m_queueCount;
+    pthread_cond_broadcast(&m_blockWritten);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+} // namespace Internal
+} // namespace BamTools
+
 // ---------------------------
 // BgzfStream implementation
 // ---------------------------
@@ -34,10 +381,17 @@ BgzfStream::BgzfStream(void)
   : m_blockLength(0)
   , m_blockOffset(0)
   , m_blockAddress(0)
+  , m_nextBlockAddress(0)
   , m_isWriteCompressed(true)
   , m_device(0)
   , m_uncompressedBlock(Constants::BGZF_DEFAULT_BLOCK_SIZE)
   , m_compressedBlock(Constants::BGZF_MAX_BLOCK_SIZE)
+  , m_numThreads(1)
+  , m_threadPool(0)
+  , m_readAheadBegin(0)
+  , m_readAheadCount(0)
+  , m_isReadAheadAtEnd(false)
+  , m_blockWriter(0)
 { }
 
 // destructor
@@ -57,16 +411,49 @@ bool BgzfStream::CheckBlockHeader(char* header) {
             BamTools::UnpackUnsignedShort(&header[14]) == Constants::BGZF_LEN );
 }
 
+// discards any blocks read ahead (waits for pending decompression)
+void BgzfStream::ClearReadAhead(void) {
+
+    if ( m_threadPool ) {
+        for ( size_t i = 0; i < m_readAheadCount; ++i )
+            m_threadPool->Wait( m_readAhead.at((m_readAheadBegin + i) % m_readAhead.size()) );
+    }
+
+    m_readAheadBegin   = 0;
+    m_readAheadCount   = 0;
+    m_isReadAheadAtEnd = false;
+}
+
 // closes BGZF file
 void BgzfStream::Close(void) {
 
     // skip if no device open
     if ( m_device == 0 ) return;
 
+    // shut down read-ahead
+    ClearReadAhead();
+    delete m_threadPool;
+    m_threadPool = 0;
+    for ( size_t i = 0; i < m_readAhead.size(); ++i )
+        delete m_readAhead[i];
+    m_readAhead.clear();
+
     // if writing to file, flush the current BGZF block,
     // then write an empty block (as EOF marker)
     if ( m_device->IsOpen() && (m_device->Mode() == IBamIODevice::WriteOnly) ) {
-        FlushBlock();
+
+        // N.B. - background writer must be done before EOF marker is written. If flushing fails,
+        //        unwritten data is dropped (so that a repeated Close() only writes the EOF marker)
+        try {
+            FlushBlock();
+            FinishBlockWriter();
+        } catch ( BamException& ) {
+            delete m_blockWriter;
+            m_blockWriter = 0;
+            m_blockOffset = 0;
+            throw;
+        }
+
         const size_t blockLength = DeflateBlock(0);
         m_device->Write(m_compressedBlock.Buffer, blockLength);
     }
@@ -79,19 +466,55 @@ void BgzfStream::Close(void) {
     // ensure our buffers are cleared out
     m_uncompressedBlock.Clear();
     m_compressedBlock.Clear();
+    m_blockCache.Clear();
 
     // reset state
     m_blockLength = 0;
     m_blockOffset = 0;
     m_blockAddress = 0;
+    m_nextBlockAddress = 0;
     m_isWriteCompressed = true;
 }
 
 // compresses the current block
 size_t BgzfStream::DeflateBlock(int32_t blockLength) {
 
+    // set compression level
+    const int compressionLevel = ( m_isWriteCompressed ? Z_DEFAULT_COMPRESSION : 0 );
+
+    // compress as much of the block as will fit
+    int32_t inputLength = blockLength;
+    const size_t compressedLength = DeflateBlock(m_uncompressedBlock.Buffer,
+                                                 inputLength,
+                                                 m_compressedBlock.Buffer,
+                                                 compressionLevel,
+                                                 m_codec);
+
+    // ensure that we have less than a block of data left
+    int remaining = blockLength - inputLength;
+    if ( remaining > 0 ) {
+        if ( remaining > inputLength )
+            throw BamException("BgzfStream::DeflateBlock", "after deflate, remainder too large");
+        memcpy(m_uncompressedBlock.Buffer, m_uncompressedBlock.Buffer + inputLength, remaining);
+    }
+
+    // update block data
+    m_blockOffset = remaining;
+
+    // return result
+    return compressedLength;
+}
+
+// compresses a single block (on return, inputLength holds number of input bytes consumed)
+// N.B. - uses no stream state (only the given codec), so may be called from compression worker threads
+size_t BgzfStream::DeflateBlock(const char* uncompressedBlock,
+                                int32_t& inputLength,
+                                char* compressedBlock,
+                                const int compressionLevel,
+                                BgzfCodec& codec)
+{
     // initialize the gzip header
-    char* buffer = m_compressedBlock.Buffer;
+    char* buffer = compressedBlock;
     memset(buffer, 0, 18);
     buffer[0]  = Constants::GZIP_ID1;
     buffer[1]  = Constants::GZIP_ID2;
@@ -103,64 +526,32 @@ size_t BgzfStream::DeflateBlock(int32_t blockLength) {
     buffer[13] = Constants::BGZF_ID2;
     buffer[14] = Constants::BGZF_LEN;
 
-    // set compression level
-    const int compressionLevel = ( m_isWriteCompressed ? Z_DEFAULT_COMPRESSION : 0 );
-
     // loop to retry for blocks that do not compress enough
-    int inputLength = blockLength;
     size_t compressedLength = 0;
-    const unsigned int bufferSize = Constants::BGZF_MAX_BLOCK_SIZE;
+    const size_t bufferSize = Constants::BGZF_MAX_BLOCK_SIZE -
+                              Constants::BGZF_BLOCK_HEADER_LENGTH -
+                              Constants::BGZF_BLOCK_FOOTER_LENGTH;
 
     while ( true ) {
 
-        // initialize zstream values
-        z_stream zs;
-        zs.zalloc    = NULL;
-        zs.zfree     = NULL;
-        zs.next_in   = (Bytef*)m_uncompressedBlock.Buffer;
-        zs.avail_in  = inputLength;
-        zs.next_out  = (Bytef*)&buffer[Constants::BGZF_BLOCK_HEADER_LENGTH];
-        zs.avail_out = bufferSize -
-                       Constants::BGZF_BLOCK_HEADER_LENGTH -
-                       Constants::BGZF_BLOCK_FOOTER_LENGTH;
-
-        // initialize the zlib compression algorithm
-        int status = deflateInit2(&zs,
-                                  compressionLevel,
-                                  Z_DEFLATED,
-                                  Constants::GZIP_WINDOW_BITS,
-                                  Constants::Z_DEFAULT_MEM_LEVEL,
-                                  Z_DEFAULT_STRATEGY);
-        if ( status != Z_OK )
-            throw BamException("BgzfStream::DeflateBlock", "zlib deflateInit2 failed");
-
         // compress the data
-        status = deflate(&zs, Z_FINISH);
-
-        // if not at stream end
-        if ( status != Z_STREAM_END ) {
-
-            deflateEnd(&zs);
-
-            // there was not enough space available in buffer
-            // try to reduce the input length & re-start loop
-            if ( status == Z_OK ) {
-                inputLength -= 1024;
-                if ( inputLength < 0 )
-                    throw BamException("BgzfStream::DeflateBlock", "input reduction failed");
-                continue;
-            }
-
-            throw BamException("BgzfStream::DeflateBlock", "zlib deflate failed");
+        const size_t deflatedLength = codec.Deflate(uncompressedBlock,
+                                                    inputLength,
+                                                    &buffer[Constants::BGZF_BLOCK_HEADER_LENGTH],
+                                                    bufferSize,
+                                                    compressionLevel);
+
+        // there was not enough space available in buffer
+        // try to reduce the input length & re-start loop
+        if ( deflatedLength == 0 ) {
+            inputLength -= 1024;
+            if ( inputLength < 0 )
+                throw BamException("BgzfStream::DeflateBlock", "input reduction failed");
+            continue;
         }
 
-        // finalize the compression routine
-        status = deflateEnd(&zs);
-        if ( status != Z_OK )
-            throw BamException("BgzfStream::DeflateBlock", "zlib deflateEnd failed");
-
         // update compressedLength
-        compressedLength = zs.total_out +
+        compressedLength = deflatedLength +
                            Constants::BGZF_BLOCK_HEADER_LENGTH +
                            Constants::BGZF_BLOCK_FOOTER_LENGTH;
         if ( compressedLength > Constants::BGZF_MAX_BLOCK_SIZE )
@@ -174,24 +565,84 @@ size_t BgzfStream::DeflateBlock(int32_t blockLength) {
     BamTools::PackUnsignedShort(&buffer[16], static_cast<uint16_t>(compressedLength - 1));
 
     // store the CRC32 checksum
-    uint32_t crc = crc32(0, NULL, 0);
-    crc = crc32(crc, (Bytef*)m_uncompressedBlock.Buffer, inputLength);
+    const uint32_t crc = BgzfCodec::Crc32(uncompressedBlock, inputLength);
     BamTools::PackUnsignedInt(&buffer[compressedLength - 8], crc);
     BamTools::PackUnsignedInt(&buffer[compressedLength - 4], inputLength);
 
-    // ensure that we have less than a block of data left
-    int remaining = blockLength - inputLength;
-    if ( remaining > 0 ) {
-        if ( remaining > inputLength )
-            throw BamException("BgzfStream::DeflateBlock", "after deflate, remainder too large");
-        memcpy(m_uncompressedBlock.Buffer, m_uncompressedBlock.Buffer + inputLength, remaining);
+    // return result
+    return compressedLength;
+}
+
+// waits for background writer to write all queued blocks, then shuts it down
+void BgzfStream::FinishBlockWriter(void) {
+
+    if ( m_blockWriter == 0 )
+        return;
+
+    BgzfBlockWriter* blockWriter = m_blockWriter;
+    m_blockWriter = 0;
+    try {
+        m_blockAddress = blockWriter->Finish();
+    } catch ( BamException& ) {
+        delete blockWriter;
+        throw;
     }
+    delete blockWriter;
+}
 
-    // update block data
-    m_blockOffset = remaining;
+// reads & queues compressed blocks for decompression, until read-ahead window is full
+void BgzfStream::FillReadAhead(void) {
+
+    // start workers & allocate window on first use (or once emptied, after thread count changed)
+    if ( m_threadPool == 0 )
+        m_threadPool = new BamThreadPool(m_numThreads);
+    const size_t windowSize = READ_AHEAD_BLOCKS_PER_THREAD * m_numThreads;
+    if ( m_readAheadCount == 0 && m_readAhead.size() != windowSize ) {
+        for ( size_t i = 0; i < m_readAhead.size(); ++i )
+            delete m_readAhead[i];
+        m_readAhead.clear();
+        for ( size_t i = 0; i < windowSize; ++i )
+            m_readAhead.push_back( new BgzfInflateTask );
+        m_readAheadBegin = 0;
+    }
 
-    // return result
-    return compressedLength;
+    while ( !m_isReadAheadAtEnd && m_readAheadCount < m_readAhead.size() ) {
+
+        BgzfInflateTask* task = m_readAhead.at((m_readAheadBegin + m_readAheadCount) % m_readAhead.size());
+        task->BlockAddress = m_device->Tell();
+        task->ClearError();
+
+        // read errors are deferred until the reader gets to this block,
+        // so all data before it is still delivered
+        try {
+
+            // take block from cache, if available (task is left as done, not submitted)
+            if ( ReadCachedBlock(task->BlockAddress,
+                                 task->UncompressedBlock.Buffer,
+                                 &task->UncompressedLength,
+                                 &task->BlockLength) )
+            {
+                ++m_readAheadCount;
+                continue;
+            }
+
+            task->BlockLength = ReadCompressedBlock(task->CompressedBlock.Buffer);
+        } catch ( BamException& e ) {
+            task->SetError(e);
+            m_isReadAheadAtEnd = true;
+            ++m_readAheadCount;
+            break;
+        }
+
+        // stop at EOF
+        if ( task->BlockLength == 0 ) {
+            m_isReadAheadAtEnd = true;
+            break;
+        }
+
+        m_threadPool->Submit(task);
+        ++m_readAheadCount;
+    }
 }
 
 // flushes the data in the BGZF block
@@ -199,6 +650,18 @@ void BgzfStream::FlushBlock(void) {
 
     BT_ASSERT_X( m_device, "BgzfStream::FlushBlock() - attempting to flush to null device" );
 
+    // if multi-threaded, hand off block for background compression & writing
+    if ( m_numThreads > 1 ) {
+        if ( m_blockOffset == 0 )
+            return;
+        if ( m_blockWriter == 0 )
+            m_blockWriter = new BgzfBlockWriter(m_device, m_blockAddress, m_numThreads);
+        const int compressionLevel = ( m_isWriteCompressed ? Z_DEFAULT_COMPRESSION : 0 );
+        m_blockWriter->Submit(m_uncompressedBlock, m_blockOffset, compressionLevel);
+        m_blockOffset = 0;
+        return;
+    }
+
     // flush all of the remaining blocks
     while ( m_blockOffset > 0 ) {
 
@@ -227,39 +690,29 @@ void BgzfStream::FlushBlock(void) {
     }
 }
 
-// decompresses the current block
-size_t BgzfStream::InflateBlock(const size_t& blockLength) {
-
-    // setup zlib stream object
-    z_stream zs;
-    zs.zalloc    = NULL;
-    zs.zfree     = NULL;
-    zs.next_in   = (Bytef*)m_compressedBlock.Buffer + 18;
-    zs.avail_in  = blockLength - 16;
-    zs.next_out  = (Bytef*)m_uncompressedBlock.Buffer;
-    zs.avail_out = Constants::BGZF_DEFAULT_BLOCK_SIZE;
-
-    // initialize
-    int status = inflateInit2(&zs, Constants::GZIP_WINDOW_BITS);
-    if ( status != Z_OK )
-        throw BamException("BgzfStream::InflateBlock", "zlib inflateInit failed");
-
-    // decompress
-    status = inflate(&zs, Z_FINISH);
-    if ( status != Z_STREAM_END ) {
-        inflateEnd(&zs);
-        throw BamException("BgzfStream::InflateBlock", "zlib inflate failed");
-    }
+// decompresses a block
+// N.B. - uses no stream state (only the given codec), so may be called from read-ahead worker threads
+size_t BgzfStream::InflateBlock(const char* compressedBlock,
+                                const size_t& blockLength,
+                                char* uncompressedBlock,
+                                BgzfCodec& codec)
+{
+    // decompress data between block header & footer
+    return codec.Inflate(compressedBlock + Constants::BGZF_BLOCK_HEADER_LENGTH,
+                         blockLength - Constants::BGZF_BLOCK_HEADER_LENGTH - Constants::BGZF_BLOCK_FOOTER_LENGTH,
+                         uncompressedBlock,
+                         Constants::BGZF_DEFAULT_BLOCK_SIZE);
+}
 
-    // finalize
-    status = inflateEnd(&zs);
-    if ( status != Z_OK ) {
-        inflateEnd(&zs);
-        throw BamException("BgzfStream::InflateBlock", "zlib inflateEnd failed");
-    }
+// returns decompressed-block cache (for its hit/miss counts)
+const BgzfBlockCache& BgzfStream::BlockCache(void) const {
+    return m_blockCache;
+}
 
-    // return result
-    return zs.total_out;
+// returns true if blocks read are looked up in (& added to) block cache
+// N.B. - cache is only used on random-access devices, as only a Seek() can revisit a block
+bool BgzfStream::IsBlockCacheUsed(void) const {
+    return ( m_blockCache.IsEnabled() && m_device->IsRandomAccess() );
 }
 
 bool BgzfStream::IsOpen(void) const {
@@ -273,6 +726,7 @@ void BgzfStream::Open(const string& filename, const IBamIODevice::OpenMode mode)
     // close current device if necessary
     Close();
     BT_ASSERT_X( (m_device == 0), "BgzfStream::Open() - unable to properly close previous IO device" );
+    m_blockCache.ResetStatistics();
 
     // retrieve new IO device depending on filename
     m_device = BamDeviceFactory::CreateDevice(filename);
@@ -325,7 +779,7 @@ size_t BgzfStream::Read(char* data, const size_t dataLength) {
 
     // update block data
     if ( m_blockOffset == m_blockLength ) {
-        m_blockAddress = m_device->Tell();
+        m_blockAddress = m_nextBlockAddress;
         m_blockOffset  = 0;
         m_blockLength  = 0;
     }
@@ -339,9 +793,68 @@ void BgzfStream::ReadBlock(void) {
 
     BT_ASSERT_X( m_device, "BgzfStream::ReadBlock() - trying to read from null IO device");
 
+    // multi-threaded: take from read-ahead window
+    // (also drains any blocks left over after switching back to a single thread)
+    if ( m_numThreads > 1 || m_readAheadCount > 0 ) {
+        ReadQueuedBlock();
+        return;
+    }
+
     // store block's starting address
     const int64_t blockAddress = m_device->Tell();
 
+    // take block from cache, if available
+    size_t blockLength = 0;
+    size_t newBlockLength = 0;
+    if ( !ReadCachedBlock(blockAddress, m_uncompressedBlock.Buffer, &newBlockLength, &blockLength) ) {
+
+        // read compressed block
+        blockLength = ReadCompressedBlock(m_compressedBlock.Buffer);
+        if ( blockLength == 0 ) {
+            m_blockLength = 0;
+            return;
+        }
+
+        // decompress block data
+        newBlockLength = InflateBlock(m_compressedBlock.Buffer,
+                                      blockLength,
+                                      m_uncompressedBlock.Buffer,
+                                      m_codec);
+
+        if ( IsBlockCacheUsed() )
+            m_blockCache.Put(blockAddress, m_uncompressedBlock.Buffer, newBlockLength, blockLength);
+    }
+
+    // update block data
+    if ( m_blockLength != 0 )
+        m_blockOffset = 0;
+    m_blockAddress     = blockAddress;
+    m_blockLength      = newBlockLength;
+    m_nextBlockAddress = blockAddress + blockLength;
+}
+
+// takes block from cache if available, repositioning device past it (returns false if not cached)
+bool BgzfStream::ReadCachedBlock(const int64_t& blockAddress,
+                                 char* uncompressedBlock,
+                                 size_t* uncompressedLength,
+                                 size_t* blockLength)
+{
+    if ( !IsBlockCacheUsed() )
+        return false;
+    if ( !m_blockCache.Get(blockAddress, uncompressedBlock, uncompressedLength, blockLength) )
+        return false;
+
+    if ( !m_device->Seek(blockAddress + *blockLength) ) {
+        stringstream s("");
+        s << "unable to seek past cached block at: " << blockAddress;
+        throw BamException("BgzfStream::ReadBlock", s.str());
+    }
+    return true;
+}
+
+// reads the next compressed block from device (returns its length, 0 if EOF)
+size_t BgzfStream::ReadCompressedBlock(char* compressedBlock) {
+
     // read block header from file
     char header[Constants::BGZF_BLOCK_HEADER_LENGTH];
     int64_t numBytesRead = m_device->Read(header, Constants::BGZF_BLOCK_HEADER_LENGTH);
@@ -353,10 +866,8 @@ void BgzfStream::ReadBlock(void) {
     }
 
     // if block header empty
-    if ( numBytesRead == 0 ) {
-        m_blockLength = 0;
-        return;
-    }
+    if ( numBytesRead == 0 )
+        return 0;
 
     // if block header invalid size
     if ( numBytesRead != static_cast<int8_t>(Constants::BGZF_BLOCK_HEADER_LENGTH) )
@@ -368,11 +879,11 @@ void BgzfStream::ReadBlock(void) {
 
     // copy header contents to compressed buffer
     const size_t blockLength = BamTools::UnpackUnsignedShort(&header[16]) + 1;
-    memcpy(m_compressedBlock.Buffer, header, Constants::BGZF_BLOCK_HEADER_LENGTH);
+    memcpy(compressedBlock, header, Constants::BGZF_BLOCK_HEADER_LENGTH);
 
     // read remainder of block
     const size_t remaining = blockLength - Constants::BGZF_BLOCK_HEADER_LENGTH;
-    numBytesRead = m_device->Read(&m_compressedBlock.Buffer[Constants::BGZF_BLOCK_HEADER_LENGTH], remaining);
+    numBytesRead = m_device->Read(&compressedBlock[Constants::BGZF_BLOCK_HEADER_LENGTH], remaining);
 
     // check for device error
     if ( numBytesRead < 0 ) {
@@ -384,14 +895,83 @@ void BgzfStream::ReadBlock(void) {
     if ( numBytesRead != static_cast<int64_t>(remaining) )
         throw BamException("BgzfStream::ReadBlock", "could not read data from block");
 
-    // decompress block data
-    const size_t newBlockLength = InflateBlock(blockLength);
+    return blockLength;
+}
+
+// reads BGZF data, returning a pointer into the current block where possible
+// (data straddling a block boundary is copied into spillBuffer instead)
+const char* BgzfStream::ReadInPlace(const size_t dataLength, string& spillBuffer) {
+
+    // if stream not open for reading
+    BT_ASSERT_X( m_device, "BgzfStream::ReadInPlace() - trying to read from null device");
+    if ( !m_device->IsOpen() || (m_device->Mode() != IBamIODevice::ReadOnly) )
+        return 0;
+
+    // read (and decompress) next block if needed
+    int bytesAvailable = m_blockLength - m_blockOffset;
+    if ( bytesAvailable <= 0 ) {
+        ReadBlock();
+        bytesAvailable = m_blockLength - m_blockOffset;
+        if ( bytesAvailable <= 0 )
+            return 0;
+    }
+
+    // if data straddles block boundary, copy it into spill buffer (re-using its capacity)
+    if ( dataLength > (size_t)bytesAvailable ) {
+        spillBuffer.resize(dataLength);
+        if ( Read(&spillBuffer[0], dataLength) != dataLength )
+            return 0;
+        return spillBuffer.data();
+    }
+
+    // otherwise point directly into current block
+    const char* data = m_uncompressedBlock.Buffer + m_blockOffset;
+    m_blockOffset += dataLength;
+
+    // update block data
+    if ( m_blockOffset == m_blockLength ) {
+        m_blockAddress = m_nextBlockAddress;
+        m_blockOffset  = 0;
+        m_blockLength  = 0;
+    }
+
+    return data;
+}
+
+// takes the next decompressed block from read-ahead window
+void BgzfStream::ReadQueuedBlock(void) {
+
+    // top up window, so workers stay busy while this block is consumed
+    if ( m_numThreads > 1 )
+        FillReadAhead();
+
+    // if window is empty, we're at EOF
+    if ( m_readAheadCount == 0 ) {
+        m_blockLength = 0;
+        return;
+    }
+
+    // wait for block at front of window
+    BgzfInflateTask* task = m_readAhead.at(m_readAheadBegin);
+    if ( m_threadPool )
+        m_threadPool->Wait(task);
+    m_readAheadBegin = (m_readAheadBegin + 1) % m_readAhead.size();
+    --m_readAheadCount;
+
+    if ( task->Error )
+        throw BamException(*task->Error);
+
+    // swap in decompressed data (task gets our old buffer, for re-use)
+    std::swap(m_uncompressedBlock.Buffer, task->UncompressedBlock.Buffer);
+    if ( IsBlockCacheUsed() )
+        m_blockCache.Put(task->BlockAddress, m_uncompressedBlock.Buffer, task->UncompressedLength, task->BlockLength);
 
     // update block data
     if ( m_blockLength != 0 )
         m_blockOffset = 0;
-    m_blockAddress = blockAddress;
-    m_blockLength  = newBlockLength;
+    m_blockAddress     = task->BlockAddress;
+    m_blockLength      = task->UncompressedLength;
+    m_nextBlockAddress = task->BlockAddress + task->BlockLength;
 }
 
 // seek to position in BGZF file
@@ -406,13 +986,17 @@ void BgzfStream::Seek(const int64_t& position) {
     int     blockOffset  = (position & 0xFFFF);
     int64_t blockAddress = (position >> 16) & 0xFFFFFFFFFFFFLL;
 
+    // drop any blocks read ahead from old position
+    ClearReadAhead();
+
     // attempt seek in file
     if ( m_device->IsRandomAccess() && m_device->Seek(blockAddress) ) {
 
         // update block data & return success
-        m_blockLength  = 0;
-        m_blockAddress = blockAddress;
-        m_blockOffset  = blockOffset;
+        m_blockLength      = 0;
+        m_blockAddress     = blockAddress;
+        m_blockOffset      = blockOffset;
+        m_nextBlockAddress = blockAddress;
     }
     else {
         stringstream s("");
@@ -421,15 +1005,85 @@ void BgzfStream::Seek(const int64_t& position) {
     }
 }
 
+// sets memory used to cache decompressed blocks for random access (0 = disabled)
+void BgzfStream::SetBlockCacheSize(const size_t numBytes) {
+    m_blockCache.SetMaxBytes(numBytes);
+}
+
+// sets number of threads used to (de)compress blocks (1 = no read-ahead/background writing)
+// N.B. - blocks already read ahead are still delivered, in order; blocks queued for writing are written first
+void BgzfStream::SetNumThreads(int numThreads) {
+
+    numThreads = max(numThreads, 1);
+    if ( numThreads == m_numThreads )
+        return;
+
+    // background writer is restarted on next flush
+    FinishBlockWriter();
+
+    // workers are restarted on demand (window is resized once drained)
+    if ( m_threadPool ) {
+        for ( size_t i = 0; i < m_readAheadCount; ++i )
+            m_threadPool->Wait( m_readAhead.at((m_readAheadBegin + i) % m_readAhead.size()) );
+        delete m_threadPool;
+        m_threadPool = 0;
+    }
+    m_numThreads = numThreads;
+}
+
 void BgzfStream::SetWriteCompressed(bool ok) {
     m_isWriteCompressed = ok;
 }
 
+// skips over BGZF data without copying it (returns number of bytes skipped)
+size_t BgzfStream::Skip(const size_t dataLength) {
+
+    if ( dataLength == 0 )
+        return 0;
+
+    // if stream not open for reading
+    BT_ASSERT_X( m_device, "BgzfStream::Skip() - trying to read from null device");
+    if ( !m_device->IsOpen() || (m_device->Mode() != IBamIODevice::ReadOnly) )
+        return 0;
+
+    // read blocks as needed until desired data length is skipped
+    size_t numBytesSkipped = 0;
+    while ( numBytesSkipped < dataLength ) {
+
+        // determine bytes available in current block
+        int bytesAvailable = m_blockLength - m_blockOffset;
+
+        // read (and decompress) next block if needed
+        if ( bytesAvailable <= 0 ) {
+            ReadBlock();
+            bytesAvailable = m_blockLength - m_blockOffset;
+            if ( bytesAvailable <= 0 )
+                break;
+        }
+
+        // update counters
+        const size_t skipLength = min( (dataLength-numBytesSkipped), (size_t)bytesAvailable );
+        m_blockOffset   += skipLength;
+        numBytesSkipped += skipLength;
+    }
+
+    // update block data
+    if ( m_blockOffset == m_blockLength ) {
+        m_blockAddress = m_nextBlockAddress;
+        m_blockOffset  = 0;
+        m_blockLength  = 0;
+    }
+
+    // return actual number of bytes skipped
+    return numBytesSkipped;
+}
+
 // get file position in BGZF file
 int64_t BgzfStream::Tell(void) const {
     if ( !IsOpen() )
         return 0;
-    return ( (m_blockAddress << 16) | (m_blockOffset & 0xFFFF) );
+    const int64_t blockAddress = ( m_blockWriter ? m_blockWriter->BlockAddress() : m_blockAddress );
+    return ( (blockAddress << 16) | (m_blockOffset & 0xFFFF) );
 }
 
 // writes the supplied data into the BGZF buffer
@@ -2,7 +2,7 @@
 // BgzfStream_p.h (c) 2011 Derek Barnett
 // Marth Lab, Department of Biology, Boston College
 // ---------------------------------------------------------------------------
-// Last modified: 17 January 2012(DB)
+// Last modified: 18 October 2026 (DB)
 // ---------------------------------------------------------------------------
 // Based on BGZF routines developed at the Broad Institute.
 // Provides the basic functionality for reading & writing BGZF files
@@ -25,11 +25,18 @@
 #include "api_global.h"
 #include "BamAux.h"
 #include "IBamIODevice.h"
+#include "internal/io/BgzfBlockCache_p.h"
+#include "internal/io/BgzfCodec_p.h"
 #include <string>
+#include <vector>
 
 namespace BamTools {
 namespace Internal {
 
+class BamThreadPool;
+class BgzfBlockWriter;
+class BgzfInflateTask;
+
 class BgzfStream {
 
     // constructor & destructor
@@ -41,18 +48,30 @@ class BgzfStream {
     public:
         // closes BGZF file
         void Close(void);
+        // returns decompressed-block cache (for its hit/miss counts)
+        const BgzfBlockCache& BlockCache(void) const;
         // returns true if BgzfStream open for IO
         bool IsOpen(void) const;
         // opens the BGZF file
         void Open(const std::string& filename, const IBamIODevice::OpenMode mode);
         // reads BGZF data into a byte buffer
         size_t Read(char* data, const size_t dataLength);
+        // reads BGZF data, returning a pointer into the current block where possible
+        // (data straddling a block boundary is copied into spillBuffer instead)
+        // N.B. - data is only valid until the next read, returns 0 if not enough data available
+        const char* ReadInPlace(const size_t dataLength, std::string& spillBuffer);
         // seek to position in BGZF file
         void Seek(const int64_t& position);
+        // sets memory used to cache decompressed blocks for random access (0 = disabled)
+        void SetBlockCacheSize(const size_t numBytes);
         // sets IO device (closes previous, if any, but does not attempt to open)
         void SetIODevice(IBamIODevice* device);
+        // sets number of threads used to (de)compress blocks (1 = no read-ahead/background writing)
+        void SetNumThreads(int numThreads);
         // enable/disable compressed output
         void SetWriteCompressed(bool ok);
+        // skips over BGZF data without copying it (returns number of bytes skipped)
+        size_t Skip(const size_t dataLength);
         // get file position in BGZF file
         int64_t Tell(void) const;
         // writes the supplied data into the BGZF buffer
@@ -62,29 +81,69 @@ class BgzfStream {
     private:
         // compresses the current block
         size_t DeflateBlock(int32_t blockLength);
+        // discards any blocks read ahead (waits for pending decompression)
+        void ClearReadAhead(void);
+        // waits for background writer to write all queued blocks, then shuts it down
+        void FinishBlockWriter(void);
+        // reads & queues compressed blocks for decompression, until read-ahead window is full
+        void FillReadAhead(void);
         // flushes the data in the BGZF block
         void FlushBlock(void);
-        // de-compresses the current block
-        size_t InflateBlock(const size_t& blockLength);
+        // returns true if blocks read are looked up in (& added to) block cache
+        bool IsBlockCacheUsed(void) const;
         // reads a BGZF block
         void ReadBlock(void);
+        // takes block from cache if available, repositioning device past it (returns false if not cached)
+        bool ReadCachedBlock(const int64_t& blockAddress,
+                             char* uncompressedBlock,
+                             size_t* uncompressedLength,
+                             size_t* blockLength);
+        // reads the next compressed block from device (returns its length, 0 if EOF)
+        size_t ReadCompressedBlock(char* compressedBlock);
+        // takes the next decompressed block from read-ahead window
+        void ReadQueuedBlock(void);
 
     // static 'utility' methods
     public:
         // checks BGZF block header
         static bool CheckBlockHeader(char* header);
+        // compresses a single block (on return, inputLength holds number of input bytes consumed)
+        static size_t DeflateBlock(const char* uncompressedBlock,
+                                   int32_t& inputLength,
+                                   char* compressedBlock,
+                                   const int compressionLevel,
+                                   BgzfCodec& codec);
+        // de-compresses a block (returns uncompressed length)
+        static size_t InflateBlock(const char* compressedBlock,
+                                   const size_t& blockLength,
+                                   char* uncompressedBlock,
+                                   BgzfCodec& codec);
 
     // data members
     public:
         int32_t m_blockLength;
         int32_t m_blockOffset;
         int64_t m_blockAddress;
+        int64_t m_nextBlockAddress;  // N.B. - device position runs ahead of this while reading ahead
 
         bool m_isWriteCompressed;
         IBamIODevice* m_device;
 
         RaiiBuffer m_uncompressedBlock;
         RaiiBuffer m_compressedBlock;
+        BgzfCodec m_codec;  // (de)compression state, reused across blocks
+        BgzfBlockCache m_blockCache;
+
+        // multi-threaded read-ahead
+        int m_numThreads;
+        BamThreadPool* m_threadPool;
+        std::vector<BgzfInflateTask*> m_readAhead;  // ring buffer, in file order
+        size_t m_readAheadBegin;
+        size_t m_readAheadCount;
+        bool m_isReadAheadAtEnd;                    // no more blocks to queue (EOF or read error)
+
+        // multi-threaded writing
+        BgzfBlockWriter* m_blockWriter;             // created on first flush, if m_numThreads > 1
 };
 
 } // namespace Internal
@@ -0,0 +1,105 @@
+// ***************************************************************************
+// BamThreadPool_p.cpp (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides a minimal worker thread pool (for BGZF block inflate/deflate)
+// ***************************************************************************
+
+#include "internal/utils/BamThreadPool_p.h"
+using namespace BamTools;
+using namespace BamTools::Internal;
+using namespace std;
+
+// ------------------------------
+// BamThreadPool implementation
+// ------------------------------
+
+BamThreadPool::BamThreadPool(const int numThreads)
+    : m_isStopping(false)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_taskQueued, NULL);
+    pthread_cond_init(&m_taskDone, NULL);
+
+    // N.B. - if no threads could be started, Submit() runs tasks on the caller's thread
+    for ( int i = 0; i < numThreads; ++i ) {
+        pthread_t thread;
+        if ( pthread_create(&thread, NULL, BamThreadPool::RunWorker, this) != 0 )
+            break;
+        m_threads.push_back(thread);
+    }
+}
+
+BamThreadPool::~BamThreadPool(void) {
+
+    // let workers drain the queue, then exit
+    pthread_mutex_lock(&m_mutex);
+    m_isStopping = true;
+    pthread_cond_broadcast(&m_taskQueued);
+    pthread_mutex_unlock(&m_mutex);
+
+    for ( size_t i = 0; i < m_threads.size(); ++i )
+        pthread_join(m_threads[i], NULL);
+
+    pthread_cond_destroy(&m_taskDone);
+    pthread_cond_destroy(&m_taskQueued);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+int BamThreadPool::NumThreads(void) const {
+    return static_cast<int>(m_threads.size());
+}
+
+void* BamThreadPool::RunWorker(void* pool) {
+    static_cast<BamThreadPool*>(pool)->Work();
+    return NULL;
+}
+
+void BamThreadPool::Submit(BamThreadTask* task) {
+
+    // no workers available
+    if ( m_threads.empty() ) {
+        task->Run();
+        return;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    task->m_isDone = false;
+    m_tasks.push_back(task);
+    pthread_cond_signal(&m_taskQueued);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void BamThreadPool::Wait(BamThreadTask* task) {
+    pthread_mutex_lock(&m_mutex);
+    while ( !task->m_isDone )
+        pthread_cond_wait(&m_taskDone, &m_mutex);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void BamThreadPool::Work(void) {
+
+    pthread_mutex_lock(&m_mutex);
+    while ( true ) {
+
+        // wait for task (or shutdown, once queue is empty)
+        while ( m_tasks.empty() && !m_isStopping )
+            pthread_cond_wait(&m_taskQueued, &m_mutex);
+        if ( m_tasks.empty() )
+            break;
+
+        BamThreadTask* task = m_tasks.front();
+        m_tasks.pop_front();
+
+        // run task outside of lock
+        pthread_mutex_unlock(&m_mutex);
+        task->Run();
+        pthread_mutex_lock(&m_mutex);
+
+        task->m_isDone = true;
+        pthread_cond_broadcast(&m_taskDone);
+    }
+    pthread_mutex_unlock(&m_mutex);
+}
@@ -0,0 +1,83 @@
+// ***************************************************************************
+// BamThreadPool_p.h (c) 2026 Derek Barnett
+// Marth Lab, Department of Biology, Boston College
+// ---------------------------------------------------------------------------
+// Last modified: 18 October 2026 (DB)
+// ---------------------------------------------------------------------------
+// Provides a minimal worker thread pool (for BGZF block inflate/deflate)
+// ***************************************************************************
+
+#ifndef BAMTHREADPOOL_P_H
+#define BAMTHREADPOOL_P_H
+
+//  -------------
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the BamTools API.  It exists purely as an
+// implementation detail. This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+
+namespace BamTools {
+namespace Internal {
+
+// unit of work for BamThreadPool
+// N.B. - Run() is called on a worker thread & must not throw
+class BamThreadTask {
+
+    // ctor & dtor
+    public:
+        BamThreadTask(void) : m_isDone(true) { }
+        virtual ~BamThreadTask(void) { }
+
+    // BamThreadTask interface
+    public:
+        virtual void Run(void) =0;
+
+    // data members
+    private:
+        bool m_isDone; // guarded by the pool's mutex
+        friend class BamThreadPool;
+};
+
+class BamThreadPool {
+
+    // ctor & dtor
+    public:
+        BamThreadPool(const int numThreads);
+        ~BamThreadPool(void); // finishes any queued tasks first
+
+    // BamThreadPool interface
+    public:
+        // number of worker threads actually started
+        int NumThreads(void) const;
+        // queues task for a worker (task is not owned, & must outlive its Wait())
+        void Submit(BamThreadTask* task);
+        // blocks until task has run (returns immediately if never submitted)
+        void Wait(BamThreadTask* task);
+
+    // internal methods
+    private:
+        static void* RunWorker(void* pool);
+        void Work(void);
+
+    // data members
+    private:
+        std::vector<pthread_t> m_threads;
+        std::deque<BamThreadTask*> m_tasks;
+        pthread_mutex_t m_mutex;
+        pthread_cond_t m_taskQueued;
+        pthread_cond_t m_taskDone;
+        bool m_isStopping;
+};
+
+} // namespace Internal
+} // namespace BamTools
+
+#endif // BAMTHREADPOOL_P_H